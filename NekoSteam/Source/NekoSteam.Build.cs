@@ -18,6 +18,7 @@ public class NekoSteam : ModuleRules
 		
 		PrivateDependencyModuleNames.AddRange(new string[]
 		{
+			"NekoUtils",
 			"SteamShared"
 		});
 		
@@ -2,6 +2,8 @@
 
 #include "NekoSteamSubsystem.h"
 
+#include "NekoGameplayTagIndex.h"
+
 #include "Async/Async.h"
 #include "Engine/Engine.h"
 #include "Engine/GameInstance.h"
@@ -19,29 +21,18 @@ DEFINE_LOG_CATEGORY_STATIC(LogNekoSteam, Log, All);
 namespace InternalNekoSteamLibrary
 {
 	/**
-	 * Parses the tag name and returns the name of the leaf.
-	 * For example, calling this on x.y.z would return the z component.
-	 *
-	 * @note This is a native function in UE 5.6, FGameplayTag::GetTagLeafName()
+	 * Calls the provided function with the ANSI version of the provided achievement or stat ID. IDs coming from gameplay
+	 * tags were converted once when the tags were registered, only the other ones are converted here.
 	 */
-	FName GetTagLeafName(const FGameplayTag GameplayTag)
+	template <typename FunctionType>
+	bool WithAnsiID(const FName ID, FunctionType&& Function)
 	{
-		FName RawTag = GameplayTag.GetTagName();
-		if (RawTag.IsNone())
-		{
-			return RawTag;
-		}
-
-		const TStringBuilder<FName::StringBufferSize> TagBuffer(InPlace, RawTag);
-		FStringView TagView = TagBuffer.ToView();
-		const int32 DotIndex = UE::String::FindLastChar(TagView, TEXT('.'));
-		if (DotIndex == INDEX_NONE)
+		if (const ANSICHAR* AnsiID = FNekoGameplayTagIndex::Get().FindLeafAnsiName(ID))
 		{
-			return RawTag;
+			return Function(AnsiID);
 		}
 
-		TagView.RightChopInline(DotIndex + 1);
-		return FName(TagView);
+		return Function(TCHAR_TO_ANSI(*ID.ToString()));
 	}
 }
 
@@ -124,8 +115,12 @@ void UNekoSteamSubsystem::Tick(const float DeltaTime)
 
 	for (auto It = AchievementsToSet.CreateIterator(); It; ++It)
 	{
-		const FString AchievementID = It->ToString();
-		if (SteamUserStats()->SetAchievement(TCHAR_TO_ANSI(*AchievementID)))
+		const bool bAchievementSet = InternalNekoSteamLibrary::WithAnsiID(*It, [](const ANSICHAR* AchievementID)
+		{
+			return SteamUserStats()->SetAchievement(AchievementID);
+		});
+
+		if (bAchievementSet)
 		{
 			It.RemoveCurrent();
 		}
@@ -133,8 +128,13 @@ void UNekoSteamSubsystem::Tick(const float DeltaTime)
 
 	for (auto It = StatsToSet.CreateIterator(); It; ++It)
 	{
-		const FString StatName = It.Key().ToString();
-		if (SteamUserStats()->SetStat(TCHAR_TO_ANSI(*StatName), It.Value()))
+		const int32 Value = It.Value();
+		const bool bStatSet = InternalNekoSteamLibrary::WithAnsiID(It.Key(), [Value](const ANSICHAR* StatName)
+		{
+			return SteamUserStats()->SetStat(StatName, Value);
+		});
+
+		if (bStatSet)
 		{
 			It.RemoveCurrent();
 		}
@@ -142,14 +142,16 @@ void UNekoSteamSubsystem::Tick(const float DeltaTime)
 
 	for (auto It = StatsToIncrement.CreateIterator(); It; ++It)
 	{
-		const FString StatName = It.Key().ToString();
-		int32 CurrentValue;
-		if (SteamUserStats()->GetStat(TCHAR_TO_ANSI(*StatName), &CurrentValue))
+		const int32 Increment = It.Value();
+		const bool bStatSet = InternalNekoSteamLibrary::WithAnsiID(It.Key(), [Increment](const ANSICHAR* StatName)
 		{
-			if (SteamUserStats()->SetStat(TCHAR_TO_ANSI(*StatName), CurrentValue + It.Value()))
-			{
-				It.RemoveCurrent();
-			}	
+			int32 CurrentValue;
+			return SteamUserStats()->GetStat(StatName, &CurrentValue) && SteamUserStats()->SetStat(StatName, CurrentValue + Increment);
+		});
+
+		if (bStatSet)
+		{
+			It.RemoveCurrent();
 		}
 	}
 
@@ -239,7 +241,7 @@ bool UNekoSteamSubsystem::ActivateGameOverlayToStore(const int32 AppID)
 
 void UNekoSteamSubsystem::UnlockAchievementByTag(const FGameplayTag AchievementTag)
 {
-	UnlockAchievement(InternalNekoSteamLibrary::GetTagLeafName(AchievementTag));
+	UnlockAchievement(FNekoGameplayTagIndex::Get().FindLeafName(AchievementTag));
 }
 
 void UNekoSteamSubsystem::UnlockAchievement(const FName AchievementID)
@@ -250,7 +252,7 @@ void UNekoSteamSubsystem::UnlockAchievement(const FName AchievementID)
 
 void UNekoSteamSubsystem::ProgressStatByTag(const FGameplayTag StatTag, const int32 Amount, const bool bIncrement)
 {
-	ProgressStat(InternalNekoSteamLibrary::GetTagLeafName(StatTag), Amount, bIncrement);
+	ProgressStat(FNekoGameplayTagIndex::Get().FindLeafName(StatTag), Amount, bIncrement);
 }
 
 void UNekoSteamSubsystem::ProgressStat(const FName StatID, const int32 Amount, const bool bIncrement)
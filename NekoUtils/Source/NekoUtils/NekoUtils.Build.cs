@@ -21,8 +21,11 @@ public class NekoUtils : ModuleRules
 		{
 			"CommonInput",
 			"EngineSettings",
+			"Json",
+			"JsonUtilities",
 			"UMG",
 			"Slate",
+			"SlateCore",
 		});
 	}
 }
\ No newline at end of file
@@ -0,0 +1,148 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#include "NekoBakedCurve.h"
+
+#include "NekoLogCategories.h"
+
+#include "Curves/CurveFloat.h"
+#include "Curves/CurveLinearColor.h"
+#include "Curves/CurveVector.h"
+#include "UObject/UObjectGlobals.h"
+
+
+namespace InternalNekoBakedCurve
+{
+	// Number of points checked between two samples when measuring the error of a baked curve
+	constexpr int32 ErrorSubdivisions = 4;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// FNekoBakedCurve
+
+void FNekoBakedCurve::Bake(const UCurveBase& Curve)
+{
+	float Values[MaxChannels];
+	for (int32 Index = 0; Index <= Resolution; ++Index)
+	{
+		NumChannels = EvaluateCurve(Curve, static_cast<float>(Index) / Resolution, Values);
+		FMemory::Memcpy(&Samples[Index * MaxChannels], Values, sizeof(Values));
+	}
+
+	MaxError = 0.0f;
+	float BakedValues[MaxChannels];
+	for (int32 Index = 0; Index < Resolution; ++Index)
+	{
+		for (int32 Step = 1; Step < InternalNekoBakedCurve::ErrorSubdivisions; ++Step)
+		{
+			const float Time = (Index + static_cast<float>(Step) / InternalNekoBakedCurve::ErrorSubdivisions) / Resolution;
+			EvaluateCurve(Curve, Time, Values);
+			SampleChannels(Time, BakedValues);
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				MaxError = FMath::Max(MaxError, FMath::Abs(Values[Channel] - BakedValues[Channel]));
+			}
+		}
+	}
+
+	UE_LOG(LogNekoUtils, Verbose, TEXT("Baked curve [%s] with a maximum error of %f"), *Curve.GetPathName(), MaxError);
+}
+
+int32 FNekoBakedCurve::EvaluateCurve(const UCurveBase& Curve, const float Time, float (&OutValues)[MaxChannels])
+{
+	// Goes through the curve's own getters, so that e.g. the color adjustments of linear color curves are included
+	if (const UCurveLinearColor* ColorCurve = Cast<UCurveLinearColor>(&Curve))
+	{
+		const FLinearColor Color = ColorCurve->GetLinearColorValue(Time);
+		OutValues[0] = Color.R;
+		OutValues[1] = Color.G;
+		OutValues[2] = Color.B;
+		OutValues[3] = Color.A;
+		return 4;
+	}
+
+	if (const UCurveVector* VectorCurve = Cast<UCurveVector>(&Curve))
+	{
+		const FVector Vector = VectorCurve->GetVectorValue(Time);
+		OutValues[0] = Vector.X;
+		OutValues[1] = Vector.Y;
+		OutValues[2] = Vector.Z;
+		OutValues[3] = 0.0f;
+		return 3;
+	}
+
+	const UCurveFloat* FloatCurve = Cast<UCurveFloat>(&Curve);
+	OutValues[0] = FloatCurve ? FloatCurve->GetFloatValue(Time) : 0.0f;
+	OutValues[1] = 0.0f;
+	OutValues[2] = 0.0f;
+	OutValues[3] = 0.0f;
+	return 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// FNekoBakedCurveCache
+
+FNekoBakedCurveCache& FNekoBakedCurveCache::Get()
+{
+	static FNekoBakedCurveCache Instance;
+	return Instance;
+}
+
+FNekoBakedCurveCache::FNekoBakedCurveCache()
+{
+	FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FNekoBakedCurveCache::HandlePostGarbageCollect);
+}
+
+FNekoBakedCurveCache::~FNekoBakedCurveCache()
+{
+	FCoreUObjectDelegates::GetPostGarbageCollect().RemoveAll(this);
+}
+
+const FNekoBakedCurve* FNekoBakedCurveCache::FindOrBake(const UCurveBase* Curve)
+{
+	check(IsInGameThread());
+
+	if (Curve == nullptr)
+	{
+		return nullptr;
+	}
+
+	TUniquePtr<FNekoBakedCurve>& BakedCurve = BakedCurves.FindOrAdd(FObjectKey(Curve));
+	if (!BakedCurve.IsValid())
+	{
+		BakedCurve = MakeUnique<FNekoBakedCurve>();
+		BakedCurve->Bake(*Curve);
+
+#if WITH_EDITOR
+		const_cast<UCurveBase*>(Curve)->OnUpdateCurve.AddRaw(this, &FNekoBakedCurveCache::HandleCurveUpdated);
+#endif
+	}
+
+	return BakedCurve.Get();
+}
+
+#if WITH_EDITOR
+void FNekoBakedCurveCache::HandleCurveUpdated(UCurveBase* Curve, EPropertyChangeType::Type ChangeType)
+{
+	if (Curve == nullptr)
+	{
+		return;
+	}
+
+	// Baked again in place, so that the pseudo-timelines currently using it pick up the change
+	if (const TUniquePtr<FNekoBakedCurve>* BakedCurve = BakedCurves.Find(FObjectKey(Curve)))
+	{
+		(*BakedCurve)->Bake(*Curve);
+	}
+}
+#endif
+
+void FNekoBakedCurveCache::HandlePostGarbageCollect()
+{
+	for (auto It = BakedCurves.CreateIterator(); It; ++It)
+	{
+		if (It.Key().ResolveObjectPtr() == nullptr)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
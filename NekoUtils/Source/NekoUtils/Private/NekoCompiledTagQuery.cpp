@@ -0,0 +1,174 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#include "NekoCompiledTagQuery.h"
+
+#include "NekoGameplayTagIndex.h"
+#include "NekoLogCategories.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(NekoCompiledTagQuery)
+
+
+FNekoCompiledTagQuery::FNekoCompiledTagQuery(const FGameplayTagQuery& InQuery)
+	: Query(InQuery)
+{
+	if (Query.IsEmpty())
+	{
+		return;
+	}
+
+	FGameplayTagQueryExpression RootExpression;
+	Query.GetQueryExpr(RootExpression);
+
+	Version = FNekoGameplayTagIndex::Get().GetVersion();
+	bCompiled = Compile(RootExpression);
+	if (!bCompiled)
+	{
+		UE_LOG(LogNekoUtils, Warning, TEXT("Could not compile gameplay tag query [%s], it will be matched without being compiled"), *Query.GetDescription());
+		Operations.Empty();
+		Masks.Empty();
+	}
+}
+
+bool FNekoCompiledTagQuery::Compile(const FGameplayTagQueryExpression& Expression)
+{
+	const int32 OperationIndex = Operations.AddDefaulted();
+	Operations[OperationIndex].Type = Expression.ExprType;
+
+	switch (Expression.ExprType)
+	{
+		case EGameplayTagQueryExprType::AnyTagsMatch:
+		case EGameplayTagQueryExprType::AllTagsMatch:
+		case EGameplayTagQueryExprType::NoTagsMatch:
+		case EGameplayTagQueryExprType::AnyTagsExactMatch:
+		case EGameplayTagQueryExprType::AllTagsExactMatch:
+		{
+			FNekoTagBitset& Mask = Masks.AddDefaulted_GetRef();
+			for (const FGameplayTag& Tag : Expression.TagSet)
+			{
+				Mask.AddTag(Tag);
+			}
+			Operations[OperationIndex].MaskIndex = Masks.Num() - 1;
+			break;
+		}
+
+		case EGameplayTagQueryExprType::AnyExprMatch:
+		case EGameplayTagQueryExprType::AllExprMatch:
+		case EGameplayTagQueryExprType::NoExprMatch:
+			for (const FGameplayTagQueryExpression& SubExpression : Expression.ExprSet)
+			{
+				if (!Compile(SubExpression))
+				{
+					return false;
+				}
+			}
+			break;
+
+		default:
+			return false;
+	}
+
+	// Not kept as a reference, since compiling the sub-expressions may have moved the array
+	Operations[OperationIndex].End = Operations.Num();
+	return true;
+}
+
+bool FNekoCompiledTagQuery::Matches(const FNekoTagBitset& Tags) const
+{
+	// A stale bitset can't be compared with the masks, e.g. NoTagsMatch would always succeed
+	if (UsesFallback() || !Tags.IsUpToDate())
+	{
+		return Query.Matches(Tags.ToContainer());
+	}
+
+	return Evaluate(0, Tags);
+}
+
+bool FNekoCompiledTagQuery::Matches(const FGameplayTagContainer& Tags) const
+{
+	if (UsesFallback())
+	{
+		return Query.Matches(Tags);
+	}
+
+	return Evaluate(0, FNekoTagBitset(Tags));
+}
+
+void FNekoCompiledTagQuery::FilterMatches(TConstArrayView<FNekoTagBitset> Bitsets, TArray<int32>& OutIndices) const
+{
+	OutIndices.Reset();
+
+	// Only checked once for the whole batch, the bitsets are then checked one by one
+	const bool bUsesFallback = UsesFallback();
+	for (int32 Index = 0; Index < Bitsets.Num(); ++Index)
+	{
+		const FNekoTagBitset& Tags = Bitsets[Index];
+		const bool bMatches = bUsesFallback || !Tags.IsUpToDate() ? Query.Matches(Tags.ToContainer()) : Evaluate(0, Tags);
+		if (bMatches)
+		{
+			OutIndices.Add(Index);
+		}
+	}
+}
+
+bool FNekoCompiledTagQuery::UsesFallback() const
+{
+	// Every mask was built with the same version of the index
+	return !bCompiled || Version != FNekoGameplayTagIndex::Get().GetVersion();
+}
+
+bool FNekoCompiledTagQuery::Evaluate(const int32 OperationIndex, const FNekoTagBitset& Tags) const
+{
+	const FOperation& Operation = Operations[OperationIndex];
+
+	// Same results as FQueryEvaluator in GameplayTagContainer.cpp, including for empty sets
+	switch (Operation.Type)
+	{
+		case EGameplayTagQueryExprType::AnyTagsMatch:
+			return Tags.HasAny(Masks[Operation.MaskIndex]);
+
+		case EGameplayTagQueryExprType::AllTagsMatch:
+			return Tags.HasAll(Masks[Operation.MaskIndex]);
+
+		case EGameplayTagQueryExprType::NoTagsMatch:
+			return !Tags.HasAny(Masks[Operation.MaskIndex]);
+
+		case EGameplayTagQueryExprType::AnyTagsExactMatch:
+			return Tags.HasAnyExact(Masks[Operation.MaskIndex]);
+
+		case EGameplayTagQueryExprType::AllTagsExactMatch:
+			return Tags.HasAllExact(Masks[Operation.MaskIndex]);
+
+		case EGameplayTagQueryExprType::AnyExprMatch:
+			for (int32 ChildIndex = OperationIndex + 1; ChildIndex < Operation.End; ChildIndex = Operations[ChildIndex].End)
+			{
+				if (Evaluate(ChildIndex, Tags))
+				{
+					return true;
+				}
+			}
+			return false;
+
+		case EGameplayTagQueryExprType::AllExprMatch:
+			for (int32 ChildIndex = OperationIndex + 1; ChildIndex < Operation.End; ChildIndex = Operations[ChildIndex].End)
+			{
+				if (!Evaluate(ChildIndex, Tags))
+				{
+					return false;
+				}
+			}
+			return true;
+
+		case EGameplayTagQueryExprType::NoExprMatch:
+			for (int32 ChildIndex = OperationIndex + 1; ChildIndex < Operation.End; ChildIndex = Operations[ChildIndex].End)
+			{
+				if (Evaluate(ChildIndex, Tags))
+				{
+					return false;
+				}
+			}
+			return true;
+
+		default:
+			return false;
+	}
+}
@@ -0,0 +1,63 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#include "NekoDecay.h"
+
+#include "Math/VectorRegister.h"
+
+
+// The vector overload relies on an array of vectors being a flat array of doubles
+static_assert(sizeof(FVector) == 3 * sizeof(double), "FVector is expected to be three tightly packed doubles");
+
+void NekoDecay::Apply(const double* Values, const double* Targets, double* OutValues, const int32 Num, const double Factor)
+{
+	const VectorRegister4Double FactorRegister = VectorSetFloat1(Factor);
+
+	int32 Index = 0;
+	for (; Index + 4 <= Num; Index += 4)
+	{
+		const VectorRegister4Double Value = VectorLoad(&Values[Index]);
+		const VectorRegister4Double Target = VectorLoad(&Targets[Index]);
+		VectorStore(VectorMultiplyAdd(VectorSubtract(Value, Target), FactorRegister, Target), &OutValues[Index]);
+	}
+
+	// Remainder that doesn't fill a whole register
+	for (; Index < Num; ++Index)
+	{
+		OutValues[Index] = Targets[Index] + (Values[Index] - Targets[Index]) * Factor;
+	}
+}
+
+void NekoDecay::Apply(const double* Values, const double* Targets, const double* Factors, double* OutValues, const int32 Num)
+{
+	int32 Index = 0;
+	for (; Index + 4 <= Num; Index += 4)
+	{
+		const VectorRegister4Double Value = VectorLoad(&Values[Index]);
+		const VectorRegister4Double Target = VectorLoad(&Targets[Index]);
+		const VectorRegister4Double Factor = VectorLoad(&Factors[Index]);
+		VectorStore(VectorMultiplyAdd(VectorSubtract(Value, Target), Factor, Target), &OutValues[Index]);
+	}
+
+	// Remainder that doesn't fill a whole register
+	for (; Index < Num; ++Index)
+	{
+		OutValues[Index] = Targets[Index] + (Values[Index] - Targets[Index]) * Factors[Index];
+	}
+}
+
+void NekoDecay::ExponentialDecay(TArrayView<double> Values, TConstArrayView<double> Targets, const float Decay, const float DeltaTime)
+{
+	check(Values.Num() == Targets.Num());
+	Apply(Values.GetData(), Targets.GetData(), Values.GetData(), Values.Num(), GetFactor(Decay, DeltaTime));
+}
+
+void NekoDecay::ExponentialDecay(TArrayView<FVector> Values, TConstArrayView<FVector> Targets, const float Decay, const float DeltaTime)
+{
+	check(Values.Num() == Targets.Num());
+	if (Values.IsEmpty())
+	{
+		return;
+	}
+
+	Apply(&Values.GetData()->X, &Targets.GetData()->X, &Values.GetData()->X, Values.Num() * 3, GetFactor(Decay, DeltaTime));
+}
@@ -2,21 +2,24 @@
 
 #include "NekoFunctionLibrary.h"
 
+#include "NekoDecay.h"
+#include "NekoGameplayTagIndex.h"
 #include "NekoLogCategories.h"
-#include "PseudoTimelineLatentAction.h"
+#include "NekoPlayerVisibilitySubsystem.h"
+#include "NekoTimelineSubsystem.h"
+#include "UI/NekoFocusedWidgetTracker.h"
+#include "UI/NekoInputStateSubsystem.h"
+#include "UI/NekoInputTypeVisibilityExtension.h"
 #include "UI/NekoRootUILayout.h"
 #include "UI/NekoUIManager.h"
 
 #include "Blueprint/UserWidget.h"
-#include "CommonInputSubsystem.h"
 #include "Components/Widget.h"
 #include "Engine/AssetManager.h"
 #include "Engine/Engine.h"
 #include "GameplayTagContainer.h"
-#include "GameplayTagsManager.h"
 #include "GeneralProjectSettings.h"
 #include "Input/CommonUIActionRouterBase.h"
-#include "UObject/UObjectIterator.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(NekoFunctionLibrary)
 
@@ -26,32 +29,89 @@ namespace InternalNekoLibrary
 	template <typename T>
 	T ExponentialDecay(const T A, const T B, const float Decay, const float DeltaTime)
 	{
-		// See https://www.youtube.com/watch?v=LSNQuFEDOyQ
-		return B + (A - B) * FMath::Exp(-Decay * DeltaTime);
+		return B + (A - B) * NekoDecay::GetFactor(Decay, DeltaTime);
 	}
 
-	// Taken from UGameplayTagsManager::AddChildrenTags(), which is a private function
-	void AddChildrenTags(FGameplayTagContainer& TagContainer, TSharedPtr<FGameplayTagNode> GameplayTagNode, const bool bRecursive)
+	// Rotations can't be subtracted, so they are slerped from the target by the same factor instead
+	template <>
+	FQuat ExponentialDecay(const FQuat A, const FQuat B, const float Decay, const float DeltaTime)
 	{
-		if (!GameplayTagNode.IsValid())
+		return FQuat::Slerp(B, A, NekoDecay::GetFactor(Decay, DeltaTime));
+	}
+
+	template <>
+	FRotator ExponentialDecay(const FRotator A, const FRotator B, const float Decay, const float DeltaTime)
+	{
+		return ExponentialDecay(A.Quaternion(), B.Quaternion(), Decay, DeltaTime).Rotator();
+	}
+
+	template <>
+	FTransform ExponentialDecay(const FTransform A, const FTransform B, const float Decay, const float DeltaTime)
+	{
+		const double Factor = NekoDecay::GetFactor(Decay, DeltaTime);
+		return FTransform(
+			FQuat::Slerp(B.GetRotation(), A.GetRotation(), Factor),
+			B.GetTranslation() + (A.GetTranslation() - B.GetTranslation()) * Factor,
+			B.GetScale3D() + (A.GetScale3D() - B.GetScale3D()) * Factor);
+	}
+
+	// Decays the first Num values, warning if the arrays have different sizes
+	template <typename T>
+	void ExponentialDecayArray(TArrayView<T> Values, const TArray<T>& Targets, const float Decay, const float DeltaTime)
+	{
+		if (Values.Num() != Targets.Num())
 		{
+			UE_LOG(LogNekoUtils, Warning, TEXT("Tried to decay %d values towards %d targets, only the first %d will be decayed"), Values.Num(), Targets.Num(), FMath::Min(Values.Num(), Targets.Num()));
+		}
+
+		const int32 Num = FMath::Min(Values.Num(), Targets.Num());
+		NekoDecay::ExponentialDecay(Values.Left(Num), TConstArrayView<T>(Targets).Left(Num), Decay, DeltaTime);
+	}
+
+	// Updates the springs in place, only if every array has the same size
+	template <typename T>
+	void UpdateSpringArray(TArray<T>& Values, TArray<T>& Velocities, const TArray<T>& Targets, const float Frequency, const float DampingRatio, const float DeltaTime)
+	{
+		if (Values.Num() != Velocities.Num() || Values.Num() != Targets.Num())
+		{
+			UE_LOG(LogNekoUtils, Warning, TEXT("Tried to update springs with %d values, %d velocities and %d targets, they must all have the same size"), Values.Num(), Velocities.Num(), Targets.Num());
 			return;
 		}
 
-		TArray<TSharedPtr<FGameplayTagNode>>& ChildrenNodes = GameplayTagNode->GetChildTagNodes();
-		for (TSharedPtr<FGameplayTagNode> ChildNode : ChildrenNodes)
+		NekoSpring::UpdateBatch(TArrayView<T>(Values), TArrayView<T>(Velocities), TConstArrayView<T>(Targets), NekoSpring::FCoefficients::Compute(Frequency, DampingRatio, DeltaTime));
+	}
+
+	UNekoTimelineSubsystem* GetTimelineSubsystem(const UObject* WorldContext)
+	{
+		const UWorld* World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull);
+		if (World == nullptr)
+		{
+			UE_LOG(LogNekoUtils, Error, TEXT("Tried to execute a PseudoTimeline, but could not find World!"));
+			return nullptr;
+		}
+
+		UNekoTimelineSubsystem* TimelineSubsystem = World->GetSubsystem<UNekoTimelineSubsystem>();
+		if (TimelineSubsystem == nullptr)
 		{
-			if (!ChildNode.IsValid())
-			{
-				continue;
-			}
+			UE_LOG(LogNekoUtils, Error, TEXT("Tried to execute a PseudoTimeline, but World [%s] has no pseudo-timeline subsystem!"), *World->GetName());
+		}
+		return TimelineSubsystem;
+	}
 
-			TagContainer.AddTag(ChildNode->GetCompleteTag());
+	// Starts a typed pseudo-timeline, shared by the typed variants of PseudoTimeline
+	void StartTypedTimeline(const UObject* WorldContext, const FLatentActionInfo& LatentInfo, const float Time,
+		const UCurveFloat* Curve, const FNekoPseudoTimelineOptions& Options, const FNekoTimelineTypedOutput& Output,
+		EPseudoTimelineOutputPins& OutputPins, float& Progress)
+	{
+		UNekoTimelineSubsystem* TimelineSubsystem = GetTimelineSubsystem(WorldContext);
+		if (TimelineSubsystem == nullptr)
+		{
+			return;
+		}
 
-			if (bRecursive)
-			{
-				AddChildrenTags(TagContainer, ChildNode, true);
-			}
+		if (!TimelineSubsystem->StartTypedTimeline(LatentInfo, Time, Curve, Options, Output, OutputPins, Progress, false))
+		{
+			UE_LOG(LogNekoUtils, Warning, TEXT("Tried to re-execute a non-retriggerable PseudoTimeline that was already started"));
 		}
 	}
 }
@@ -135,20 +195,58 @@ FString UNekoFunctionLibrary::GetProjectVersion(const bool bWithBuildNumber)
 
 FGameplayTagContainer UNekoFunctionLibrary::GetGameplayTagChildren(const FGameplayTag GameplayTag, bool bRecursive)
 {
-	const UGameplayTagsManager& TagsManager = UGameplayTagsManager::Get();
+	const FNekoGameplayTagIndex& TagIndex = FNekoGameplayTagIndex::Get();
 
 	FGameplayTagContainer TagContainer;
 	// Note this purposefully does not include the passed in GameplayTag in the container.
-	TSharedPtr<FGameplayTagNode> GameplayTagNode = TagsManager.FindTagNode(GameplayTag);
-	if (GameplayTagNode.IsValid())
+	const int32 Index = TagIndex.FindIndex(GameplayTag);
+	if (Index == INDEX_NONE)
+	{
+		return TagContainer;
+	}
+
+	// Every tag of the index is unique, so there's no need to check for duplicates
+	if (bRecursive)
 	{
-		InternalNekoLibrary::AddChildrenTags(TagContainer, GameplayTagNode, bRecursive);
+		for (const FGameplayTag& Descendant : TagIndex.GetDescendants(Index))
+		{
+			TagContainer.AddTagFast(Descendant);
+		}
+	}
+	else
+	{
+		TagIndex.ForEachChild(Index, [&TagIndex, &TagContainer](const int32 ChildIndex)
+		{
+			TagContainer.AddTagFast(TagIndex.GetTag(ChildIndex));
+		});
 	}
 
 	return TagContainer;
 }
 
-FGameplayTag UNekoFunctionLibrary::GetRandomGameplayTagFromContainer(const FGameplayTagContainer GameplayTagContainer)
+int32 UNekoFunctionLibrary::GetNumGameplayTagChildren(const FGameplayTag GameplayTag, bool bRecursive)
+{
+	const FNekoGameplayTagIndex& TagIndex = FNekoGameplayTagIndex::Get();
+
+	const int32 Index = TagIndex.FindIndex(GameplayTag);
+	if (Index == INDEX_NONE)
+	{
+		return 0;
+	}
+
+	return bRecursive ? TagIndex.GetNumDescendants(Index) : TagIndex.GetNumChildren(Index);
+}
+
+bool UNekoFunctionLibrary::IsGameplayTagDescendantOf(const FGameplayTag GameplayTag, const FGameplayTag Ancestor)
+{
+	const FNekoGameplayTagIndex& TagIndex = FNekoGameplayTagIndex::Get();
+
+	const int32 Index = TagIndex.FindIndex(GameplayTag);
+	const int32 AncestorIndex = TagIndex.FindIndex(Ancestor);
+	return Index != INDEX_NONE && AncestorIndex != INDEX_NONE && TagIndex.IsDescendant(Index, AncestorIndex);
+}
+
+FGameplayTag UNekoFunctionLibrary::GetRandomGameplayTagFromContainer(const FGameplayTagContainer& GameplayTagContainer)
 {
 	if (GameplayTagContainer.IsEmpty())
 	{
@@ -158,70 +256,252 @@ FGameplayTag UNekoFunctionLibrary::GetRandomGameplayTagFromContainer(const FGame
 	return GameplayTagContainer.GetByIndex(FMath::RandRange(0, GameplayTagContainer.Num() - 1));
 }
 
-FName UNekoFunctionLibrary::GetTagLeafName(const FGameplayTag GameplayTag)
+FGameplayTag UNekoFunctionLibrary::GetRandomGameplayTagFromContainerFromStream(const FGameplayTagContainer& GameplayTagContainer, FRandomStream& Stream)
 {
-	// This function is taken straight from UE 5.6's FGameplayTag::GetTagLeafName()
-	FName RawTag = GameplayTag.GetTagName();
-	if (RawTag.IsNone())
+	if (GameplayTagContainer.IsEmpty())
 	{
-		return RawTag;
+		return FGameplayTag::EmptyTag;
 	}
 
-	const TStringBuilder<FName::StringBufferSize> TagBuffer(InPlace, RawTag);
-	FStringView TagView = TagBuffer.ToView();
-	const int32 DotIndex = UE::String::FindLastChar(TagView, TEXT('.'));
-	if (DotIndex == INDEX_NONE)
-	{
-		return RawTag;
-	}
+	return GameplayTagContainer.GetByIndex(Stream.RandHelper(GameplayTagContainer.Num()));
+}
+
+FName UNekoFunctionLibrary::GetTagLeafName(const FGameplayTag GameplayTag)
+{
+	// Interned when the tags are registered, see FNekoGameplayTagIndex
+	return FNekoGameplayTagIndex::Get().FindLeafName(GameplayTag);
+}
+
+FNekoTagBitset UNekoFunctionLibrary::MakeTagBitset(const FGameplayTagContainer& GameplayTagContainer)
+{
+	return FNekoTagBitset(GameplayTagContainer);
+}
+
+FGameplayTagContainer UNekoFunctionLibrary::BreakTagBitset(const FNekoTagBitset& TagBitset)
+{
+	return TagBitset.ToContainer();
+}
+
+bool UNekoFunctionLibrary::TagBitsetHasTag(const FNekoTagBitset& TagBitset, const FGameplayTag GameplayTag, const bool bExactMatch)
+{
+	return bExactMatch ? TagBitset.HasTagExact(GameplayTag) : TagBitset.HasTag(GameplayTag);
+}
+
+bool UNekoFunctionLibrary::TagBitsetHasAny(const FNekoTagBitset& TagBitset, const FNekoTagBitset& Other, const bool bExactMatch)
+{
+	return bExactMatch ? TagBitset.HasAnyExact(Other) : TagBitset.HasAny(Other);
+}
+
+bool UNekoFunctionLibrary::TagBitsetHasAll(const FNekoTagBitset& TagBitset, const FNekoTagBitset& Other, const bool bExactMatch)
+{
+	return bExactMatch ? TagBitset.HasAllExact(Other) : TagBitset.HasAll(Other);
+}
+
+FNekoCompiledTagQuery UNekoFunctionLibrary::CompileGameplayTagQuery(const FGameplayTagQuery& Query)
+{
+	return FNekoCompiledTagQuery(Query);
+}
 
-	TagView.RightChopInline(DotIndex + 1);
-	return FName(TagView);
+bool UNekoFunctionLibrary::MatchesCompiledTagQuery(const FNekoCompiledTagQuery& CompiledQuery, const FNekoTagBitset& TagBitset)
+{
+	return CompiledQuery.Matches(TagBitset);
+}
+
+bool UNekoFunctionLibrary::MatchesCompiledTagQuery_Container(const FNekoCompiledTagQuery& CompiledQuery, const FGameplayTagContainer& GameplayTagContainer)
+{
+	return CompiledQuery.Matches(GameplayTagContainer);
+}
+
+TArray<int32> UNekoFunctionLibrary::FilterByCompiledTagQuery(const FNekoCompiledTagQuery& CompiledQuery, const TArray<FNekoTagBitset>& TagBitsets)
+{
+	TArray<int32> MatchingIndices;
+	CompiledQuery.FilterMatches(TagBitsets, MatchingIndices);
+	return MatchingIndices;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 /// Timings and math
 
 void UNekoFunctionLibrary::PseudoTimeline(const UObject* WorldContext, const FLatentActionInfo LatentInfo,
-	const float Time, const UCurveFloat* Curve, EPseudoTimelineOutputPins& OutputPins, float& Progress, float& Alpha)
+	const float Time, const UCurveFloat* Curve, const FNekoPseudoTimelineOptions& Options, EPseudoTimelineOutputPins& OutputPins,
+	float& Progress, float& Alpha)
 {
-	UWorld* World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull);
-	if (World == nullptr)
+	UNekoTimelineSubsystem* TimelineSubsystem = InternalNekoLibrary::GetTimelineSubsystem(WorldContext);
+	if (TimelineSubsystem == nullptr)
 	{
-		UE_LOG(LogNekoUtils, Error, TEXT("Tried to execute a PseudoTimeline, but could not find World!"));
 		return;
 	}
 
-	FLatentActionManager& LatentActionManager = World->GetLatentActionManager();
-	if (LatentActionManager.FindExistingAction<FPseudoTimelineLatentAction>(LatentInfo.CallbackTarget, LatentInfo.UUID))
+	if (!TimelineSubsystem->StartTimeline(LatentInfo, Time, Curve, Options, OutputPins, Progress, Alpha, false))
 	{
 		UE_LOG(LogNekoUtils, Warning, TEXT("Tried to re-execute a non-retriggerable PseudoTimeline that was already started"));
+	}
+}
+
+void UNekoFunctionLibrary::RetriggerablePseudoTimeline(const UObject* WorldContext, const FLatentActionInfo LatentInfo,
+	const float Time, const UCurveFloat* Curve, const FNekoPseudoTimelineOptions& Options, EPseudoTimelineOutputPins& OutputPins,
+	float& Progress, float& Alpha)
+{
+	UNekoTimelineSubsystem* TimelineSubsystem = InternalNekoLibrary::GetTimelineSubsystem(WorldContext);
+	if (TimelineSubsystem == nullptr)
+	{
 		return;
 	}
 
-	FPseudoTimelineLatentAction* Action = new FPseudoTimelineLatentAction(LatentInfo, Time, Curve, OutputPins, Progress, Alpha);
-	LatentActionManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID, Action);
+	TimelineSubsystem->StartTimeline(LatentInfo, Time, Curve, Options, OutputPins, Progress, Alpha, true);
 }
 
-void UNekoFunctionLibrary::RetriggerablePseudoTimeline(const UObject* WorldContext, const FLatentActionInfo LatentInfo,
-	const float Time, const UCurveFloat* Curve, EPseudoTimelineOutputPins& OutputPins, float& Progress, float& Alpha)
+void UNekoFunctionLibrary::PseudoTimeline_Vector(const UObject* WorldContext, const FLatentActionInfo LatentInfo,
+	const float Time, const FVector A, const FVector B, const UCurveFloat* Curve, const FNekoPseudoTimelineOptions& Options,
+	EPseudoTimelineOutputPins& OutputPins, float& Progress, FVector& Value)
+{
+	InternalNekoLibrary::StartTypedTimeline(WorldContext, LatentInfo, Time, Curve, Options,
+		FNekoTimelineTypedOutput::MakeVector(Value, A, B), OutputPins, Progress);
+}
+
+void UNekoFunctionLibrary::PseudoTimeline_VectorCurve(const UObject* WorldContext, const FLatentActionInfo LatentInfo,
+	const float Time, const UCurveVector* Curve, const FNekoPseudoTimelineOptions& Options,
+	EPseudoTimelineOutputPins& OutputPins, float& Progress, FVector& Value)
+{
+	if (Curve == nullptr)
+	{
+		UE_LOG(LogNekoUtils, Error, TEXT("Tried to execute a PseudoTimeline (Vector Curve) without any curve!"));
+		return;
+	}
+
+	InternalNekoLibrary::StartTypedTimeline(WorldContext, LatentInfo, Time, nullptr, Options,
+		FNekoTimelineTypedOutput::MakeVector(Value, Curve), OutputPins, Progress);
+}
+
+void UNekoFunctionLibrary::PseudoTimeline_Rotator(const UObject* WorldContext, const FLatentActionInfo LatentInfo,
+	const float Time, const FRotator A, const FRotator B, const UCurveFloat* Curve, const FNekoPseudoTimelineOptions& Options,
+	EPseudoTimelineOutputPins& OutputPins, float& Progress, FRotator& Value)
+{
+	InternalNekoLibrary::StartTypedTimeline(WorldContext, LatentInfo, Time, Curve, Options,
+		FNekoTimelineTypedOutput::MakeRotator(Value, A, B), OutputPins, Progress);
+}
+
+void UNekoFunctionLibrary::PseudoTimeline_LinearColor(const UObject* WorldContext, const FLatentActionInfo LatentInfo,
+	const float Time, const FLinearColor A, const FLinearColor B, const UCurveFloat* Curve,
+	const FNekoPseudoTimelineOptions& Options, EPseudoTimelineOutputPins& OutputPins, float& Progress, FLinearColor& Value)
+{
+	InternalNekoLibrary::StartTypedTimeline(WorldContext, LatentInfo, Time, Curve, Options,
+		FNekoTimelineTypedOutput::MakeLinearColor(Value, A, B), OutputPins, Progress);
+}
+
+void UNekoFunctionLibrary::PseudoTimeline_LinearColorCurve(const UObject* WorldContext, const FLatentActionInfo LatentInfo,
+	const float Time, const UCurveLinearColor* Curve, const FNekoPseudoTimelineOptions& Options,
+	EPseudoTimelineOutputPins& OutputPins, float& Progress, FLinearColor& Value)
+{
+	if (Curve == nullptr)
+	{
+		UE_LOG(LogNekoUtils, Error, TEXT("Tried to execute a PseudoTimeline (Linear Color Curve) without any curve!"));
+		return;
+	}
+
+	InternalNekoLibrary::StartTypedTimeline(WorldContext, LatentInfo, Time, nullptr, Options,
+		FNekoTimelineTypedOutput::MakeLinearColor(Value, Curve), OutputPins, Progress);
+}
+
+void UNekoFunctionLibrary::PseudoTimeline_Transform(const UObject* WorldContext, const FLatentActionInfo LatentInfo,
+	const float Time, const FTransform& A, const FTransform& B, const UCurveFloat* Curve,
+	const FNekoPseudoTimelineOptions& Options, EPseudoTimelineOutputPins& OutputPins, float& Progress, FTransform& Value)
+{
+	InternalNekoLibrary::StartTypedTimeline(WorldContext, LatentInfo, Time, Curve, Options,
+		FNekoTimelineTypedOutput::MakeTransform(Value, A, B), OutputPins, Progress);
+}
+
+void UNekoFunctionLibrary::PseudoTimelineToTarget(const UObject* WorldContext, const FLatentActionInfo LatentInfo,
+	const float Time, const UCurveFloat* Curve, const FNekoTimelineTarget& Target, const FNekoPseudoTimelineOptions& Options)
 {
-	UWorld* World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull);
-	if (World == nullptr)
+	UNekoTimelineSubsystem* TimelineSubsystem = InternalNekoLibrary::GetTimelineSubsystem(WorldContext);
+	if (TimelineSubsystem == nullptr)
 	{
-		UE_LOG(LogNekoUtils, Error, TEXT("Tried to execute a PseudoTimeline, but could not find World!"));
 		return;
 	}
 
-	FLatentActionManager& LatentActionManager = World->GetLatentActionManager();
-	if (FPseudoTimelineLatentAction* Action = LatentActionManager.FindExistingAction<FPseudoTimelineLatentAction>(LatentInfo.CallbackTarget, LatentInfo.UUID))
+	if (TimelineSubsystem->IsTimelineRunning(LatentInfo.CallbackTarget, LatentInfo.UUID))
 	{
-		Action->Reset();
+		UE_LOG(LogNekoUtils, Warning, TEXT("Tried to re-execute a non-retriggerable PseudoTimeline that was already started"));
 		return;
 	}
 
-	FPseudoTimelineLatentAction* Action = new FPseudoTimelineLatentAction(LatentInfo, Time, Curve, OutputPins, Progress, Alpha);
-	LatentActionManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID, Action);
+	if (!TimelineSubsystem->StartTargetTimeline(LatentInfo, Time, Curve, Options, Target, false))
+	{
+		UE_LOG(LogNekoUtils, Error, TEXT("Tried to execute a PseudoTimeline, but its target could not be driven!"));
+	}
+}
+
+FNekoTimelineTarget UNekoFunctionLibrary::MakeTimelineTarget_FloatProperty(UObject* Object, const FName PropertyPath,
+	const double A, const double B)
+{
+	FNekoTimelineTarget Target;
+	Target.Type = ENekoTimelineTargetType::Property;
+	Target.Object = Object;
+	Target.Name = PropertyPath;
+	Target.A.X = A;
+	Target.B.X = B;
+	return Target;
+}
+
+FNekoTimelineTarget UNekoFunctionLibrary::MakeTimelineTarget_VectorProperty(UObject* Object, const FName PropertyPath,
+	const FVector A, const FVector B)
+{
+	FNekoTimelineTarget Target;
+	Target.Type = ENekoTimelineTargetType::Property;
+	Target.Object = Object;
+	Target.Name = PropertyPath;
+	Target.A = FVector4(A, 0.0);
+	Target.B = FVector4(B, 0.0);
+	return Target;
+}
+
+FNekoTimelineTarget UNekoFunctionLibrary::MakeTimelineTarget_ColorProperty(UObject* Object, const FName PropertyPath,
+	const FLinearColor A, const FLinearColor B)
+{
+	FNekoTimelineTarget Target;
+	Target.Type = ENekoTimelineTargetType::Property;
+	Target.Object = Object;
+	Target.Name = PropertyPath;
+	Target.A = FVector4(A);
+	Target.B = FVector4(B);
+	return Target;
+}
+
+FNekoTimelineTarget UNekoFunctionLibrary::MakeTimelineTarget_MaterialScalar(UMaterialInstanceDynamic* Material,
+	const FName ParameterName, const float A, const float B)
+{
+	FNekoTimelineTarget Target;
+	Target.Type = ENekoTimelineTargetType::MaterialScalarParameter;
+	Target.Object = Material;
+	Target.Name = ParameterName;
+	Target.A.X = A;
+	Target.B.X = B;
+	return Target;
+}
+
+FNekoTimelineTarget UNekoFunctionLibrary::MakeTimelineTarget_MaterialVector(UMaterialInstanceDynamic* Material,
+	const FName ParameterName, const FLinearColor A, const FLinearColor B)
+{
+	FNekoTimelineTarget Target;
+	Target.Type = ENekoTimelineTargetType::MaterialVectorParameter;
+	Target.Object = Material;
+	Target.Name = ParameterName;
+	Target.A = FVector4(A);
+	Target.B = FVector4(B);
+	return Target;
+}
+
+FNekoTimelineTarget UNekoFunctionLibrary::MakeTimelineTarget_Widget(UWidget* Widget, const ENekoWidgetRenderField Field,
+	const FVector2D A, const FVector2D B)
+{
+	FNekoTimelineTarget Target;
+	Target.Type = ENekoTimelineTargetType::Widget;
+	Target.Object = Widget;
+	Target.WidgetField = Field;
+	Target.A = FVector4(A.X, A.Y, 0.0, 0.0);
+	Target.B = FVector4(B.X, B.Y, 0.0, 0.0);
+	return Target;
 }
 
 double UNekoFunctionLibrary::ExponentialDecay_Double(const double A, const double B, const float Decay, const float DeltaTime)
@@ -234,6 +514,73 @@ FVector UNekoFunctionLibrary::ExponentialDecay_Vector(const FVector A, const FVe
 	return InternalNekoLibrary::ExponentialDecay(A, B, Decay, DeltaTime);
 }
 
+FQuat UNekoFunctionLibrary::ExponentialDecay_Quat(const FQuat& A, const FQuat& B, const float Decay, const float DeltaTime)
+{
+	return InternalNekoLibrary::ExponentialDecay(A, B, Decay, DeltaTime);
+}
+
+FRotator UNekoFunctionLibrary::ExponentialDecay_Rotator(const FRotator A, const FRotator B, const float Decay, const float DeltaTime)
+{
+	return InternalNekoLibrary::ExponentialDecay(A, B, Decay, DeltaTime);
+}
+
+FTransform UNekoFunctionLibrary::ExponentialDecay_Transform(const FTransform& A, const FTransform& B, const float Decay, const float DeltaTime)
+{
+	return InternalNekoLibrary::ExponentialDecay(A, B, Decay, DeltaTime);
+}
+
+TArray<double> UNekoFunctionLibrary::ExponentialDecay_DoubleArray(const TArray<double>& A, const TArray<double>& B, const float Decay, const float DeltaTime)
+{
+	TArray<double> Values = A;
+	InternalNekoLibrary::ExponentialDecayArray<double>(Values, B, Decay, DeltaTime);
+	return Values;
+}
+
+void UNekoFunctionLibrary::ExponentialDecayInPlace_DoubleArray(TArray<double>& Values, const TArray<double>& Targets, const float Decay, const float DeltaTime)
+{
+	InternalNekoLibrary::ExponentialDecayArray<double>(Values, Targets, Decay, DeltaTime);
+}
+
+TArray<FVector> UNekoFunctionLibrary::ExponentialDecay_VectorArray(const TArray<FVector>& A, const TArray<FVector>& B, const float Decay, const float DeltaTime)
+{
+	TArray<FVector> Values = A;
+	InternalNekoLibrary::ExponentialDecayArray<FVector>(Values, B, Decay, DeltaTime);
+	return Values;
+}
+
+void UNekoFunctionLibrary::ExponentialDecayInPlace_VectorArray(TArray<FVector>& Values, const TArray<FVector>& Targets, const float Decay, const float DeltaTime)
+{
+	InternalNekoLibrary::ExponentialDecayArray<FVector>(Values, Targets, Decay, DeltaTime);
+}
+
+double UNekoFunctionLibrary::UpdateSpring_Float(FNekoSpringFloat& Spring, const double Target, const float Frequency, const float DampingRatio, const float DeltaTime)
+{
+	NekoSpring::Update(Spring, Target, NekoSpring::FCoefficients::Compute(Frequency, DampingRatio, DeltaTime));
+	return Spring.Value;
+}
+
+FVector UNekoFunctionLibrary::UpdateSpring_Vector(FNekoSpringVector& Spring, const FVector Target, const float Frequency, const float DampingRatio, const float DeltaTime)
+{
+	NekoSpring::Update(Spring, Target, NekoSpring::FCoefficients::Compute(Frequency, DampingRatio, DeltaTime));
+	return Spring.Value;
+}
+
+FQuat UNekoFunctionLibrary::UpdateSpring_Quat(FNekoSpringQuat& Spring, const FQuat& Target, const float Frequency, const float DampingRatio, const float DeltaTime)
+{
+	NekoSpring::Update(Spring, Target, NekoSpring::FCoefficients::Compute(Frequency, DampingRatio, DeltaTime));
+	return Spring.Value;
+}
+
+void UNekoFunctionLibrary::UpdateSprings_DoubleArray(TArray<double>& Values, TArray<double>& Velocities, const TArray<double>& Targets, const float Frequency, const float DampingRatio, const float DeltaTime)
+{
+	InternalNekoLibrary::UpdateSpringArray(Values, Velocities, Targets, Frequency, DampingRatio, DeltaTime);
+}
+
+void UNekoFunctionLibrary::UpdateSprings_VectorArray(TArray<FVector>& Values, TArray<FVector>& Velocities, const TArray<FVector>& Targets, const float Frequency, const float DampingRatio, const float DeltaTime)
+{
+	InternalNekoLibrary::UpdateSpringArray(Values, Velocities, Targets, Frequency, DampingRatio, DeltaTime);
+}
+
 double UNekoFunctionLibrary::GetInfinity_Double()
 {
 	return std::numeric_limits<double>::infinity();
@@ -300,12 +647,10 @@ void UNekoFunctionLibrary::SetCommonMouseMode(APlayerController* PlayerControlle
 
 UWidget* UNekoFunctionLibrary::FindFocusedWidget(APlayerController* Player)
 {
-	for (TObjectIterator<UWidget> It; It; ++It)
+	const ULocalPlayer* LocalPlayer = Player ? Player->GetLocalPlayer() : nullptr;
+	if (const UNekoFocusedWidgetTracker* FocusedWidgetTracker = ULocalPlayer::GetSubsystem<UNekoFocusedWidgetTracker>(LocalPlayer))
 	{
-		if (It->HasUserFocus(Player))
-		{
-			return *It;
-		}
+		return FocusedWidgetTracker->GetFocusedWidget();
 	}
 	return nullptr;
 }
@@ -316,9 +661,9 @@ ECommonInputType UNekoFunctionLibrary::GetOwningPlayerInputType(const UUserWidge
 		return ECommonInputType::Count;
 	}
 
-	if (const UCommonInputSubsystem* InputSubsystem = UCommonInputSubsystem::Get(Widget->GetOwningLocalPlayer()))
+	if (const UNekoInputStateSubsystem* InputState = UNekoInputStateSubsystem::Get(Widget->GetOwningLocalPlayer()))
 	{
-		return InputSubsystem->GetCurrentInputType();
+		return InputState->GetCurrentInputType();
 	}
 
 	return ECommonInputType::Count;
@@ -330,9 +675,9 @@ bool UNekoFunctionLibrary::IsOwningPlayerUsingGamepad(const UUserWidget* Widget)
 		return false;
 	}
 
-	if (const UCommonInputSubsystem* InputSubsystem = UCommonInputSubsystem::Get(Widget->GetOwningLocalPlayer()))
+	if (const UNekoInputStateSubsystem* InputState = UNekoInputStateSubsystem::Get(Widget->GetOwningLocalPlayer()))
 	{
-		return InputSubsystem->GetCurrentInputType() == ECommonInputType::Gamepad;
+		return InputState->IsUsingGamepad();
 	}
 
 	return false;
@@ -344,14 +689,39 @@ bool UNekoFunctionLibrary::IsOwningPlayerUsingTouch(const UUserWidget* Widget)
 		return false;
 	}
 
-	if (const UCommonInputSubsystem* InputSubsystem = UCommonInputSubsystem::Get(Widget->GetOwningLocalPlayer()))
+	if (const UNekoInputStateSubsystem* InputState = UNekoInputStateSubsystem::Get(Widget->GetOwningLocalPlayer()))
 	{
-		return InputSubsystem->GetCurrentInputType() == ECommonInputType::Touch;
+		return InputState->IsUsingTouch();
 	}
 
 	return false;
 }
 
+void UNekoFunctionLibrary::BindVisibilityToInputType(UUserWidget* OwningWidget, UWidget* Widget, const int32 InputTypes,
+	const ESlateVisibility VisibleVisibility, const ESlateVisibility HiddenVisibility)
+{
+	if (OwningWidget == nullptr || Widget == nullptr)
+	{
+		return;
+	}
+
+	UNekoInputTypeVisibilityExtension* Extension = OwningWidget->GetExtension<UNekoInputTypeVisibilityExtension>();
+	if (Extension == nullptr)
+	{
+		Extension = OwningWidget->AddExtension<UNekoInputTypeVisibilityExtension>();
+	}
+
+	Extension->AddBinding(Widget, InputTypes, VisibleVisibility, HiddenVisibility);
+}
+
+void UNekoFunctionLibrary::UnbindVisibilityFromInputType(UUserWidget* OwningWidget, UWidget* Widget)
+{
+	if (UNekoInputTypeVisibilityExtension* Extension = OwningWidget ? OwningWidget->GetExtension<UNekoInputTypeVisibilityExtension>() : nullptr)
+	{
+		Extension->RemoveBinding(Widget);
+	}
+}
+
 UNekoRootUILayout* UNekoFunctionLibrary::GetRootUILayout_ForPlayer(const APlayerController* PlayerController)
 {
 	if (const ULocalPlayer* LP = PlayerController->GetLocalPlayer())
@@ -402,9 +772,35 @@ void UNekoFunctionLibrary::PopWidgetFromLayer(UCommonActivatableWidget* Widget)
 
 void UNekoFunctionLibrary::HideActorForPlayer(APlayerController* Player, AActor* Actor)
 {
-	if (Player && Actor)
+	if (Player == nullptr || Actor == nullptr)
+	{
+		return;
+	}
+
+	if (UNekoPlayerVisibilitySubsystem* Visibility = UNekoPlayerVisibilitySubsystem::Get(Player))
+	{
+		Visibility->HideActor(Actor);
+	}
+	else
+	{
+		Player->HiddenActors.AddUnique(Actor);
+	}
+}
+
+void UNekoFunctionLibrary::UnhideActorForPlayer(APlayerController* Player, AActor* Actor)
+{
+	if (Player == nullptr || Actor == nullptr)
+	{
+		return;
+	}
+
+	if (UNekoPlayerVisibilitySubsystem* Visibility = UNekoPlayerVisibilitySubsystem::Get(Player))
+	{
+		Visibility->UnhideActor(Actor);
+	}
+	else
 	{
-		Player->HiddenActors.Add(Actor);
+		Player->HiddenActors.RemoveSingleSwap(Actor);
 	}
 }
 
@@ -426,17 +822,22 @@ void UNekoFunctionLibrary::GenericMap_Get(void* TargetMap, const FMapProperty* M
 		FProperty* KeyProp = MapHelper.KeyProp;
 		FProperty* ValueProp = MapHelper.ValueProp;
 
-		if (MapHelper.IsValidIndex(Index))
+		// The index is a position among the elements, which are only contiguous in the map's storage when nothing was
+		// removed from it. Otherwise finding the element walks the storage up to it.
+		const int32 Num = MapHelper.Num();
+		const bool bHasHoles = MapHelper.GetMaxIndex() != Num;
+		const int32 InternalIndex = bHasHoles ? MapHelper.FindInternalIndex(Index) : (Index >= 0 && Index < Num ? Index : INDEX_NONE);
+		if (InternalIndex != INDEX_NONE)
 		{
-			KeyProp->CopyCompleteValueFromScriptVM(KeyPtr, MapHelper.GetKeyPtr(Index));
-			ValueProp->CopyCompleteValueFromScriptVM(ValuePtr, MapHelper.GetValuePtr(Index));
+			KeyProp->CopyCompleteValueFromScriptVM(KeyPtr, MapHelper.GetKeyPtr(InternalIndex));
+			ValueProp->CopyCompleteValueFromScriptVM(ValuePtr, MapHelper.GetValuePtr(InternalIndex));
 		}
 		else
 		{
 			FFrame::KismetExecutionMessage(*FString::Printf(TEXT("Attempted to access index %d from map '%s' of length %d in '%s'!"),
 			                                                Index,
 			                                                *MapProp->GetName(),
-			                                                MapHelper.Num(),
+			                                                Num,
 			                                                *MapProp->GetOwnerVariant().GetPathName()),
 			                               ELogVerbosity::Warning,
 			                               FName("GetOutOfBoundsWarning"));
@@ -445,3 +846,123 @@ void UNekoFunctionLibrary::GenericMap_Get(void* TargetMap, const FMapProperty* M
 		}
 	}
 }
+
+bool UNekoFunctionLibrary::Map_Next(const TMap<int32, int32>& TargetMap, int32& Cursor, int32& Key, int32& Value)
+{
+	checkNoEntry();
+	return false;
+}
+
+bool UNekoFunctionLibrary::GenericMap_Next(void* TargetMap, const FMapProperty* MapProp, int32& Cursor, void* KeyPtr,
+                                           void* ValuePtr)
+{
+	if (TargetMap == nullptr)
+	{
+		return false;
+	}
+
+	FScriptMapHelper MapHelper(MapProp, TargetMap);
+
+	// The cursor is an index in the map's storage, skipping the holes left by removed elements
+	const int32 MaxIndex = MapHelper.GetMaxIndex();
+	for (int32 Index = FMath::Max(Cursor, 0); Index < MaxIndex; ++Index)
+	{
+		if (MapHelper.IsValidIndex(Index))
+		{
+			MapHelper.KeyProp->CopyCompleteValueFromScriptVM(KeyPtr, MapHelper.GetKeyPtr(Index));
+			MapHelper.ValueProp->CopyCompleteValueFromScriptVM(ValuePtr, MapHelper.GetValuePtr(Index));
+			Cursor = Index + 1;
+			return true;
+		}
+	}
+
+	Cursor = MaxIndex;
+	return false;
+}
+
+void UNekoFunctionLibrary::Map_KeysToArray(const TMap<int32, int32>& TargetMap, TArray<int32>& Keys)
+{
+	checkNoEntry();
+}
+
+void UNekoFunctionLibrary::Map_ValuesToArray(const TMap<int32, int32>& TargetMap, TArray<int32>& Values)
+{
+	checkNoEntry();
+}
+
+void UNekoFunctionLibrary::Map_PairsToArrays(const TMap<int32, int32>& TargetMap, TArray<int32>& Keys, TArray<int32>& Values)
+{
+	checkNoEntry();
+}
+
+void UNekoFunctionLibrary::GenericMap_ToArrays(void* TargetMap, const FMapProperty* MapProp, void* KeysArray,
+                                               const FArrayProperty* KeysArrayProp, void* ValuesArray,
+                                               const FArrayProperty* ValuesArrayProp)
+{
+	if (TargetMap == nullptr)
+	{
+		return;
+	}
+
+	FScriptMapHelper MapHelper(MapProp, TargetMap);
+	const int32 Num = MapHelper.Num();
+	const int32 MaxIndex = MapHelper.GetMaxIndex();
+
+	const auto CopyToArray = [MapProp, &MapHelper, Num, MaxIndex](void* Array, const FArrayProperty* ArrayProp, const FProperty* ElementProp, const bool bKeys)
+	{
+		if (Array == nullptr || ArrayProp == nullptr)
+		{
+			return;
+		}
+
+		if (!ArrayProp->Inner->SameType(ElementProp))
+		{
+			FFrame::KismetExecutionMessage(*FString::Printf(TEXT("Attempted to copy the %s of map '%s' to array '%s' of another type in '%s'!"),
+			                                                bKeys ? TEXT("keys") : TEXT("values"),
+			                                                *MapProp->GetName(),
+			                                                *ArrayProp->GetName(),
+			                                                *MapProp->GetOwnerVariant().GetPathName()),
+			                               ELogVerbosity::Warning,
+			                               FName("MapToArrayTypeMismatchWarning"));
+			return;
+		}
+
+		FScriptArrayHelper ArrayHelper(ArrayProp, Array);
+		ArrayHelper.EmptyValues(Num);
+
+		// Keys and values are interleaved in the map's storage, so they can only be copied one element at a time
+		const bool bTriviallyCopyable = ElementProp->HasAllPropertyFlags(CPF_IsPlainOldData);
+		if (bTriviallyCopyable)
+		{
+			ArrayHelper.AddUninitializedValues(Num);
+		}
+		else
+		{
+			ArrayHelper.AddValues(Num);
+		}
+
+		const int32 ElementSize = ElementProp->GetElementSize() * ElementProp->ArrayDim;
+		int32 ArrayIndex = 0;
+		for (int32 Index = 0; Index < MaxIndex; ++Index)
+		{
+			if (!MapHelper.IsValidIndex(Index))
+			{
+				continue;
+			}
+
+			const uint8* Source = bKeys ? MapHelper.GetKeyPtr(Index) : MapHelper.GetValuePtr(Index);
+			uint8* Destination = ArrayHelper.GetRawPtr(ArrayIndex++);
+			if (bTriviallyCopyable)
+			{
+				FMemory::Memcpy(Destination, Source, ElementSize);
+			}
+			else
+			{
+				ElementProp->CopyCompleteValueFromScriptVM(Destination, Source);
+			}
+		}
+	};
+
+	CopyToArray(KeysArray, KeysArrayProp, MapHelper.KeyProp, true);
+	CopyToArray(ValuesArray, ValuesArrayProp, MapHelper.ValueProp, false);
+}
@@ -0,0 +1,132 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#include "NekoGameplayTagIndex.h"
+
+#include "NekoLogCategories.h"
+
+#include "GameplayTagsManager.h"
+#include "GameplayTagsModule.h"
+
+
+FNekoGameplayTagIndex& FNekoGameplayTagIndex::Get()
+{
+	static FNekoGameplayTagIndex Instance;
+	return Instance;
+}
+
+FNekoGameplayTagIndex::FNekoGameplayTagIndex()
+{
+	TagTreeChangedHandle = IGameplayTagsModule::OnGameplayTagTreeChanged.AddRaw(this, &FNekoGameplayTagIndex::Rebuild);
+	Rebuild();
+}
+
+FNekoGameplayTagIndex::~FNekoGameplayTagIndex()
+{
+	IGameplayTagsModule::OnGameplayTagTreeChanged.Remove(TagTreeChangedHandle);
+}
+
+int32 FNekoGameplayTagIndex::GetNumChildren(const int32 Index) const
+{
+	int32 NumChildren = 0;
+	ForEachChild(Index, [&NumChildren](const int32) { ++NumChildren; });
+	return NumChildren;
+}
+
+void FNekoGameplayTagIndex::Rebuild()
+{
+	check(IsInGameThread());
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	Tags.Reset();
+	SubtreeEnds.Reset();
+	ParentIndices.Reset();
+	TagIndices.Reset();
+	LeafNames.Reset();
+	LeafAnsiNames.Reset();
+	LeafAnsiNameOffsets.Reset();
+	LeafNameIndices.Reset();
+	++Version;
+
+	const UGameplayTagsManager& TagsManager = UGameplayTagsManager::Get();
+
+	// Every node can reach the root node, which is the only one without a parent
+	FGameplayTagContainer AllTags;
+	TagsManager.RequestAllGameplayTags(AllTags, false);
+	if (AllTags.IsEmpty())
+	{
+		return;
+	}
+
+	const TSharedPtr<FGameplayTagNode> FirstNode = TagsManager.FindTagNode(AllTags.GetByIndex(0));
+	const FGameplayTagNode* RootNode = FirstNode.Get();
+	while (RootNode != nullptr && RootNode->GetParentTagNode() != nullptr)
+	{
+		RootNode = RootNode->GetParentTagNode();
+	}
+
+	if (RootNode == nullptr)
+	{
+		return;
+	}
+
+	Tags.Reserve(AllTags.Num());
+	SubtreeEnds.Reserve(AllTags.Num());
+	ParentIndices.Reserve(AllTags.Num());
+	TagIndices.Reserve(AllTags.Num());
+	LeafNames.Reserve(AllTags.Num());
+	LeafAnsiNameOffsets.Reserve(AllTags.Num());
+
+	// Depth-first walk, the ends of the subtrees are filled in once every descendant was added
+	struct FStackEntry
+	{
+		const FGameplayTagNode* Node;
+		int32 Index;
+		int32 NextChild;
+	};
+
+	TArray<FStackEntry, TInlineAllocator<16>> Stack;
+	Stack.Add({RootNode, INDEX_NONE, 0});
+
+	while (!Stack.IsEmpty())
+	{
+		FStackEntry& Entry = Stack.Last();
+		const TArray<TSharedPtr<FGameplayTagNode>>& ChildNodes = Entry.Node->GetChildTagNodes();
+
+		if (!ChildNodes.IsValidIndex(Entry.NextChild))
+		{
+			if (Entry.Index != INDEX_NONE)
+			{
+				SubtreeEnds[Entry.Index] = Tags.Num();
+			}
+			Stack.Pop(EAllowShrinking::No);
+			continue;
+		}
+
+		const FGameplayTagNode* ChildNode = ChildNodes[Entry.NextChild++].Get();
+		if (ChildNode == nullptr)
+		{
+			continue;
+		}
+
+		const int32 ChildIndex = Tags.Add(ChildNode->GetCompleteTag());
+		SubtreeEnds.Add(ChildIndex + 1);
+		ParentIndices.Add(Entry.Index);
+		TagIndices.Add(Tags[ChildIndex], ChildIndex);
+
+		// The simple name of a node is already the last component of its tag, so nothing needs to be parsed
+		const FName LeafName = ChildNode->GetSimpleTagName();
+		LeafNames.Add(LeafName);
+		LeafNameIndices.FindOrAdd(LeafName, ChildIndex);
+
+		const TStringBuilder<FName::StringBufferSize> LeafBuffer(InPlace, LeafName);
+		const auto LeafAnsiName = StringCast<ANSICHAR>(LeafBuffer.GetData(), LeafBuffer.Len());
+		LeafAnsiNameOffsets.Add(LeafAnsiNames.Num());
+		LeafAnsiNames.Append(LeafAnsiName.Get(), LeafAnsiName.Length());
+		LeafAnsiNames.Add('\0');
+
+		Stack.Add({ChildNode, ChildIndex, 0});
+	}
+
+	UE_LOG(LogNekoUtils, Verbose, TEXT("Built the gameplay tag index with %d tags in %.2fms"), Tags.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
@@ -0,0 +1,290 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#include "NekoPlayerVisibilitySubsystem.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "Engine/LocalPlayer.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(NekoPlayerVisibilitySubsystem)
+
+
+UNekoPlayerVisibilitySubsystem* UNekoPlayerVisibilitySubsystem::Get(const APlayerController* Player)
+{
+	return Player ? ULocalPlayer::GetSubsystem<UNekoPlayerVisibilitySubsystem>(Player->GetLocalPlayer()) : nullptr;
+}
+
+void UNekoPlayerVisibilitySubsystem::Deinitialize()
+{
+	UnhideAllActors();
+
+	Super::Deinitialize();
+}
+
+void UNekoPlayerVisibilitySubsystem::PlayerControllerChanged(APlayerController* NewPlayerController)
+{
+	Super::PlayerControllerChanged(NewPlayerController);
+
+	if (AppliedPlayerController == NewPlayerController)
+	{
+		return;
+	}
+
+	PruneHiddenActors();
+
+	if (APlayerController* OldPlayerController = AppliedPlayerController.Get())
+	{
+		RemoveHiddenActors(*OldPlayerController, HiddenActors);
+	}
+
+	AppliedPlayerController = NewPlayerController;
+
+	if (NewPlayerController)
+	{
+		for (const TWeakObjectPtr<AActor>& Actor : HiddenActors)
+		{
+			ApplyHiddenActor(*NewPlayerController, *Actor.Get());
+		}
+	}
+}
+
+void UNekoPlayerVisibilitySubsystem::HideActor(AActor* Actor)
+{
+	HideActors({Actor});
+}
+
+void UNekoPlayerVisibilitySubsystem::UnhideActor(AActor* Actor)
+{
+	UnhideActors({Actor});
+}
+
+void UNekoPlayerVisibilitySubsystem::HideActors(const TArray<AActor*>& Actors)
+{
+	if (!AppliedPlayerController.IsValid())
+	{
+		AppliedPlayerController = GetLocalPlayer()->GetPlayerController(nullptr);
+	}
+
+	APlayerController* PlayerController = AppliedPlayerController.Get();
+	for (AActor* Actor : Actors)
+	{
+		if (Actor == nullptr)
+		{
+			continue;
+		}
+
+		bool bAlreadyHidden = false;
+		HiddenActors.Add(Actor, &bAlreadyHidden);
+		if (!bAlreadyHidden && PlayerController)
+		{
+			ApplyHiddenActor(*PlayerController, *Actor);
+		}
+	}
+}
+
+void UNekoPlayerVisibilitySubsystem::UnhideActors(const TArray<AActor*>& Actors)
+{
+	TSet<TWeakObjectPtr<AActor>> ActorsToUnhide;
+	ActorsToUnhide.Reserve(Actors.Num());
+	for (AActor* Actor : Actors)
+	{
+		if (Actor && HiddenActors.Remove(Actor) > 0)
+		{
+			ActorsToUnhide.Add(Actor);
+		}
+	}
+
+	APlayerController* PlayerController = AppliedPlayerController.Get();
+	if (PlayerController && !ActorsToUnhide.IsEmpty())
+	{
+		RemoveHiddenActors(*PlayerController, ActorsToUnhide);
+	}
+}
+
+void UNekoPlayerVisibilitySubsystem::HideActorsWithTag(const FName Tag)
+{
+	TArray<AActor*> Actors;
+	UGameplayStatics::GetAllActorsWithTag(GetLocalPlayer(), Tag, Actors);
+	HideActors(Actors);
+}
+
+void UNekoPlayerVisibilitySubsystem::UnhideActorsWithTag(const FName Tag)
+{
+	TArray<AActor*> Actors;
+	for (const TWeakObjectPtr<AActor>& Actor : HiddenActors)
+	{
+		if (Actor.IsValid() && Actor->ActorHasTag(Tag))
+		{
+			Actors.Add(Actor.Get());
+		}
+	}
+	UnhideActors(Actors);
+}
+
+void UNekoPlayerVisibilitySubsystem::UnhideAllActors()
+{
+	if (APlayerController* PlayerController = AppliedPlayerController.Get())
+	{
+		RemoveHiddenActors(*PlayerController, HiddenActors);
+	}
+
+	HiddenActors.Reset();
+}
+
+bool UNekoPlayerVisibilitySubsystem::IsActorHidden(const AActor* Actor) const
+{
+	return Actor && HiddenActors.Contains(MakeWeakObjectPtr(const_cast<AActor*>(Actor)));
+}
+
+void UNekoPlayerVisibilitySubsystem::SetHidingMode(const ENekoActorHidingMode NewHidingMode)
+{
+	if (HidingMode == NewHidingMode)
+	{
+		return;
+	}
+
+	PruneHiddenActors();
+
+	APlayerController* PlayerController = AppliedPlayerController.Get();
+	if (PlayerController)
+	{
+		RemoveHiddenActors(*PlayerController, HiddenActors);
+	}
+
+	HidingMode = NewHidingMode;
+
+	if (PlayerController)
+	{
+		for (const TWeakObjectPtr<AActor>& Actor : HiddenActors)
+		{
+			ApplyHiddenActor(*PlayerController, *Actor.Get());
+		}
+	}
+}
+
+void UNekoPlayerVisibilitySubsystem::ApplyHiddenActor(APlayerController& PlayerController, AActor& Actor)
+{
+	switch (HidingMode)
+	{
+	case ENekoActorHidingMode::HiddenActors:
+		PlayerController.HiddenActors.Add(&Actor);
+		break;
+	case ENekoActorHidingMode::HiddenPrimitiveComponents:
+		Actor.ForEachComponent<UPrimitiveComponent>(false, [&PlayerController](UPrimitiveComponent* Component)
+		{
+			PlayerController.HiddenPrimitiveComponents.Add(Component);
+		});
+		break;
+	case ENekoActorHidingMode::OwnerNoSee:
+	{
+		FOwnerNoSeeActor& OwnerNoSeeActor = OwnerNoSeeActors.Add(&Actor);
+		OwnerNoSeeActor.OriginalOwner = Actor.GetOwner();
+
+		// Views only hide the components of their view target and of the actors it owns, directly or not
+		AActor* ViewTarget = PlayerController.GetViewTarget();
+		bool bOwnedByViewTarget = false;
+		for (const AActor* Owner = &Actor; Owner != nullptr && !bOwnedByViewTarget; Owner = Owner->GetOwner())
+		{
+			bOwnedByViewTarget = Owner == ViewTarget;
+		}
+
+		if (!bOwnedByViewTarget && ViewTarget != nullptr)
+		{
+			Actor.SetOwner(ViewTarget);
+			OwnerNoSeeActor.AppliedOwner = ViewTarget;
+		}
+
+		// Flagged after the owner changed, so that the render state is recreated with the new owner
+		Actor.ForEachComponent<UPrimitiveComponent>(false, [&OwnerNoSeeActor](UPrimitiveComponent* Component)
+		{
+			if (!Component->bOwnerNoSee)
+			{
+				Component->SetOwnerNoSee(true);
+				OwnerNoSeeActor.Components.Add(Component);
+			}
+		});
+		break;
+	}
+	}
+}
+
+void UNekoPlayerVisibilitySubsystem::RemoveHiddenActors(APlayerController& PlayerController, const TSet<TWeakObjectPtr<AActor>>& Actors)
+{
+	// Each actor was added once, so only one of its entries is removed, leaving the ones that other code added
+	switch (HidingMode)
+	{
+	case ENekoActorHidingMode::HiddenActors:
+	{
+		TSet<TWeakObjectPtr<AActor>> ActorsToRemove = Actors;
+		PlayerController.HiddenActors.RemoveAllSwap([&ActorsToRemove](AActor* Actor)
+		{
+			return ActorsToRemove.Remove(Actor) > 0;
+		});
+		break;
+	}
+	case ENekoActorHidingMode::HiddenPrimitiveComponents:
+	{
+		TSet<TWeakObjectPtr<UPrimitiveComponent>> ComponentsToRemove;
+		for (const TWeakObjectPtr<AActor>& Actor : Actors)
+		{
+			if (Actor.IsValid())
+			{
+				Actor->ForEachComponent<UPrimitiveComponent>(false, [&ComponentsToRemove](UPrimitiveComponent* Component)
+				{
+					ComponentsToRemove.Add(Component);
+				});
+			}
+		}
+
+		PlayerController.HiddenPrimitiveComponents.RemoveAllSwap([&ComponentsToRemove](const TWeakObjectPtr<UPrimitiveComponent>& Component)
+		{
+			return ComponentsToRemove.Remove(Component) > 0;
+		});
+		break;
+	}
+	case ENekoActorHidingMode::OwnerNoSee:
+		for (const TWeakObjectPtr<AActor>& Actor : Actors)
+		{
+			FOwnerNoSeeActor OwnerNoSeeActor;
+			if (!OwnerNoSeeActors.RemoveAndCopyValue(Actor, OwnerNoSeeActor))
+			{
+				continue;
+			}
+
+			for (const TWeakObjectPtr<UPrimitiveComponent>& Component : OwnerNoSeeActor.Components)
+			{
+				if (Component.IsValid())
+				{
+					Component->SetOwnerNoSee(false);
+				}
+			}
+
+			// Left alone if something else changed the owner in the meantime
+			if (Actor.IsValid() && OwnerNoSeeActor.AppliedOwner.IsValid() && Actor->GetOwner() == OwnerNoSeeActor.AppliedOwner.Get())
+			{
+				Actor->SetOwner(OwnerNoSeeActor.OriginalOwner.Get());
+			}
+		}
+		break;
+	}
+}
+
+void UNekoPlayerVisibilitySubsystem::PruneHiddenActors()
+{
+	for (auto It = HiddenActors.CreateIterator(); It; ++It)
+	{
+		if (!It->IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	for (auto It = OwnerNoSeeActors.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
@@ -0,0 +1,63 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#include "NekoSmoothFollowComponent.h"
+
+#include "NekoSmoothFollowSubsystem.h"
+
+#include "Components/SceneComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(NekoSmoothFollowComponent)
+
+
+UNekoSmoothFollowComponent::UNekoSmoothFollowComponent()
+{
+	// Updated by UNekoSmoothFollowSubsystem instead
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UNekoSmoothFollowComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UNekoSmoothFollowSubsystem* Subsystem = UWorld::GetSubsystem<UNekoSmoothFollowSubsystem>(GetWorld()))
+	{
+		Subsystem->RegisterFollower(this);
+	}
+}
+
+void UNekoSmoothFollowComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UNekoSmoothFollowSubsystem* Subsystem = UWorld::GetSubsystem<UNekoSmoothFollowSubsystem>(GetWorld()))
+	{
+		Subsystem->UnregisterFollower(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UNekoSmoothFollowComponent::SetFollowTarget(USceneComponent* NewFollowTarget)
+{
+	FollowTarget = NewFollowTarget;
+}
+
+void UNekoSmoothFollowComponent::SnapToTarget()
+{
+	USceneComponent* UpdatedComponent = GetUpdatedComponent();
+	const USceneComponent* Target = FollowTarget.Get();
+	if (UpdatedComponent == nullptr || Target == nullptr)
+	{
+		return;
+	}
+
+	UpdatedComponent->SetWorldLocationAndRotation(
+		bFollowLocation ? Target->GetComponentLocation() : UpdatedComponent->GetComponentLocation(),
+		bFollowRotation ? Target->GetComponentQuat() : UpdatedComponent->GetComponentQuat());
+}
+
+USceneComponent* UNekoSmoothFollowComponent::GetUpdatedComponent() const
+{
+	const AActor* Owner = GetOwner();
+	return Owner ? Owner->GetRootComponent() : nullptr;
+}
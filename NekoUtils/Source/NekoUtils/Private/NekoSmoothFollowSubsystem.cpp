@@ -0,0 +1,262 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#include "NekoSmoothFollowSubsystem.h"
+
+#include "NekoDecay.h"
+#include "NekoSmoothFollowComponent.h"
+
+#include "Components/SceneComponent.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(NekoSmoothFollowSubsystem)
+
+
+namespace InternalNekoSmoothFollow
+{
+	// Most followers share the same decay constants, so the exponential only gets computed again when they change
+	struct FDecayFactorCache
+	{
+		float Decay = 0.0f;
+		double Factor = 1.0;
+
+		double Get(const float InDecay, const float DeltaTime)
+		{
+			if (InDecay != Decay)
+			{
+				Decay = InDecay;
+				Factor = NekoDecay::GetFactor(InDecay, DeltaTime);
+			}
+			return Factor;
+		}
+	};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// FNekoSmoothFollowTickFunction
+
+void FNekoSmoothFollowTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Subsystem != nullptr)
+	{
+		Subsystem->TickFollowers(TickGroup, DeltaTime);
+	}
+}
+
+FString FNekoSmoothFollowTickFunction::DiagnosticMessage()
+{
+	return FString::Printf(TEXT("UNekoSmoothFollowSubsystem[%s]"), *UEnum::GetValueAsString(TickGroup.GetValue()));
+}
+
+FName FNekoSmoothFollowTickFunction::DiagnosticContext(bool bDetailed)
+{
+	return FName(TEXT("NekoSmoothFollow"));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// UNekoSmoothFollowSubsystem
+
+void UNekoSmoothFollowSubsystem::Deinitialize()
+{
+	for (TUniquePtr<FFollowerGroup>& Group : Groups)
+	{
+		if (!Group.IsValid())
+		{
+			continue;
+		}
+
+		for (const TWeakObjectPtr<UNekoSmoothFollowComponent>& WeakFollower : Group->Followers)
+		{
+			if (UNekoSmoothFollowComponent* Follower = WeakFollower.Get())
+			{
+				Follower->FollowerIndex = INDEX_NONE;
+			}
+		}
+
+		Group->TickFunction.UnRegisterTickFunction();
+		Group.Reset();
+	}
+
+	Super::Deinitialize();
+}
+
+void UNekoSmoothFollowSubsystem::RegisterFollower(UNekoSmoothFollowComponent* Follower)
+{
+	if (Follower == nullptr || Follower->FollowerIndex != INDEX_NONE)
+	{
+		return;
+	}
+
+	TUniquePtr<FFollowerGroup>& Group = Groups[Follower->FollowTickGroup];
+	if (!Group.IsValid())
+	{
+		Group = MakeUnique<FFollowerGroup>();
+		Group->TickFunction.Subsystem = this;
+		Group->TickFunction.TickGroup = Follower->FollowTickGroup;
+		Group->TickFunction.EndTickGroup = Follower->FollowTickGroup;
+		Group->TickFunction.bCanEverTick = true;
+		Group->TickFunction.bStartWithTickEnabled = false;
+		Group->TickFunction.RegisterTickFunction(GetWorld()->PersistentLevel);
+	}
+
+	Follower->FollowerIndex = Group->Followers.Add(Follower);
+	Group->TickFunction.SetTickFunctionEnable(true);
+}
+
+void UNekoSmoothFollowSubsystem::UnregisterFollower(UNekoSmoothFollowComponent* Follower)
+{
+	if (Follower == nullptr || Follower->FollowerIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	FFollowerGroup* Group = Groups[Follower->FollowTickGroup].Get();
+	if (Group == nullptr || !Group->Followers.IsValidIndex(Follower->FollowerIndex))
+	{
+		Follower->FollowerIndex = INDEX_NONE;
+		return;
+	}
+
+	const int32 Index = Follower->FollowerIndex;
+	Follower->FollowerIndex = INDEX_NONE;
+
+	// Moving a follower can destroy another one, so the arrays can't be reordered in the middle of the tick
+	if (Group->bIsTicking)
+	{
+		Group->Followers[Index] = nullptr;
+		Group->bHasRemovedFollowers = true;
+		return;
+	}
+
+	Group->Followers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	if (Group->Followers.IsValidIndex(Index))
+	{
+		UpdateFollowerIndex(*Group, Index);
+	}
+
+	if (Group->Followers.IsEmpty())
+	{
+		Group->TickFunction.SetTickFunctionEnable(false);
+	}
+}
+
+void UNekoSmoothFollowSubsystem::TickFollowers(const ETickingGroup TickGroup, const float DeltaTime)
+{
+	FFollowerGroup* Group = Groups[TickGroup].Get();
+	if (Group == nullptr)
+	{
+		return;
+	}
+
+	// Followers registering during the tick are only updated starting from the next one
+	const int32 NumFollowers = Group->Followers.Num();
+	Group->bIsTicking = true;
+
+	Group->Locations.SetNumUninitialized(NumFollowers, EAllowShrinking::No);
+	Group->TargetLocations.SetNumUninitialized(NumFollowers, EAllowShrinking::No);
+	Group->LocationFactors.SetNumUninitialized(NumFollowers * 3, EAllowShrinking::No);
+	Group->Rotations.SetNumUninitialized(NumFollowers, EAllowShrinking::No);
+	Group->TargetRotations.SetNumUninitialized(NumFollowers, EAllowShrinking::No);
+	Group->RotationFactors.SetNumUninitialized(NumFollowers, EAllowShrinking::No);
+
+	InternalNekoSmoothFollow::FDecayFactorCache LocationFactorCache;
+	InternalNekoSmoothFollow::FDecayFactorCache RotationFactorCache;
+
+	for (int32 Index = 0; Index < NumFollowers; ++Index)
+	{
+		const UNekoSmoothFollowComponent* Follower = Group->Followers[Index].Get();
+		if (Follower == nullptr)
+		{
+			// Also catches followers destroyed without ending play, which never unregistered
+			Group->bHasRemovedFollowers = true;
+		}
+
+		const USceneComponent* UpdatedComponent = Follower ? Follower->GetUpdatedComponent() : nullptr;
+		const USceneComponent* Target = Follower ? Follower->FollowTarget.Get() : nullptr;
+		if (UpdatedComponent == nullptr || Target == nullptr)
+		{
+			// A factor of 1.0 keeps the current value, and skips writing it back
+			Group->Locations[Index] = Group->TargetLocations[Index] = FVector::ZeroVector;
+			Group->Rotations[Index] = Group->TargetRotations[Index] = FQuat::Identity;
+			SetLocationFactor(*Group, Index, 1.0);
+			Group->RotationFactors[Index] = 1.0;
+			continue;
+		}
+
+		Group->Locations[Index] = UpdatedComponent->GetComponentLocation();
+		Group->TargetLocations[Index] = Target->GetComponentLocation();
+		SetLocationFactor(*Group, Index, Follower->bFollowLocation ? LocationFactorCache.Get(Follower->LocationDecay, DeltaTime) : 1.0);
+		Group->Rotations[Index] = UpdatedComponent->GetComponentQuat();
+		Group->TargetRotations[Index] = Target->GetComponentQuat();
+		Group->RotationFactors[Index] = Follower->bFollowRotation ? RotationFactorCache.Get(Follower->RotationDecay, DeltaTime) : 1.0;
+	}
+
+	if (NumFollowers > 0)
+	{
+		double* Locations = &Group->Locations.GetData()->X;
+		NekoDecay::Apply(Locations, &Group->TargetLocations.GetData()->X, Group->LocationFactors.GetData(), Locations, NumFollowers * 3);
+	}
+
+	for (int32 Index = 0; Index < NumFollowers; ++Index)
+	{
+		Group->Rotations[Index] = FQuat::Slerp(Group->TargetRotations[Index], Group->Rotations[Index], Group->RotationFactors[Index]);
+	}
+
+	for (int32 Index = 0; Index < NumFollowers; ++Index)
+	{
+		const UNekoSmoothFollowComponent* Follower = Group->Followers[Index].Get();
+		if (Follower == nullptr || (Group->LocationFactors[Index * 3] == 1.0 && Group->RotationFactors[Index] == 1.0))
+		{
+			continue;
+		}
+
+		if (USceneComponent* UpdatedComponent = Follower->GetUpdatedComponent())
+		{
+			UpdatedComponent->SetWorldLocationAndRotation(Group->Locations[Index], Group->Rotations[Index]);
+		}
+	}
+
+	Group->bIsTicking = false;
+	if (Group->bHasRemovedFollowers)
+	{
+		RemoveUnregisteredFollowers(*Group);
+	}
+}
+
+void UNekoSmoothFollowSubsystem::SetLocationFactor(FFollowerGroup& Group, const int32 Index, const double Factor)
+{
+	double* Factors = &Group.LocationFactors[Index * 3];
+	Factors[0] = Factors[1] = Factors[2] = Factor;
+}
+
+void UNekoSmoothFollowSubsystem::UpdateFollowerIndex(FFollowerGroup& Group, const int32 Index)
+{
+	if (UNekoSmoothFollowComponent* Follower = Group.Followers[Index].Get())
+	{
+		Follower->FollowerIndex = Index;
+	}
+}
+
+void UNekoSmoothFollowSubsystem::RemoveUnregisteredFollowers(FFollowerGroup& Group)
+{
+	Group.bHasRemovedFollowers = false;
+
+	for (int32 Index = Group.Followers.Num() - 1; Index >= 0; --Index)
+	{
+		if (Group.Followers[Index].IsValid())
+		{
+			continue;
+		}
+
+		Group.Followers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		if (Group.Followers.IsValidIndex(Index))
+		{
+			UpdateFollowerIndex(Group, Index);
+		}
+	}
+
+	if (Group.Followers.IsEmpty())
+	{
+		Group.TickFunction.SetTickFunctionEnable(false);
+	}
+}
@@ -0,0 +1,162 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#include "NekoSpring.h"
+
+#include "Math/VectorRegister.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(NekoSpring)
+
+
+namespace InternalNekoSpring
+{
+	// Damping ratios this close to 1 are solved as critically damped, the other solutions being unstable around it
+	constexpr double CriticalDampingTolerance = 0.0001;
+
+	void UpdateBatch(double* Values, double* Velocities, const double* Targets, const int32 Num, const NekoSpring::FCoefficients& Coefficients)
+	{
+		const VectorRegister4Double PositionFromPosition = VectorSetFloat1(Coefficients.PositionFromPosition);
+		const VectorRegister4Double PositionFromVelocity = VectorSetFloat1(Coefficients.PositionFromVelocity);
+		const VectorRegister4Double VelocityFromPosition = VectorSetFloat1(Coefficients.VelocityFromPosition);
+		const VectorRegister4Double VelocityFromVelocity = VectorSetFloat1(Coefficients.VelocityFromVelocity);
+
+		int32 Index = 0;
+		for (; Index + 4 <= Num; Index += 4)
+		{
+			const VectorRegister4Double Target = VectorLoad(&Targets[Index]);
+			const VectorRegister4Double Offset = VectorSubtract(VectorLoad(&Values[Index]), Target);
+			const VectorRegister4Double Velocity = VectorLoad(&Velocities[Index]);
+
+			const VectorRegister4Double NewOffset = VectorMultiplyAdd(Offset, PositionFromPosition, VectorMultiply(Velocity, PositionFromVelocity));
+			const VectorRegister4Double NewVelocity = VectorMultiplyAdd(Offset, VelocityFromPosition, VectorMultiply(Velocity, VelocityFromVelocity));
+
+			VectorStore(VectorAdd(NewOffset, Target), &Values[Index]);
+			VectorStore(NewVelocity, &Velocities[Index]);
+		}
+
+		// Remainder that doesn't fill a whole register
+		for (; Index < Num; ++Index)
+		{
+			const double Offset = Values[Index] - Targets[Index];
+			const double Velocity = Velocities[Index];
+			Values[Index] = Targets[Index] + Offset * Coefficients.PositionFromPosition + Velocity * Coefficients.PositionFromVelocity;
+			Velocities[Index] = Offset * Coefficients.VelocityFromPosition + Velocity * Coefficients.VelocityFromVelocity;
+		}
+	}
+}
+
+NekoSpring::FCoefficients NekoSpring::FCoefficients::Compute(const float Frequency, const float DampingRatio, const float DeltaTime)
+{
+	FCoefficients Coefficients;
+
+	const double AngularFrequency = UE_DOUBLE_TWO_PI * FMath::Max(Frequency, 0.0f);
+	const double Damping = FMath::Max(DampingRatio, 0.0f);
+	const double Time = DeltaTime;
+
+	// No spring, the value stays where it is
+	if (AngularFrequency < UE_DOUBLE_SMALL_NUMBER)
+	{
+		return Coefficients;
+	}
+
+	if (Damping > 1.0 + InternalNekoSpring::CriticalDampingTolerance)
+	{
+		// Over-damped
+		const double Za = -AngularFrequency * Damping;
+		const double Zb = AngularFrequency * FMath::Sqrt(Damping * Damping - 1.0);
+		const double Z1 = Za - Zb;
+		const double Z2 = Za + Zb;
+
+		const double E1 = FMath::Exp(Z1 * Time);
+		const double E2 = FMath::Exp(Z2 * Time);
+		const double InvTwoZb = 1.0 / (2.0 * Zb);
+
+		const double E1OverTwoZb = E1 * InvTwoZb;
+		const double E2OverTwoZb = E2 * InvTwoZb;
+		const double Z1E1OverTwoZb = Z1 * E1OverTwoZb;
+		const double Z2E2OverTwoZb = Z2 * E2OverTwoZb;
+
+		Coefficients.PositionFromPosition = E1OverTwoZb * Z2 - Z2E2OverTwoZb + E2;
+		Coefficients.PositionFromVelocity = -E1OverTwoZb + E2OverTwoZb;
+		Coefficients.VelocityFromPosition = (Z1E1OverTwoZb - Z2E2OverTwoZb + E2) * Z2;
+		Coefficients.VelocityFromVelocity = -Z1E1OverTwoZb + Z2E2OverTwoZb;
+	}
+	else if (Damping < 1.0 - InternalNekoSpring::CriticalDampingTolerance)
+	{
+		// Under-damped
+		const double OmegaZeta = AngularFrequency * Damping;
+		const double Alpha = AngularFrequency * FMath::Sqrt(1.0 - Damping * Damping);
+
+		const double ExpTerm = FMath::Exp(-OmegaZeta * Time);
+		double SinTerm;
+		double CosTerm;
+		FMath::SinCos(&SinTerm, &CosTerm, Alpha * Time);
+
+		const double ExpSin = ExpTerm * SinTerm;
+		const double ExpCos = ExpTerm * CosTerm;
+		const double ExpOmegaZetaSinOverAlpha = ExpTerm * OmegaZeta * SinTerm / Alpha;
+
+		Coefficients.PositionFromPosition = ExpCos + ExpOmegaZetaSinOverAlpha;
+		Coefficients.PositionFromVelocity = ExpSin / Alpha;
+		Coefficients.VelocityFromPosition = -ExpSin * Alpha - OmegaZeta * ExpOmegaZetaSinOverAlpha;
+		Coefficients.VelocityFromVelocity = ExpCos - ExpOmegaZetaSinOverAlpha;
+	}
+	else
+	{
+		// Critically damped
+		const double ExpTerm = FMath::Exp(-AngularFrequency * Time);
+		const double TimeExp = Time * ExpTerm;
+		const double TimeExpFrequency = TimeExp * AngularFrequency;
+
+		Coefficients.PositionFromPosition = TimeExpFrequency + ExpTerm;
+		Coefficients.PositionFromVelocity = TimeExp;
+		Coefficients.VelocityFromPosition = -AngularFrequency * TimeExpFrequency;
+		Coefficients.VelocityFromVelocity = -TimeExpFrequency + ExpTerm;
+	}
+
+	return Coefficients;
+}
+
+void NekoSpring::Update(FNekoSpringFloat& Spring, const double Target, const FCoefficients& Coefficients)
+{
+	InternalNekoSpring::UpdateBatch(&Spring.Value, &Spring.Velocity, &Target, 1, Coefficients);
+}
+
+void NekoSpring::Update(FNekoSpringVector& Spring, const FVector& Target, const FCoefficients& Coefficients)
+{
+	InternalNekoSpring::UpdateBatch(&Spring.Value.X, &Spring.Velocity.X, &Target.X, 3, Coefficients);
+}
+
+void NekoSpring::Update(FNekoSpringQuat& Spring, const FQuat& Target, const FCoefficients& Coefficients)
+{
+	// Springs the rotation vector from the target, which is zero at the target
+	FQuat Offset = Spring.Value * Target.Inverse();
+	if (Offset.W < 0.0)
+	{
+		Offset = -Offset;
+	}
+
+	FVector RotationVector = Offset.ToRotationVector();
+	const FVector Velocity = Spring.AngularVelocity;
+
+	Spring.AngularVelocity = RotationVector * Coefficients.VelocityFromPosition + Velocity * Coefficients.VelocityFromVelocity;
+	RotationVector = RotationVector * Coefficients.PositionFromPosition + Velocity * Coefficients.PositionFromVelocity;
+	Spring.Value = (FQuat::MakeFromRotationVector(RotationVector) * Target).GetNormalized();
+}
+
+void NekoSpring::UpdateBatch(TArrayView<double> Values, TArrayView<double> Velocities, TConstArrayView<double> Targets, const FCoefficients& Coefficients)
+{
+	check(Values.Num() == Velocities.Num() && Values.Num() == Targets.Num());
+	InternalNekoSpring::UpdateBatch(Values.GetData(), Velocities.GetData(), Targets.GetData(), Values.Num(), Coefficients);
+}
+
+void NekoSpring::UpdateBatch(TArrayView<FVector> Values, TArrayView<FVector> Velocities, TConstArrayView<FVector> Targets, const FCoefficients& Coefficients)
+{
+	check(Values.Num() == Velocities.Num() && Values.Num() == Targets.Num());
+	if (Values.IsEmpty())
+	{
+		return;
+	}
+
+	// Vectors are processed as a flat array of doubles, see NekoDecay.cpp
+	InternalNekoSpring::UpdateBatch(&Values.GetData()->X, &Velocities.GetData()->X, &Targets.GetData()->X, Values.Num() * 3, Coefficients);
+}
@@ -0,0 +1,7 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#pragma once
+
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("NekoUtils"), STATGROUP_NekoUtils, STATCAT_Advanced);
@@ -0,0 +1,248 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#include "NekoTagBitset.h"
+
+#include "NekoGameplayTagIndex.h"
+#include "NekoLogCategories.h"
+
+#include "Math/VectorRegister.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(NekoTagBitset)
+
+
+namespace InternalNekoTagBitset
+{
+	constexpr int32 BitsPerWord = 64;
+
+	void LogStaleBitset()
+	{
+		// Every bitset goes stale at once when the tag tree changes, so only the first one is worth reporting
+		static bool bHasLogged = false;
+		if (!bHasLogged)
+		{
+			bHasLogged = true;
+			UE_LOG(LogNekoUtils, Warning, TEXT("Used a gameplay tag bitset built before the gameplay tag tree changed, it doesn't match anything until it is built again"));
+		}
+	}
+
+	// Number of words processed per vector register
+	constexpr int32 WordsPerRegister = sizeof(VectorRegister4Int) / sizeof(uint64);
+
+	bool IsRegisterZero(const VectorRegister4Int& Register)
+	{
+		return VectorMaskBits(VectorCastIntToFloat(VectorIntCompareEQ(Register, GlobalVectorConstants::IntZero))) == 0xF;
+	}
+
+	// Whether A and B have at least one bit in common over their first Num words
+	bool HasCommonBits(const uint64* A, const uint64* B, const int32 Num)
+	{
+		VectorRegister4Int Accumulator = GlobalVectorConstants::IntZero;
+
+		int32 Index = 0;
+		for (; Index + WordsPerRegister <= Num; Index += WordsPerRegister)
+		{
+			Accumulator = VectorIntOr(Accumulator, VectorIntAnd(VectorIntLoad(&A[Index]), VectorIntLoad(&B[Index])));
+		}
+
+		uint64 Remainder = 0;
+		for (; Index < Num; ++Index)
+		{
+			Remainder |= A[Index] & B[Index];
+		}
+
+		return Remainder != 0 || !IsRegisterZero(Accumulator);
+	}
+
+	// Whether every bit of Subset is also set in Set, over their first Num words
+	bool HasAllBits(const uint64* Set, const uint64* Subset, const int32 Num)
+	{
+		VectorRegister4Int Accumulator = GlobalVectorConstants::IntZero;
+
+		int32 Index = 0;
+		for (; Index + WordsPerRegister <= Num; Index += WordsPerRegister)
+		{
+			// Bits of the subset that are missing from the set
+			Accumulator = VectorIntOr(Accumulator, VectorIntAndNot(VectorIntLoad(&Set[Index]), VectorIntLoad(&Subset[Index])));
+		}
+
+		uint64 Remainder = 0;
+		for (; Index < Num; ++Index)
+		{
+			Remainder |= Subset[Index] & ~Set[Index];
+		}
+
+		return Remainder == 0 && IsRegisterZero(Accumulator);
+	}
+
+	template <typename WordsType>
+	void SetBit(WordsType& Words, const int32 Bit)
+	{
+		const int32 WordIndex = Bit / BitsPerWord;
+		if (WordIndex >= Words.Num())
+		{
+			Words.AddZeroed(WordIndex + 1 - Words.Num());
+		}
+		Words[WordIndex] |= uint64(1) << (Bit % BitsPerWord);
+	}
+
+	template <typename WordsType>
+	bool TestBit(const WordsType& Words, const int32 Bit)
+	{
+		const int32 WordIndex = Bit / BitsPerWord;
+		return Words.IsValidIndex(WordIndex) && (Words[WordIndex] & (uint64(1) << (Bit % BitsPerWord))) != 0;
+	}
+
+	template <typename WordsType>
+	bool HasAny(const WordsType& Words, const WordsType& OtherWords)
+	{
+		return HasCommonBits(Words.GetData(), OtherWords.GetData(), FMath::Min(Words.Num(), OtherWords.Num()));
+	}
+
+	template <typename WordsType>
+	bool HasAll(const WordsType& Words, const WordsType& OtherWords)
+	{
+		// The words of Other past the end of this one must all be empty
+		for (int32 Index = Words.Num(); Index < OtherWords.Num(); ++Index)
+		{
+			if (OtherWords[Index] != 0)
+			{
+				return false;
+			}
+		}
+
+		return HasAllBits(Words.GetData(), OtherWords.GetData(), FMath::Min(Words.Num(), OtherWords.Num()));
+	}
+}
+
+FNekoTagBitset::FNekoTagBitset(const FGameplayTagContainer& Container)
+{
+	for (const FGameplayTag& Tag : Container)
+	{
+		AddTag(Tag);
+	}
+}
+
+void FNekoTagBitset::AddTag(const FGameplayTag& Tag)
+{
+	const FNekoGameplayTagIndex& TagIndex = FNekoGameplayTagIndex::Get();
+	if (!IsEmpty() && Version != TagIndex.GetVersion())
+	{
+		// The previous bits can't be mapped to the new tree, so the bitset starts over from this tag
+		InternalNekoTagBitset::LogStaleBitset();
+		Reset();
+	}
+
+	if (IsEmpty())
+	{
+		Version = TagIndex.GetVersion();
+	}
+
+	const int32 Index = TagIndex.FindIndex(Tag);
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	InternalNekoTagBitset::SetBit(ExplicitWords, Index);
+	for (int32 ParentIndex = Index; ParentIndex != INDEX_NONE; ParentIndex = TagIndex.GetParentIndex(ParentIndex))
+	{
+		InternalNekoTagBitset::SetBit(ExpandedWords, ParentIndex);
+	}
+}
+
+void FNekoTagBitset::Reset()
+{
+	ExplicitWords.Reset();
+	ExpandedWords.Reset();
+}
+
+bool FNekoTagBitset::HasTag(const FGameplayTag& Tag) const
+{
+	if (!IsUpToDate())
+	{
+		InternalNekoTagBitset::LogStaleBitset();
+		return false;
+	}
+
+	const int32 Index = FNekoGameplayTagIndex::Get().FindIndex(Tag);
+	return Index != INDEX_NONE && InternalNekoTagBitset::TestBit(ExpandedWords, Index);
+}
+
+bool FNekoTagBitset::HasTagExact(const FGameplayTag& Tag) const
+{
+	if (!IsUpToDate())
+	{
+		InternalNekoTagBitset::LogStaleBitset();
+		return false;
+	}
+
+	const int32 Index = FNekoGameplayTagIndex::Get().FindIndex(Tag);
+	return Index != INDEX_NONE && InternalNekoTagBitset::TestBit(ExplicitWords, Index);
+}
+
+bool FNekoTagBitset::HasAny(const FNekoTagBitset& Other) const
+{
+	return IsCompatibleWith(Other) && InternalNekoTagBitset::HasAny(ExpandedWords, Other.ExplicitWords);
+}
+
+bool FNekoTagBitset::HasAll(const FNekoTagBitset& Other) const
+{
+	return IsCompatibleWith(Other) && InternalNekoTagBitset::HasAll(ExpandedWords, Other.ExplicitWords);
+}
+
+bool FNekoTagBitset::HasAnyExact(const FNekoTagBitset& Other) const
+{
+	return IsCompatibleWith(Other) && InternalNekoTagBitset::HasAny(ExplicitWords, Other.ExplicitWords);
+}
+
+bool FNekoTagBitset::HasAllExact(const FNekoTagBitset& Other) const
+{
+	return IsCompatibleWith(Other) && InternalNekoTagBitset::HasAll(ExplicitWords, Other.ExplicitWords);
+}
+
+bool FNekoTagBitset::operator==(const FNekoTagBitset& Other) const
+{
+	return IsCompatibleWith(Other) && InternalNekoTagBitset::HasAll(ExplicitWords, Other.ExplicitWords)
+		&& InternalNekoTagBitset::HasAll(Other.ExplicitWords, ExplicitWords);
+}
+
+bool FNekoTagBitset::IsUpToDate() const
+{
+	return IsEmpty() || Version == FNekoGameplayTagIndex::Get().GetVersion();
+}
+
+bool FNekoTagBitset::IsCompatibleWith(const FNekoTagBitset& Other) const
+{
+	// Two bitsets of the same outdated version still refer to the same tags, so they can be compared with each other
+	if (IsEmpty() || Other.IsEmpty() || Version == Other.Version)
+	{
+		return true;
+	}
+
+	InternalNekoTagBitset::LogStaleBitset();
+	return false;
+}
+
+FGameplayTagContainer FNekoTagBitset::ToContainer() const
+{
+	const FNekoGameplayTagIndex& TagIndex = FNekoGameplayTagIndex::Get();
+
+	FGameplayTagContainer Container;
+	if (!IsUpToDate())
+	{
+		return Container;
+	}
+
+	for (int32 WordIndex = 0; WordIndex < ExplicitWords.Num(); ++WordIndex)
+	{
+		uint64 Word = ExplicitWords[WordIndex];
+		while (Word != 0)
+		{
+			const int32 Bit = static_cast<int32>(FMath::CountTrailingZeros64(Word));
+			Container.AddTagFast(TagIndex.GetTag(WordIndex * InternalNekoTagBitset::BitsPerWord + Bit));
+			Word &= Word - 1;
+		}
+	}
+
+	return Container;
+}
@@ -0,0 +1,197 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#include "NekoTagSampler.h"
+
+#include "NekoLogCategories.h"
+
+#include "UObject/Package.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(NekoTagSampler)
+
+
+UNekoTagSampler* UNekoTagSampler::CreateTagSampler(const FGameplayTagContainer& GameplayTagContainer,
+	const TArray<float>& Weights, const ENekoTagSamplerMode Mode, const int32 Seed)
+{
+	UNekoTagSampler* Sampler = NewObject<UNekoTagSampler>(GetTransientPackage());
+	Sampler->RandomStream.Initialize(Seed);
+	Sampler->Initialize(GameplayTagContainer, Weights, Mode);
+	return Sampler;
+}
+
+void UNekoTagSampler::Initialize(const FGameplayTagContainer& GameplayTagContainer, TConstArrayView<float> Weights,
+	const ENekoTagSamplerMode InMode)
+{
+	Mode = InMode;
+	GameplayTagContainer.GetGameplayTagArray(Tags);
+
+	if (Weights.Num() > Tags.Num())
+	{
+		UE_LOG(LogNekoUtils, Warning, TEXT("Tag sampler got %d weights for %d tags, the extra weights are ignored"), Weights.Num(), Tags.Num());
+	}
+
+	Probabilities.Reset();
+	Aliases.Reset();
+	Bag.Reset();
+	BagCursor = 0;
+
+	if (Mode == ENekoTagSamplerMode::Weighted)
+	{
+		BuildAliasTable(Weights);
+	}
+	else
+	{
+		RefillBag();
+	}
+}
+
+FGameplayTag UNekoTagSampler::DrawTag()
+{
+	const int32 Index = DrawIndex();
+	return Index != INDEX_NONE ? Tags[Index] : FGameplayTag::EmptyTag;
+}
+
+TArray<FGameplayTag> UNekoTagSampler::DrawTags(const int32 Count)
+{
+	TArray<FGameplayTag> DrawnTags;
+	if (Tags.IsEmpty() || Count <= 0)
+	{
+		return DrawnTags;
+	}
+
+	DrawnTags.Reserve(Count);
+	for (int32 Draw = 0; Draw < Count; ++Draw)
+	{
+		DrawnTags.Add(Tags[DrawIndex()]);
+	}
+	return DrawnTags;
+}
+
+void UNekoTagSampler::SetSeed(const int32 Seed)
+{
+	RandomStream.Initialize(Seed);
+
+	if (Mode == ENekoTagSamplerMode::ShuffleBag)
+	{
+		Bag.Reset();
+		BagCursor = 0;
+		RefillBag();
+	}
+}
+
+int32 UNekoTagSampler::DrawIndex()
+{
+	const int32 NumTags = Tags.Num();
+	if (NumTags == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	if (Mode == ENekoTagSamplerMode::ShuffleBag)
+	{
+		if (BagCursor >= Bag.Num())
+		{
+			RefillBag();
+		}
+		return Bag[BagCursor++];
+	}
+
+	// Picks a column of the alias table, then either keeps it or takes its alias
+	const int32 Column = RandomStream.RandHelper(NumTags);
+	return RandomStream.GetFraction() < Probabilities[Column] ? Column : Aliases[Column];
+}
+
+void UNekoTagSampler::BuildAliasTable(TConstArrayView<float> Weights)
+{
+	const int32 NumTags = Tags.Num();
+	Probabilities.SetNumUninitialized(NumTags);
+	Aliases.SetNumUninitialized(NumTags);
+
+	double TotalWeight = 0.0;
+	for (int32 Index = 0; Index < NumTags; ++Index)
+	{
+		const float Weight = Weights.IsValidIndex(Index) ? FMath::Max(Weights[Index], 0.0f) : 1.0f;
+		Probabilities[Index] = Weight;
+		TotalWeight += Weight;
+	}
+
+	if (TotalWeight <= 0.0)
+	{
+		UE_LOG(LogNekoUtils, Warning, TEXT("Tag sampler got weights that are all zero, every tag will be drawn with the same probability"));
+		for (float& Probability : Probabilities)
+		{
+			Probability = 1.0f;
+		}
+		TotalWeight = NumTags;
+	}
+
+	// Scales the weights so that their average is 1, then splits them between the columns that are under and over it
+	TArray<int32> Small;
+	TArray<int32> Large;
+	Small.Reserve(NumTags);
+	Large.Reserve(NumTags);
+	for (int32 Index = 0; Index < NumTags; ++Index)
+	{
+		Probabilities[Index] = static_cast<float>(Probabilities[Index] * NumTags / TotalWeight);
+		Aliases[Index] = Index;
+		(Probabilities[Index] < 1.0f ? Small : Large).Add(Index);
+	}
+
+	// Every small column is topped up by a large one, which becomes its alias
+	while (!Small.IsEmpty() && !Large.IsEmpty())
+	{
+		const int32 SmallIndex = Small.Pop(EAllowShrinking::No);
+		const int32 LargeIndex = Large.Last();
+
+		Aliases[SmallIndex] = LargeIndex;
+		Probabilities[LargeIndex] = (Probabilities[LargeIndex] + Probabilities[SmallIndex]) - 1.0f;
+
+		if (Probabilities[LargeIndex] < 1.0f)
+		{
+			Large.Pop(EAllowShrinking::No);
+			Small.Add(LargeIndex);
+		}
+	}
+
+	// What's left is only off from 1 because of floating point errors
+	for (const int32 Index : Small)
+	{
+		Probabilities[Index] = 1.0f;
+	}
+	for (const int32 Index : Large)
+	{
+		Probabilities[Index] = 1.0f;
+	}
+}
+
+void UNekoTagSampler::RefillBag()
+{
+	const int32 NumTags = Tags.Num();
+	if (NumTags == 0)
+	{
+		return;
+	}
+
+	const int32 LastDrawn = Bag.IsValidIndex(BagCursor - 1) ? Bag[BagCursor - 1] : INDEX_NONE;
+
+	if (Bag.Num() != NumTags)
+	{
+		Bag.SetNumUninitialized(NumTags);
+		for (int32 Index = 0; Index < NumTags; ++Index)
+		{
+			Bag[Index] = Index;
+		}
+	}
+
+	// Fisher-Yates shuffle
+	for (int32 Index = NumTags - 1; Index > 0; --Index)
+	{
+		Bag.Swap(Index, RandomStream.RandHelper(Index + 1));
+	}
+
+	if (NumTags > 1 && Bag[0] == LastDrawn)
+	{
+		Bag.Swap(0, 1 + RandomStream.RandHelper(NumTags - 1));
+	}
+
+	BagCursor = 0;
+}
@@ -0,0 +1,971 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#include "NekoTimelineSubsystem.h"
+
+#include "NekoBakedCurve.h"
+#include "NekoLogCategories.h"
+#include "NekoStats.h"
+
+#include "Blueprint/UserWidget.h"
+#include "Components/ActorComponent.h"
+#include "Components/Widget.h"
+#include "Curves/CurveFloat.h"
+#include "Curves/CurveLinearColor.h"
+#include "Curves/CurveVector.h"
+#include "GameFramework/Actor.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Misc/App.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(NekoTimelineSubsystem)
+
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Live Pseudo Timelines"), STAT_NekoLiveTimelines, STATGROUP_NekoUtils);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pseudo Timeline Pool Misses"), STAT_NekoTimelinePoolMisses, STATGROUP_NekoUtils);
+
+namespace InternalNekoTimeline
+{
+	// Alpha of the last Update of a pseudo-timeline that didn't execute any Update yet
+	constexpr float NoUpdatedAlpha = std::numeric_limits<float>::quiet_NaN();
+}
+
+void UNekoTimelineSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	ReserveTimelines(InitialCapacity);
+
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &UNekoTimelineSubsystem::HandlePostGarbageCollect);
+}
+
+void UNekoTimelineSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+
+	DEC_DWORD_STAT_BY(STAT_NekoLiveTimelines, ElapsedTimes.Num());
+
+	ElapsedTimes.Empty();
+	TotalTimes.Empty();
+	Progresses.Empty();
+	Alphas.Empty();
+	Curves.Empty();
+	BakedCurves.Empty();
+	States.Empty();
+	TimeDomains.Empty();
+	DilationActors.Empty();
+	RemainingCycles.Empty();
+	PlaysBackwards.Empty();
+	TimesSinceUpdate.Empty();
+	UpdateIntervals.Empty();
+	UpdatedAlphas.Empty();
+	MinAlphaDeltas.Empty();
+	OutputPinSlots.Empty();
+	ProgressSlots.Empty();
+	AlphaSlots.Empty();
+	BindingIndices.Empty();
+	Bindings.Empty();
+	TypedOutputIndices.Empty();
+	TypedOutputs.Empty();
+	CallbackTargets.Empty();
+	ExecutionFunctions.Empty();
+	Linkages.Empty();
+	TimelineKeys.Empty();
+	Playbacks.Empty();
+	TimelineIndices.Empty();
+
+	Super::Deinitialize();
+}
+
+void UNekoTimelineSubsystem::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	Super::AddReferencedObjects(InThis, Collector);
+
+	// The curves are sampled, and their lookup tables used, until the pseudo-timelines finish
+	UNekoTimelineSubsystem* This = CastChecked<UNekoTimelineSubsystem>(InThis);
+	Collector.AddReferencedObjects(This->Curves, This);
+	for (FNekoTimelineTypedOutput& TypedOutput : This->TypedOutputs)
+	{
+		Collector.AddReferencedObject(TypedOutput.Curve, This);
+	}
+}
+
+void UNekoTimelineSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Timelines started from an output pin during this tick will only be advanced on the next one
+	const int32 NumTimelines = ElapsedTimes.Num();
+
+	// Ticked while paused for the widgets, which run on the undilated application time like their own latent actions
+	const bool bWorldPaused = GetWorld()->IsPaused();
+	const float WidgetDeltaTime = static_cast<float>(FApp::GetDeltaTime());
+
+	for (int32 Index = 0; Index < NumTimelines; ++Index)
+	{
+		float TimelineDeltaTime = WidgetDeltaTime;
+		if (TimeDomains[Index] != ETimeDomain::Widget)
+		{
+			if (bWorldPaused)
+			{
+				continue;
+			}
+
+			const AActor* DilationActor = DilationActors[Index].Get();
+			TimelineDeltaTime = DilationActor ? DeltaTime * DilationActor->CustomTimeDilation : DeltaTime;
+		}
+
+		ElapsedTimes[Index] += TimelineDeltaTime;
+		TimesSinceUpdate[Index] += TimelineDeltaTime;
+		if (ElapsedTimes[Index] >= TotalTimes[Index])
+		{
+			WrapTimeline(Index);
+		}
+
+		const float Position = FMath::Clamp(ElapsedTimes[Index] / TotalTimes[Index], 0.0f, 1.0f);
+		Progresses[Index] = PlaysBackwards[Index] ? 1.0f - Position : Position;
+	}
+
+	for (int32 Index = 0; Index < NumTimelines; ++Index)
+	{
+		Alphas[Index] = SampleAlpha(Index);
+	}
+
+	for (int32 Index = 0; Index < NumTimelines; ++Index)
+	{
+		if (States[Index] == ETimelineState::Removed)
+		{
+			continue;
+		}
+
+		// Frozen, without firing any pin, until the world is unpaused
+		if (bWorldPaused && TimeDomains[Index] != ETimeDomain::Widget)
+		{
+			continue;
+		}
+
+		// The output slots live in the callback target's memory, so they can't be touched once it's gone
+		if (!CallbackTargets[Index].IsValid())
+		{
+			TimelineIndices.Remove(TimelineKeys[Index]);
+			States[Index] = ETimelineState::Removed;
+			continue;
+		}
+
+		// The exit and "Finished" pin get called on the next tick, so that the last "Update" pin execution receives the value of 1.0
+		if (States[Index] == ETimelineState::Exiting)
+		{
+			// Removed before firing the pin, so that the node can be started again from its Finished pin
+			TimelineIndices.Remove(TimelineKeys[Index]);
+			States[Index] = ETimelineState::Removed;
+			FireOutputPin(Index, EPseudoTimelineOutputPins::Finished);
+			continue;
+		}
+
+		if (ShouldSkipUpdate(Index))
+		{
+			continue;
+		}
+
+		TimesSinceUpdate[Index] = 0.0f;
+		UpdatedAlphas[Index] = Alphas[Index];
+
+		if (BindingIndices[Index] != INDEX_NONE)
+		{
+			Bindings[BindingIndices[Index]].Apply(Alphas[Index]);
+
+			// Nothing to wait for since there is no Update pin, so the Finished pin can be fired right away
+			if (States[Index] == ETimelineState::Completing)
+			{
+				TimelineIndices.Remove(TimelineKeys[Index]);
+				States[Index] = ETimelineState::Removed;
+				FireOutputPin(Index, EPseudoTimelineOutputPins::Finished);
+			}
+			continue;
+		}
+
+		*ProgressSlots[Index] = Progresses[Index];
+		if (TypedOutputIndices[Index] != INDEX_NONE)
+		{
+			TypedOutputs[TypedOutputIndices[Index]].Write(Progresses[Index], Alphas[Index]);
+		}
+		else
+		{
+			*AlphaSlots[Index] = Alphas[Index];
+		}
+
+		if (States[Index] == ETimelineState::Completing)
+		{
+			States[Index] = ETimelineState::Exiting;
+		}
+
+		FireOutputPin(Index, EPseudoTimelineOutputPins::Update);
+	}
+
+	RemoveFinishedTimelines();
+}
+
+bool UNekoTimelineSubsystem::StartTimeline(const FLatentActionInfo& LatentInfo, const float Time, const UCurveFloat* Curve,
+	const FNekoPseudoTimelineOptions& Options, EPseudoTimelineOutputPins& OutputPins, float& OutProgress, float& OutAlpha,
+	const bool bRetrigger)
+{
+	const FTimelineKey Key(FObjectKey(LatentInfo.CallbackTarget), LatentInfo.UUID);
+	if (const int32* ExistingIndex = TimelineIndices.Find(Key))
+	{
+		if (bRetrigger)
+		{
+			RetriggerTimeline(*ExistingIndex);
+		}
+		return bRetrigger;
+	}
+
+	if (LatentInfo.CallbackTarget == nullptr)
+	{
+		return false;
+	}
+
+	const int32 Index = AddTimeline(Key, LatentInfo, Time, Curve, Options);
+	OutputPinSlots[Index] = &OutputPins;
+	ProgressSlots[Index] = &OutProgress;
+	AlphaSlots[Index] = &OutAlpha;
+
+	OutputPins = EPseudoTimelineOutputPins::Update;
+	OutProgress = Progresses[Index];
+	OutAlpha = Alphas[Index];
+	return true;
+}
+
+bool UNekoTimelineSubsystem::StartTypedTimeline(const FLatentActionInfo& LatentInfo, const float Time,
+	const UCurveFloat* Curve, const FNekoPseudoTimelineOptions& Options, const FNekoTimelineTypedOutput& Output,
+	EPseudoTimelineOutputPins& OutputPins, float& OutProgress, const bool bRetrigger)
+{
+	const FTimelineKey Key(FObjectKey(LatentInfo.CallbackTarget), LatentInfo.UUID);
+	if (const int32* ExistingIndex = TimelineIndices.Find(Key))
+	{
+		if (bRetrigger)
+		{
+			RetriggerTimeline(*ExistingIndex);
+		}
+		return bRetrigger;
+	}
+
+	if (LatentInfo.CallbackTarget == nullptr || Output.Value == nullptr)
+	{
+		return false;
+	}
+
+	const int32 Index = AddTimeline(Key, LatentInfo, Time, Curve, Options);
+	OutputPinSlots[Index] = &OutputPins;
+	ProgressSlots[Index] = &OutProgress;
+
+	FNekoTimelineTypedOutput TypedOutput = Output;
+	if (Options.bBakeCurve)
+	{
+		TypedOutput.BakedCurve = FNekoBakedCurveCache::Get().FindOrBake(TypedOutput.Curve);
+	}
+	TypedOutput.Write(Progresses[Index], Alphas[Index]);
+	TypedOutputIndices[Index] = TypedOutputs.Add(MoveTemp(TypedOutput));
+
+	OutputPins = EPseudoTimelineOutputPins::Update;
+	OutProgress = Progresses[Index];
+	return true;
+}
+
+bool UNekoTimelineSubsystem::StartTargetTimeline(const FLatentActionInfo& LatentInfo, const float Time,
+	const UCurveFloat* Curve, const FNekoPseudoTimelineOptions& Options, const FNekoTimelineTarget& Target,
+	const bool bRetrigger)
+{
+	const FTimelineKey Key(FObjectKey(LatentInfo.CallbackTarget), LatentInfo.UUID);
+	if (const int32* ExistingIndex = TimelineIndices.Find(Key))
+	{
+		if (bRetrigger)
+		{
+			RetriggerTimeline(*ExistingIndex);
+		}
+		return bRetrigger;
+	}
+
+	FTimelineBinding Binding;
+	if (LatentInfo.CallbackTarget == nullptr || !ResolveBinding(Target, Binding))
+	{
+		return false;
+	}
+
+	const int32 Index = AddTimeline(Key, LatentInfo, Time, Curve, Options);
+
+	// Applied right away, so that the target doesn't keep its previous value until the next tick
+	Binding.Apply(Alphas[Index]);
+	BindingIndices[Index] = Bindings.Add(MoveTemp(Binding));
+	return true;
+}
+
+FNekoTimelinePoolStats UNekoTimelineSubsystem::GetPoolStats() const
+{
+	FNekoTimelinePoolStats Stats;
+	Stats.Live = ElapsedTimes.Num();
+	Stats.Peak = PeakTimelines;
+	Stats.Capacity = ElapsedTimes.Max();
+	Stats.PoolMisses = PoolMisses;
+	return Stats;
+}
+
+void UNekoTimelineSubsystem::ReserveTimelines(const int32 Capacity)
+{
+	if (Capacity <= ElapsedTimes.Max())
+	{
+		return;
+	}
+
+	ElapsedTimes.Reserve(Capacity);
+	TotalTimes.Reserve(Capacity);
+	Progresses.Reserve(Capacity);
+	Alphas.Reserve(Capacity);
+	Curves.Reserve(Capacity);
+	BakedCurves.Reserve(Capacity);
+	States.Reserve(Capacity);
+	TimeDomains.Reserve(Capacity);
+	DilationActors.Reserve(Capacity);
+	RemainingCycles.Reserve(Capacity);
+	PlaysBackwards.Reserve(Capacity);
+	TimesSinceUpdate.Reserve(Capacity);
+	UpdateIntervals.Reserve(Capacity);
+	UpdatedAlphas.Reserve(Capacity);
+	MinAlphaDeltas.Reserve(Capacity);
+	OutputPinSlots.Reserve(Capacity);
+	ProgressSlots.Reserve(Capacity);
+	AlphaSlots.Reserve(Capacity);
+	BindingIndices.Reserve(Capacity);
+	Bindings.Reserve(Capacity);
+	TypedOutputIndices.Reserve(Capacity);
+	TypedOutputs.Reserve(Capacity);
+	CallbackTargets.Reserve(Capacity);
+	ExecutionFunctions.Reserve(Capacity);
+	Linkages.Reserve(Capacity);
+	TimelineKeys.Reserve(Capacity);
+	Playbacks.Reserve(Capacity);
+	TimelineIndices.Reserve(Capacity);
+}
+
+bool UNekoTimelineSubsystem::IsTimelineRunning(const UObject* CallbackTarget, const int32 UUID) const
+{
+	return TimelineIndices.Contains(FTimelineKey(FObjectKey(CallbackTarget), UUID));
+}
+
+void UNekoTimelineSubsystem::RetriggerTimeline(const int32 Index)
+{
+	ResetPlayback(Index);
+}
+
+void UNekoTimelineSubsystem::ResetPlayback(const int32 Index)
+{
+	const FTimelinePlayback& Playback = Playbacks[Index];
+
+	States[Index] = ETimelineState::Running;
+	ElapsedTimes[Index] = Playback.StartPosition * TotalTimes[Index];
+	PlaysBackwards[Index] = Playback.bReverse;
+	RemainingCycles[Index] = Playback.PlayMode == ENekoPseudoTimelinePlayMode::Once ? 0
+		: Playback.LoopCount > 0 ? Playback.LoopCount - 1
+		: INDEX_NONE;
+
+	const float Position = FMath::Clamp(Playback.StartPosition, 0.0f, 1.0f);
+	Progresses[Index] = Playback.bReverse ? 1.0f - Position : Position;
+	Alphas[Index] = SampleAlpha(Index);
+
+	// Lets the first Update go through right away, whatever its alpha is
+	TimesSinceUpdate[Index] = UpdateIntervals[Index];
+	UpdatedAlphas[Index] = InternalNekoTimeline::NoUpdatedAlpha;
+}
+
+void UNekoTimelineSubsystem::WrapTimeline(const int32 Index)
+{
+	if (States[Index] != ETimelineState::Running)
+	{
+		ElapsedTimes[Index] = TotalTimes[Index];
+		return;
+	}
+
+	// Several cycles can end during the same tick if they are shorter than a frame
+	const int32 NumEndedCycles = FMath::FloorToInt32(ElapsedTimes[Index] / TotalTimes[Index]);
+	if (RemainingCycles[Index] != INDEX_NONE && NumEndedCycles > RemainingCycles[Index])
+	{
+		// Stays at the end of the last cycle, so that the last Update receives its final value
+		if (Playbacks[Index].PlayMode == ENekoPseudoTimelinePlayMode::PingPong && RemainingCycles[Index] % 2 == 1)
+		{
+			PlaysBackwards[Index] = !PlaysBackwards[Index];
+		}
+
+		RemainingCycles[Index] = 0;
+		ElapsedTimes[Index] = TotalTimes[Index];
+		States[Index] = ETimelineState::Completing;
+		return;
+	}
+
+	if (RemainingCycles[Index] != INDEX_NONE)
+	{
+		RemainingCycles[Index] -= NumEndedCycles;
+	}
+
+	if (Playbacks[Index].PlayMode == ENekoPseudoTimelinePlayMode::PingPong && NumEndedCycles % 2 == 1)
+	{
+		PlaysBackwards[Index] = !PlaysBackwards[Index];
+	}
+
+	// Keeps the time past the end of the cycle, so that no time is lost between two of them
+	ElapsedTimes[Index] -= NumEndedCycles * TotalTimes[Index];
+}
+
+float UNekoTimelineSubsystem::SampleAlpha(const int32 Index) const
+{
+	if (const FNekoBakedCurve* BakedCurve = BakedCurves[Index])
+	{
+		return BakedCurve->Sample(Progresses[Index]);
+	}
+
+	const UCurveFloat* Curve = Curves[Index];
+	return Curve ? Curve->GetFloatValue(Progresses[Index]) : Progresses[Index];
+}
+
+int32 UNekoTimelineSubsystem::AddTimeline(const FTimelineKey& Key, const FLatentActionInfo& LatentInfo, const float Time,
+	const UCurveFloat* Curve, const FNekoPseudoTimelineOptions& Options)
+{
+	UObject* CallbackTarget = LatentInfo.CallbackTarget;
+	check(CallbackTarget);
+
+	if (ElapsedTimes.Num() == ElapsedTimes.Max())
+	{
+		// Grows every array at once, instead of letting each of them grow on its own
+		++PoolMisses;
+		INC_DWORD_STAT(STAT_NekoTimelinePoolMisses);
+		ReserveTimelines(FMath::Max(ElapsedTimes.Max() * 2, 16));
+	}
+
+	const int32 Index = ElapsedTimes.Add(0.0f);
+	PeakTimelines = FMath::Max(PeakTimelines, ElapsedTimes.Num());
+	INC_DWORD_STAT(STAT_NekoLiveTimelines);
+
+	// Prevents dividing by zero, a timeline without any duration simply finishes on its first tick
+	TotalTimes.Add(FMath::Max(Time, UE_SMALL_NUMBER));
+	Progresses.Add(0.0f);
+	Alphas.Add(0.0f);
+	Curves.Add(Curve);
+	BakedCurves.Add(Options.bBakeCurve ? FNekoBakedCurveCache::Get().FindOrBake(Curve) : nullptr);
+	States.Add(ETimelineState::Running);
+	const AActor* DilationActor = nullptr;
+	TimeDomains.Add(GetTimeDomain(CallbackTarget, DilationActor));
+	DilationActors.Add(DilationActor);
+	RemainingCycles.Add(0);
+	PlaysBackwards.Add(false);
+	// Both set by ResetPlayback
+	TimesSinceUpdate.Add(0.0f);
+	UpdatedAlphas.Add(InternalNekoTimeline::NoUpdatedAlpha);
+	UpdateIntervals.Add(Options.MaxUpdateRate > 0.0f ? 1.0f / Options.MaxUpdateRate : 0.0f);
+	MinAlphaDeltas.Add(Options.MinAlphaDelta);
+	OutputPinSlots.Add(nullptr);
+	ProgressSlots.Add(nullptr);
+	AlphaSlots.Add(nullptr);
+	BindingIndices.Add(INDEX_NONE);
+	TypedOutputIndices.Add(INDEX_NONE);
+	CallbackTargets.Add(CallbackTarget);
+	ExecutionFunctions.Add(CallbackTarget->FindFunction(LatentInfo.ExecutionFunction));
+	Linkages.Add(LatentInfo.Linkage);
+	TimelineKeys.Add(Key);
+
+	FTimelinePlayback& Playback = Playbacks.AddDefaulted_GetRef();
+	Playback.PlayMode = Options.PlayMode;
+	Playback.LoopCount = Options.LoopCount;
+	Playback.StartPosition = FMath::Clamp(Options.StartPosition, 0.0f, 1.0f);
+	Playback.bReverse = Options.bReverse;
+	ResetPlayback(Index);
+
+	TimelineIndices.Add(Key, Index);
+	return Index;
+}
+
+UNekoTimelineSubsystem::ETimeDomain UNekoTimelineSubsystem::GetTimeDomain(const UObject* CallbackTarget, const AActor*& OutActor)
+{
+	OutActor = nullptr;
+
+	if (CallbackTarget->IsA<UUserWidget>())
+	{
+		return ETimeDomain::Widget;
+	}
+
+	// Actors, and the components or other subobjects they own
+	OutActor = Cast<AActor>(CallbackTarget);
+	if (OutActor == nullptr)
+	{
+		OutActor = CallbackTarget->GetTypedOuter<AActor>();
+	}
+
+	return OutActor ? ETimeDomain::Actor : ETimeDomain::World;
+}
+
+bool UNekoTimelineSubsystem::ShouldSkipUpdate(const int32 Index) const
+{
+	// Never skip the last one, so the node always ends up with the final value
+	if (States[Index] == ETimelineState::Completing)
+	{
+		return false;
+	}
+
+	// Tested explicitly rather than relying on comparisons with NaN, which fast math doesn't guarantee
+	if (FMath::IsNaN(UpdatedAlphas[Index]))
+	{
+		return false;
+	}
+
+	return TimesSinceUpdate[Index] < UpdateIntervals[Index]
+		|| FMath::Abs(Alphas[Index] - UpdatedAlphas[Index]) < MinAlphaDeltas[Index];
+}
+
+void UNekoTimelineSubsystem::FireOutputPin(const int32 Index, const EPseudoTimelineOutputPins Pin)
+{
+	UFunction* ExecutionFunction = ExecutionFunctions[Index];
+	if (ExecutionFunction == nullptr)
+	{
+		return;
+	}
+
+	if (EPseudoTimelineOutputPins* OutputPins = OutputPinSlots[Index])
+	{
+		*OutputPins = Pin;
+	}
+
+	// Same thing FLatentActionManager does when a latent action triggers its link
+	int32 Linkage = Linkages[Index];
+	CallbackTargets[Index]->ProcessEvent(ExecutionFunction, &Linkage);
+}
+
+void UNekoTimelineSubsystem::RemoveFinishedTimelines()
+{
+	for (int32 Index = States.Num() - 1; Index >= 0; --Index)
+	{
+		if (States[Index] != ETimelineState::Removed)
+		{
+			continue;
+		}
+
+		if (BindingIndices[Index] != INDEX_NONE)
+		{
+			Bindings.RemoveAt(BindingIndices[Index]);
+		}
+
+		if (TypedOutputIndices[Index] != INDEX_NONE)
+		{
+			TypedOutputs.RemoveAt(TypedOutputIndices[Index]);
+		}
+
+		ElapsedTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		TotalTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		Progresses.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		Alphas.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		Curves.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		BakedCurves.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		States.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		TimeDomains.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		DilationActors.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		RemainingCycles.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		PlaysBackwards.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		TimesSinceUpdate.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		UpdateIntervals.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		UpdatedAlphas.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		MinAlphaDeltas.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		OutputPinSlots.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		ProgressSlots.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		AlphaSlots.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		BindingIndices.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		TypedOutputIndices.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		CallbackTargets.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		ExecutionFunctions.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		Linkages.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		TimelineKeys.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		Playbacks.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		DEC_DWORD_STAT(STAT_NekoLiveTimelines);
+
+		// The last timeline was moved into the removed one's place
+		if (TimelineKeys.IsValidIndex(Index) && States[Index] != ETimelineState::Removed)
+		{
+			TimelineIndices.Add(TimelineKeys[Index], Index);
+		}
+	}
+}
+
+void UNekoTimelineSubsystem::HandlePostGarbageCollect()
+{
+	// Referenced curves can still be nulled out by the garbage collector if they were explicitly destroyed
+	for (int32 Index = 0; Index < Curves.Num(); ++Index)
+	{
+		if (Curves[Index] == nullptr)
+		{
+			BakedCurves[Index] = nullptr;
+		}
+	}
+
+	for (FNekoTimelineTypedOutput& TypedOutput : TypedOutputs)
+	{
+		if (TypedOutput.Curve == nullptr)
+		{
+			TypedOutput.BakedCurve = nullptr;
+		}
+	}
+}
+
+bool UNekoTimelineSubsystem::ResolveBinding(const FNekoTimelineTarget& Target, FTimelineBinding& OutBinding)
+{
+	UObject* Object = Target.Object.Get();
+	if (Object == nullptr)
+	{
+		UE_LOG(LogNekoUtils, Warning, TEXT("Tried to drive a timeline target without any object"));
+		return false;
+	}
+
+	OutBinding.Type = Target.Type;
+	OutBinding.WidgetField = Target.WidgetField;
+	OutBinding.ParameterName = Target.Name;
+	OutBinding.A = Target.A;
+	OutBinding.B = Target.B;
+	OutBinding.Object = Object;
+
+	switch (Target.Type)
+	{
+		case ENekoTimelineTargetType::Property:
+			break;
+
+		case ENekoTimelineTargetType::MaterialScalarParameter:
+		case ENekoTimelineTargetType::MaterialVectorParameter:
+			return Object->IsA<UMaterialInstanceDynamic>();
+
+		case ENekoTimelineTargetType::Widget:
+			return Object->IsA<UWidget>();
+
+		case ENekoTimelineTargetType::None:
+		default:
+			return false;
+	}
+
+	// Walks the property path, following object and struct properties until the last one
+	const UStruct* Struct = Object->GetClass();
+	void* Container = Object;
+	FProperty* Property = nullptr;
+
+	// Split without allocating, so that starting a pseudo-timeline never touches the general allocator once warmed up
+	const TStringBuilder<FName::StringBufferSize> PathBuffer(InPlace, Target.Name);
+	FStringView RemainingPath = PathBuffer.ToView();
+	while (!RemainingPath.IsEmpty())
+	{
+		const int32 DotIndex = UE::String::FindFirstChar(RemainingPath, TEXT('.'));
+		const FStringView Segment = DotIndex == INDEX_NONE ? RemainingPath : RemainingPath.Left(DotIndex);
+		RemainingPath = DotIndex == INDEX_NONE ? FStringView() : RemainingPath.RightChop(DotIndex + 1);
+
+		Property = FindFProperty<FProperty>(Struct, FName(Segment, FNAME_Find));
+		if (Property == nullptr)
+		{
+			UE_LOG(LogNekoUtils, Warning, TEXT("Could not find property [%s] of timeline target path [%s] on [%s]"), *FString(Segment), *Target.Name.ToString(), *GetNameSafe(Object));
+			return false;
+		}
+
+		if (RemainingPath.IsEmpty())
+		{
+			break;
+		}
+
+		if (const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(Property))
+		{
+			UObject* InnerObject = ObjectProperty->GetObjectPropertyValue_InContainer(Container);
+			if (InnerObject == nullptr)
+			{
+				UE_LOG(LogNekoUtils, Warning, TEXT("Property [%s] of timeline target path [%s] is null"), *FString(Segment), *Target.Name.ToString());
+				return false;
+			}
+
+			OutBinding.Object = InnerObject;
+			Struct = InnerObject->GetClass();
+			Container = InnerObject;
+		}
+		else if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		{
+			Struct = StructProperty->Struct;
+			Container = StructProperty->ContainerPtrToValuePtr<void>(Container);
+		}
+		else
+		{
+			UE_LOG(LogNekoUtils, Warning, TEXT("Property [%s] of timeline target path [%s] is neither an object nor a struct"), *FString(Segment), *Target.Name.ToString());
+			return false;
+		}
+	}
+
+	if (Property == nullptr)
+	{
+		return false;
+	}
+
+	OutBinding.PropertyValue = Property->ContainerPtrToValuePtr<void>(Container);
+
+	const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+	if (Property->IsA<FFloatProperty>())
+	{
+		OutBinding.PropertyType = EPropertyValueType::Float;
+	}
+	else if (Property->IsA<FDoubleProperty>())
+	{
+		OutBinding.PropertyType = EPropertyValueType::Double;
+	}
+	else if (StructProperty && StructProperty->Struct == TBaseStructure<FVector>::Get())
+	{
+		OutBinding.PropertyType = EPropertyValueType::Vector;
+	}
+	else if (StructProperty && StructProperty->Struct == TBaseStructure<FLinearColor>::Get())
+	{
+		OutBinding.PropertyType = EPropertyValueType::LinearColor;
+	}
+	else
+	{
+		UE_LOG(LogNekoUtils, Warning, TEXT("Timeline target path [%s] is not a float, double, vector or linear color property"), *Target.Name.ToString());
+		return false;
+	}
+
+	// Properties nested in a struct have no setter of their own
+	if (Container == OutBinding.Object.Get())
+	{
+		ResolveSetter(*Property, OutBinding);
+	}
+
+	// Components only pick up raw writes to their rendering properties once their render state is recreated
+	OutBinding.bMarkRenderStateDirty = OutBinding.Setter == nullptr && OutBinding.Object->IsA<UActorComponent>();
+	return true;
+}
+
+void UNekoTimelineSubsystem::ResolveSetter(const FProperty& Property, FTimelineBinding& OutBinding)
+{
+	const TStringBuilder<FName::StringBufferSize> SetterName(InPlace, TEXT("Set"), Property.GetFName());
+	UFunction* Setter = OutBinding.Object->FindFunction(FName(SetterName.ToView(), FNAME_Find));
+	if (Setter == nullptr || Setter->NumParms != 1)
+	{
+		return;
+	}
+
+	// Taken by value or by const reference, but not a return value or an output
+	FProperty* Parameter = CastField<FProperty>(Setter->ChildProperties);
+	if (Parameter == nullptr || !Parameter->SameType(&Property) || Parameter->HasAnyPropertyFlags(CPF_ReturnParm)
+		|| (Parameter->HasAnyPropertyFlags(CPF_OutParm) && !Parameter->HasAnyPropertyFlags(CPF_ConstParm)))
+	{
+		return;
+	}
+
+	OutBinding.Setter = Setter;
+	OutBinding.SetterParameter = Parameter;
+}
+
+void UNekoTimelineSubsystem::FTimelineBinding::Apply(const float Alpha) const
+{
+	UObject* Target = Object.Get();
+	if (Target == nullptr)
+	{
+		return;
+	}
+
+	const FVector4 Value = A + (B - A) * Alpha;
+
+	switch (Type)
+	{
+		case ENekoTimelineTargetType::Property:
+			if (Setter != nullptr)
+			{
+				// Every supported value type is trivially constructible, so the parameters need no initialization
+				uint8* Parameters = static_cast<uint8*>(FMemory_Alloca_Aligned(Setter->ParmsSize, Setter->GetMinAlignment()));
+				FMemory::Memzero(Parameters, Setter->ParmsSize);
+				WriteValue(PropertyType, SetterParameter->ContainerPtrToValuePtr<void>(Parameters), Value);
+				Target->ProcessEvent(Setter, Parameters);
+				break;
+			}
+
+			// Written directly in memory, so no property change notification is sent
+			WriteValue(PropertyType, PropertyValue, Value);
+			if (bMarkRenderStateDirty)
+			{
+				static_cast<UActorComponent*>(Target)->MarkRenderStateDirty();
+			}
+			break;
+
+		case ENekoTimelineTargetType::MaterialScalarParameter:
+			static_cast<UMaterialInstanceDynamic*>(Target)->SetScalarParameterValue(ParameterName, Value.X);
+			break;
+
+		case ENekoTimelineTargetType::MaterialVectorParameter:
+			static_cast<UMaterialInstanceDynamic*>(Target)->SetVectorParameterValue(ParameterName, FLinearColor(Value));
+			break;
+
+		case ENekoTimelineTargetType::Widget:
+		{
+			UWidget* Widget = static_cast<UWidget*>(Target);
+			switch (WidgetField)
+			{
+				case ENekoWidgetRenderField::RenderOpacity:
+					Widget->SetRenderOpacity(Value.X);
+					break;
+				case ENekoWidgetRenderField::RenderTranslation:
+					Widget->SetRenderTranslation(FVector2D(Value.X, Value.Y));
+					break;
+				case ENekoWidgetRenderField::RenderScale:
+					Widget->SetRenderScale(FVector2D(Value.X, Value.Y));
+					break;
+				case ENekoWidgetRenderField::RenderShear:
+					Widget->SetRenderShear(FVector2D(Value.X, Value.Y));
+					break;
+				case ENekoWidgetRenderField::RenderAngle:
+					Widget->SetRenderTransformAngle(Value.X);
+					break;
+			}
+			break;
+		}
+
+		case ENekoTimelineTargetType::None:
+		default:
+			break;
+	}
+}
+
+void UNekoTimelineSubsystem::FTimelineBinding::WriteValue(const EPropertyValueType ValueType, void* Destination, const FVector4& Value)
+{
+	switch (ValueType)
+	{
+		case EPropertyValueType::Float:
+			*static_cast<float*>(Destination) = static_cast<float>(Value.X);
+			break;
+		case EPropertyValueType::Double:
+			*static_cast<double*>(Destination) = Value.X;
+			break;
+		case EPropertyValueType::Vector:
+			*static_cast<FVector*>(Destination) = FVector(Value);
+			break;
+		case EPropertyValueType::LinearColor:
+			*static_cast<FLinearColor*>(Destination) = FLinearColor(Value);
+			break;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// FNekoTimelineTypedOutput
+
+FNekoTimelineTypedOutput FNekoTimelineTypedOutput::MakeVector(FVector& OutValue, const FVector& A, const FVector& B)
+{
+	FNekoTimelineTypedOutput Output;
+	Output.Type = EValueType::Vector;
+	Output.Value = &OutValue;
+	Output.A = FVector4(A, 0.0);
+	Output.B = FVector4(B, 0.0);
+	return Output;
+}
+
+FNekoTimelineTypedOutput FNekoTimelineTypedOutput::MakeVector(FVector& OutValue, const UCurveVector* Curve)
+{
+	FNekoTimelineTypedOutput Output;
+	Output.Type = EValueType::Vector;
+	Output.Value = &OutValue;
+	Output.Curve = Curve;
+	return Output;
+}
+
+FNekoTimelineTypedOutput FNekoTimelineTypedOutput::MakeRotator(FRotator& OutValue, const FRotator& A, const FRotator& B)
+{
+	FNekoTimelineTypedOutput Output;
+	Output.Type = EValueType::Rotator;
+	Output.Value = &OutValue;
+	Output.RotationA = A.Quaternion();
+	Output.RotationB = B.Quaternion();
+	return Output;
+}
+
+FNekoTimelineTypedOutput FNekoTimelineTypedOutput::MakeLinearColor(FLinearColor& OutValue, const FLinearColor& A, const FLinearColor& B)
+{
+	FNekoTimelineTypedOutput Output;
+	Output.Type = EValueType::LinearColor;
+	Output.Value = &OutValue;
+	Output.A = FVector4(A);
+	Output.B = FVector4(B);
+	return Output;
+}
+
+FNekoTimelineTypedOutput FNekoTimelineTypedOutput::MakeLinearColor(FLinearColor& OutValue, const UCurveLinearColor* Curve)
+{
+	FNekoTimelineTypedOutput Output;
+	Output.Type = EValueType::LinearColor;
+	Output.Value = &OutValue;
+	Output.Curve = Curve;
+	return Output;
+}
+
+FNekoTimelineTypedOutput FNekoTimelineTypedOutput::MakeTransform(FTransform& OutValue, const FTransform& A, const FTransform& B)
+{
+	FNekoTimelineTypedOutput Output;
+	Output.Type = EValueType::Transform;
+	Output.Value = &OutValue;
+	Output.A = FVector4(A.GetTranslation(), 0.0);
+	Output.B = FVector4(B.GetTranslation(), 0.0);
+	Output.RotationA = A.GetRotation();
+	Output.RotationB = B.GetRotation();
+	Output.ScaleA = A.GetScale3D();
+	Output.ScaleB = B.GetScale3D();
+	return Output;
+}
+
+void FNekoTimelineTypedOutput::Write(const float Progress, const float Alpha) const
+{
+	if (Curve != nullptr)
+	{
+		float Channels[FNekoBakedCurve::MaxChannels];
+		if (BakedCurve != nullptr)
+		{
+			BakedCurve->SampleChannels(Progress, Channels);
+		}
+		else if (const UCurveVector* VectorCurve = Cast<UCurveVector>(Curve))
+		{
+			const FVector Vector = VectorCurve->GetVectorValue(Progress);
+			Channels[0] = Vector.X;
+			Channels[1] = Vector.Y;
+			Channels[2] = Vector.Z;
+		}
+		else if (const UCurveLinearColor* ColorCurve = Cast<UCurveLinearColor>(Curve))
+		{
+			const FLinearColor Color = ColorCurve->GetLinearColorValue(Progress);
+			Channels[0] = Color.R;
+			Channels[1] = Color.G;
+			Channels[2] = Color.B;
+			Channels[3] = Color.A;
+		}
+		else
+		{
+			return;
+		}
+
+		if (Type == EValueType::LinearColor)
+		{
+			*static_cast<FLinearColor*>(Value) = FLinearColor(Channels[0], Channels[1], Channels[2], Channels[3]);
+		}
+		else if (Type == EValueType::Vector)
+		{
+			*static_cast<FVector*>(Value) = FVector(Channels[0], Channels[1], Channels[2]);
+		}
+		return;
+	}
+
+	switch (Type)
+	{
+		case EValueType::Vector:
+			*static_cast<FVector*>(Value) = FVector(A + (B - A) * Alpha);
+			break;
+
+		case EValueType::Rotator:
+			*static_cast<FRotator*>(Value) = FQuat::Slerp(RotationA, RotationB, Alpha).Rotator();
+			break;
+
+		case EValueType::LinearColor:
+			*static_cast<FLinearColor*>(Value) = FLinearColor(A + (B - A) * Alpha);
+			break;
+
+		case EValueType::Transform:
+			*static_cast<FTransform*>(Value) = FTransform(
+				FQuat::Slerp(RotationA, RotationB, Alpha),
+				FVector(A + (B - A) * Alpha),
+				FMath::Lerp(ScaleA, ScaleB, Alpha));
+			break;
+	}
+}
@@ -1,5 +1,21 @@
 ﻿// MIT License - Copyright (c) Juniper Bouchard
 
+#include "NekoGameplayTagIndex.h"
+
+#include "GameplayTagsManager.h"
 #include "Modules/ModuleManager.h"
 
-IMPLEMENT_MODULE(FDefaultModuleImpl, NekoUtils)
+
+class FNekoUtilsModule final : public IModuleInterface
+{
+	virtual void StartupModule() override
+	{
+		// Built as soon as the tag tree is, so that the first tag query of the game doesn't pay for walking the whole tree
+		UGameplayTagsManager::CallOrRegister_OnDoneAddingNativeTagsDelegate(FSimpleMulticastDelegate::FDelegate::CreateLambda([]()
+		{
+			FNekoGameplayTagIndex::Get();
+		}));
+	}
+};
+
+IMPLEMENT_MODULE(FNekoUtilsModule, NekoUtils)
@@ -0,0 +1,196 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#pragma once
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "NekoCompiledTagQuery.h"
+#include "NekoGameplayTagIndex.h"
+#include "NekoTagBitset.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameplayTagsManager.h"
+#include "HAL/MemoryBase.h"
+#include "Math/RandomStream.h"
+#include "Misc/EngineVersionComparison.h"
+
+// EAutomationTestFlags::ApplicationContextMask is deprecated since 5.5
+#if UE_VERSION_OLDER_THAN(5, 5, 0)
+#define NEKO_AUTOMATION_TEST_CONTEXT EAutomationTestFlags::ApplicationContextMask
+#else
+#define NEKO_AUTOMATION_TEST_CONTEXT EAutomationTestFlags_ApplicationContextMask
+#endif
+
+/**
+ * Makes gameplay tag structures refer to an older version of the gameplay tag index, like after the tag tree changed,
+ * without rebuilding the shared index, which would make every live bitset stale and notify every listener of the engine.
+ */
+struct FNekoGameplayTagTestAccess
+{
+	static void MakeStale(FNekoTagBitset& Bitset)
+	{
+		Bitset.Version = FNekoGameplayTagIndex::Get().GetVersion() - 1;
+	}
+
+	static void MakeStale(FNekoCompiledTagQuery& CompiledQuery)
+	{
+		CompiledQuery.Version = FNekoGameplayTagIndex::Get().GetVersion() - 1;
+	}
+};
+
+namespace NekoAutomationTest
+{
+	/**
+	 * Game world living for the duration of a test, with its subsystems initialized. Nothing is ticked automatically.
+	 */
+	class FScopedTestWorld final
+	{
+	public:
+		FScopedTestWorld()
+		{
+			World = UWorld::CreateWorld(EWorldType::Game, false);
+			GEngine->CreateNewWorldContext(EWorldType::Game).SetCurrentWorld(World);
+		}
+
+		~FScopedTestWorld()
+		{
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+		}
+
+		UWorld* operator->() const { return World; }
+		UWorld* Get() const { return World; }
+
+	private:
+		UWorld* World = nullptr;
+	};
+
+	/**
+	 * Counts the allocations made by the game thread while in scope, by standing in for GMalloc and forwarding every call
+	 * to it. Allocations of the other threads are forwarded without being counted.
+	 *
+	 * Platforms calling a fixed allocator class instead of GMalloc (PLATFORM_USES_FIXED_GMalloc_CLASS) count nothing.
+	 */
+	class FScopedAllocationCounter final
+	{
+	public:
+		FScopedAllocationCounter()
+		{
+			check(IsInGameThread());
+			FCountingMalloc& CountingMalloc = GetCountingMalloc();
+			CountingMalloc.Inner = GMalloc;
+			CountingMalloc.NumAllocations = 0;
+			GMalloc = &CountingMalloc;
+		}
+
+		~FScopedAllocationCounter()
+		{
+			GMalloc = GetCountingMalloc().Inner;
+		}
+
+		// Number of allocations and reallocations made by the game thread so far
+		int32 GetNumAllocations() const { return GetCountingMalloc().NumAllocations; }
+
+	private:
+		class FCountingMalloc final : public FMalloc
+		{
+		public:
+			virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+			{
+				CountAllocation();
+				return Inner->Malloc(Count, Alignment);
+			}
+
+			virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+			{
+				// Reallocating to 0 frees the memory
+				if (Count > 0)
+				{
+					CountAllocation();
+				}
+				return Inner->Realloc(Original, Count, Alignment);
+			}
+
+			virtual void Free(void* Original) override { Inner->Free(Original); }
+			virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+			virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+			virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+			virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+			virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+			FMalloc* Inner = nullptr;
+			int32 NumAllocations = 0;
+
+		private:
+			void CountAllocation()
+			{
+				if (IsInGameThread())
+				{
+					++NumAllocations;
+				}
+			}
+		};
+
+		// Never destroyed, since other threads may still be calling it right after it was swapped out
+		static FCountingMalloc& GetCountingMalloc()
+		{
+			static FCountingMalloc* CountingMalloc = new FCountingMalloc();
+			return *CountingMalloc;
+		}
+	};
+
+	// Gets every gameplay tag of the project. Tests pick their tags among them, since the tag tree can't be extended once
+	// it is built
+	inline TArray<FGameplayTag> GetAllGameplayTags()
+	{
+		FGameplayTagContainer AllTags;
+		UGameplayTagsManager::Get().RequestAllGameplayTags(AllTags, false);
+		return AllTags.GetGameplayTagArray();
+	}
+
+	// Gets every gameplay tag of the project, or adds a warning to the test and returns false if there are fewer than
+	// MinNumTags of them, leaving the test nothing to check
+	inline bool GetGameplayTagsToTestWith(FAutomationTestBase& Test, TArray<FGameplayTag>& OutTags, const int32 MinNumTags = 1)
+	{
+		OutTags = GetAllGameplayTags();
+		if (OutTags.Num() < MinNumTags)
+		{
+			Test.AddWarning(FString::Printf(TEXT("The project needs at least %d gameplay tags to run this test"), MinNumTags));
+			return false;
+		}
+		return true;
+	}
+
+	inline FGameplayTag PickRandomTag(FRandomStream& Random, const TArray<FGameplayTag>& AllTags)
+	{
+		return AllTags[Random.RandHelper(AllTags.Num())];
+	}
+
+	// Makes a container of the provided number of tags picked at random, with their parents implied like usual
+	inline FGameplayTagContainer MakeRandomContainer(FRandomStream& Random, const TArray<FGameplayTag>& AllTags, const int32 NumTags)
+	{
+		FGameplayTagContainer Container;
+		for (int32 Index = 0; Index < NumTags; ++Index)
+		{
+			Container.AddTag(PickRandomTag(Random, AllTags));
+		}
+		return Container;
+	}
+
+	// Calls the provided function the provided number of times, and returns the average time of a call in nanoseconds
+	template <typename FunctionType>
+	double MeasureNanoseconds(const int32 NumCalls, FunctionType&& Function)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Call = 0; Call < NumCalls; ++Call)
+		{
+			Function();
+		}
+		return (FPlatformTime::Seconds() - StartTime) * 1.0e9 / FMath::Max(NumCalls, 1);
+	}
+}
+
+#endif
@@ -0,0 +1,193 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#include "Tests/NekoAutomationTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "NekoBakedCurve.h"
+
+#include "Curves/CurveFloat.h"
+#include "Curves/CurveLinearColor.h"
+#include "Curves/CurveVector.h"
+#include "Math/RandomStream.h"
+#include "UObject/Package.h"
+
+
+namespace InternalNekoBakedCurveTests
+{
+	// A smooth ease in and out with an overshoot, sampled with cubic interpolation
+	void AddEaseKeys(FRichCurve& Curve, const float Scale = 1.0f)
+	{
+		const float Keys[][2] = { { 0.0f, 0.0f }, { 0.2f, 0.1f }, { 0.45f, 0.6f }, { 0.7f, 1.1f }, { 0.85f, 0.95f }, { 1.0f, 1.0f } };
+		for (const float (&Key)[2] : Keys)
+		{
+			const FKeyHandle Handle = Curve.AddKey(Key[0], Key[1] * Scale);
+			Curve.SetKeyInterpMode(Handle, RCIM_Cubic);
+		}
+	}
+
+	UCurveFloat* MakeEaseCurve()
+	{
+		UCurveFloat* Curve = NewObject<UCurveFloat>(GetTransientPackage());
+		AddEaseKeys(Curve->FloatCurve);
+		return Curve;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNekoBakedCurveSampleTest, "NekoUtils.PseudoTimeline.BakedCurve.Sample",
+	NEKO_AUTOMATION_TEST_CONTEXT | EAutomationTestFlags::EngineFilter)
+
+bool FNekoBakedCurveSampleTest::RunTest(const FString& Parameters)
+{
+	using namespace InternalNekoBakedCurveTests;
+
+	const UCurveFloat* Curve = MakeEaseCurve();
+	FNekoBakedCurve BakedCurve;
+	BakedCurve.Bake(*Curve);
+	TestEqual(TEXT("A float curve has one channel"), BakedCurve.NumChannels, 1);
+
+	// The samples are taken at these times, so there is nothing to interpolate
+	for (int32 Index = 0; Index <= FNekoBakedCurve::Resolution; ++Index)
+	{
+		const float Time = static_cast<float>(Index) / FNekoBakedCurve::Resolution;
+		if (!FMath::IsNearlyEqual(BakedCurve.Sample(Time), Curve->GetFloatValue(Time), UE_KINDA_SMALL_NUMBER))
+		{
+			AddError(FString::Printf(TEXT("The baked curve differs from the exact curve on sample %d"), Index));
+			return false;
+		}
+	}
+
+	TestEqual(TEXT("Times before 0 are clamped"), BakedCurve.Sample(-1.0f), BakedCurve.Sample(0.0f));
+	TestEqual(TEXT("Times after 1 are clamped"), BakedCurve.Sample(2.0f), BakedCurve.Sample(1.0f));
+
+	// MaxError is measured between the samples, so anything well above it means the table is wrong
+	FRandomStream Random(42);
+	float MaxMeasuredError = 0.0f;
+	for (int32 Index = 0; Index < 10000; ++Index)
+	{
+		const float Time = Random.GetFraction();
+		MaxMeasuredError = FMath::Max(MaxMeasuredError, FMath::Abs(BakedCurve.Sample(Time) - Curve->GetFloatValue(Time)));
+	}
+	TestTrue(TEXT("The baked curve stays close to the exact curve"), MaxMeasuredError <= BakedCurve.MaxError * 2.0f + UE_KINDA_SMALL_NUMBER);
+
+	// Linear interpolation between the samples is exact on a linear curve
+	UCurveFloat* LinearCurve = NewObject<UCurveFloat>(GetTransientPackage());
+	LinearCurve->FloatCurve.AddKey(0.0f, 2.0f);
+	LinearCurve->FloatCurve.AddKey(1.0f, -3.0f);
+	FNekoBakedCurve BakedLinearCurve;
+	BakedLinearCurve.Bake(*LinearCurve);
+	TestTrue(TEXT("A linear curve is baked without error"), BakedLinearCurve.MaxError <= UE_KINDA_SMALL_NUMBER);
+	TestEqual(TEXT("A linear curve is sampled exactly"), BakedLinearCurve.Sample(0.3f), LinearCurve->GetFloatValue(0.3f), UE_KINDA_SMALL_NUMBER);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNekoBakedCurveChannelsTest, "NekoUtils.PseudoTimeline.BakedCurve.Channels",
+	NEKO_AUTOMATION_TEST_CONTEXT | EAutomationTestFlags::EngineFilter)
+
+bool FNekoBakedCurveChannelsTest::RunTest(const FString& Parameters)
+{
+	using namespace InternalNekoBakedCurveTests;
+
+	// Each channel gets its own scale, so that swapped channels are noticed
+	UCurveVector* VectorCurve = NewObject<UCurveVector>(GetTransientPackage());
+	UCurveLinearColor* ColorCurve = NewObject<UCurveLinearColor>(GetTransientPackage());
+	for (int32 Channel = 0; Channel < 4; ++Channel)
+	{
+		if (Channel < 3)
+		{
+			AddEaseKeys(VectorCurve->FloatCurves[Channel], Channel + 1.0f);
+		}
+		AddEaseKeys(ColorCurve->FloatCurves[Channel], Channel + 1.0f);
+	}
+
+	FNekoBakedCurve BakedVectorCurve;
+	BakedVectorCurve.Bake(*VectorCurve);
+	FNekoBakedCurve BakedColorCurve;
+	BakedColorCurve.Bake(*ColorCurve);
+	TestEqual(TEXT("A vector curve has three channels"), BakedVectorCurve.NumChannels, 3);
+	TestEqual(TEXT("A linear color curve has four channels"), BakedColorCurve.NumChannels, 4);
+
+	FRandomStream Random(42);
+	for (int32 Index = 0; Index < 1000; ++Index)
+	{
+		const float Time = Random.GetFraction();
+
+		float VectorValues[FNekoBakedCurve::MaxChannels];
+		BakedVectorCurve.SampleChannels(Time, VectorValues);
+		const FVector ExpectedVector = VectorCurve->GetVectorValue(Time);
+
+		float ColorValues[FNekoBakedCurve::MaxChannels];
+		BakedColorCurve.SampleChannels(Time, ColorValues);
+		const FLinearColor ExpectedColor = ColorCurve->GetLinearColorValue(Time);
+
+		const float VectorTolerance = BakedVectorCurve.MaxError * 2.0f + UE_KINDA_SMALL_NUMBER;
+		const float ColorTolerance = BakedColorCurve.MaxError * 2.0f + UE_KINDA_SMALL_NUMBER;
+		if (!FVector(VectorValues[0], VectorValues[1], VectorValues[2]).Equals(ExpectedVector, VectorTolerance)
+			|| !FLinearColor(ColorValues[0], ColorValues[1], ColorValues[2], ColorValues[3]).Equals(ExpectedColor, ColorTolerance))
+		{
+			AddError(FString::Printf(TEXT("The baked channels differ from the exact curves at %f"), Time));
+			return false;
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNekoBakedCurveCacheTest, "NekoUtils.PseudoTimeline.BakedCurve.Cache",
+	NEKO_AUTOMATION_TEST_CONTEXT | EAutomationTestFlags::EngineFilter)
+
+bool FNekoBakedCurveCacheTest::RunTest(const FString& Parameters)
+{
+	using namespace InternalNekoBakedCurveTests;
+
+	FNekoBakedCurveCache& Cache = FNekoBakedCurveCache::Get();
+	UCurveFloat* Curve = MakeEaseCurve();
+
+	const FNekoBakedCurve* BakedCurve = Cache.FindOrBake(Curve);
+	TestNotNull(TEXT("The curve was baked"), BakedCurve);
+	TestTrue(TEXT("The curve is only baked once"), Cache.FindOrBake(Curve) == BakedCurve);
+	TestNull(TEXT("A null curve isn't baked"), Cache.FindOrBake(nullptr));
+
+#if WITH_EDITOR
+	Curve->FloatCurve.Reset();
+	Curve->FloatCurve.AddKey(0.0f, 5.0f);
+	Curve->OnUpdateCurve.Broadcast(Curve, EPropertyChangeType::ValueSet);
+	TestTrue(TEXT("An edited curve is baked again in place"), Cache.FindOrBake(Curve) == BakedCurve);
+	TestEqual(TEXT("An edited curve is sampled with its new keys"), BakedCurve->Sample(0.5f), 5.0f, UE_KINDA_SMALL_NUMBER);
+#endif
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNekoBakedCurveBenchmark, "NekoUtils.PseudoTimeline.BakedCurve.Benchmark",
+	NEKO_AUTOMATION_TEST_CONTEXT | EAutomationTestFlags::PerfFilter)
+
+bool FNekoBakedCurveBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace InternalNekoBakedCurveTests;
+
+	constexpr int32 NumSamples = 1000000;
+
+	const UCurveFloat* Curve = MakeEaseCurve();
+	FNekoBakedCurve BakedCurve;
+	BakedCurve.Bake(*Curve);
+
+	float Sum = 0.0f;
+	const double ExactNanoseconds = NekoAutomationTest::MeasureNanoseconds(NumSamples, [&, Time = 0.0f]() mutable
+	{
+		Sum += Curve->GetFloatValue(Time);
+		Time = FMath::Frac(Time + 0.0001234f);
+	});
+	const double BakedNanoseconds = NekoAutomationTest::MeasureNanoseconds(NumSamples, [&, Time = 0.0f]() mutable
+	{
+		Sum += BakedCurve.Sample(Time);
+		Time = FMath::Frac(Time + 0.0001234f);
+	});
+
+	AddInfo(FString::Printf(TEXT("Maximum error: %f, exact: %.2f ns per sample, baked: %.2f ns per sample (x%.1f), checksum %f"),
+		BakedCurve.MaxError, ExactNanoseconds, BakedNanoseconds, ExactNanoseconds / FMath::Max(BakedNanoseconds, UE_DOUBLE_SMALL_NUMBER), Sum));
+	return true;
+}
+
+#endif
@@ -0,0 +1,232 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#include "Tests/NekoAutomationTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "NekoCompiledTagQuery.h"
+
+#include "Math/RandomStream.h"
+
+
+namespace InternalNekoCompiledTagQueryTests
+{
+	// Makes an expression of any type, whose tag and expression sets may be empty, nested at most Depth times
+	FGameplayTagQueryExpression MakeRandomExpression(FRandomStream& Random, const TArray<FGameplayTag>& AllTags, const int32 Depth)
+	{
+		FGameplayTagQueryExpression Expression;
+		const int32 NumChildren = Random.RandRange(0, 3);
+
+		switch (Random.RandRange(0, Depth > 0 ? 7 : 4))
+		{
+			case 0: Expression.AnyTagsMatch(); break;
+			case 1: Expression.AllTagsMatch(); break;
+			case 2: Expression.NoTagsMatch(); break;
+			case 3: Expression.AnyTagsExactMatch(); break;
+			case 4: Expression.AllTagsExactMatch(); break;
+			case 5: Expression.AnyExprMatch(); break;
+			case 6: Expression.AllExprMatch(); break;
+			default: Expression.NoExprMatch(); break;
+		}
+
+		for (int32 Index = 0; Index < NumChildren; ++Index)
+		{
+			if (Expression.UsesTagSet())
+			{
+				Expression.AddTag(NekoAutomationTest::PickRandomTag(Random, AllTags));
+			}
+			else
+			{
+				Expression.AddExpr(MakeRandomExpression(Random, AllTags, Depth - 1));
+			}
+		}
+
+		return Expression;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNekoCompiledTagQueryMatchTest, "NekoUtils.GameplayTags.CompiledTagQuery.Match",
+	NEKO_AUTOMATION_TEST_CONTEXT | EAutomationTestFlags::EngineFilter)
+
+bool FNekoCompiledTagQueryMatchTest::RunTest(const FString& Parameters)
+{
+	using namespace InternalNekoCompiledTagQueryTests;
+	using namespace NekoAutomationTest;
+
+	TArray<FGameplayTag> AllTags;
+	if (!GetGameplayTagsToTestWith(*this, AllTags))
+	{
+		return true;
+	}
+
+	FRandomStream Random(42);
+	TArray<FGameplayTagContainer> Containers;
+	TArray<FNekoTagBitset> Bitsets;
+	for (int32 Index = 0; Index < 200; ++Index)
+	{
+		Containers.Add(MakeRandomContainer(Random, AllTags, Random.RandRange(0, 4)));
+		Bitsets.Emplace(Containers.Last());
+	}
+
+	for (int32 Run = 0; Run < 200; ++Run)
+	{
+		const FGameplayTagQuery Query = FGameplayTagQuery::BuildQuery(MakeRandomExpression(Random, AllTags, 3));
+		const FNekoCompiledTagQuery CompiledQuery(Query);
+		if (!TestFalse(FString::Printf(TEXT("[%s] was compiled"), *Query.GetDescription()), CompiledQuery.UsesFallback()))
+		{
+			return false;
+		}
+
+		TArray<int32> ExpectedIndices;
+		for (int32 Index = 0; Index < Containers.Num(); ++Index)
+		{
+			const bool bExpected = Query.Matches(Containers[Index]);
+			if (bExpected)
+			{
+				ExpectedIndices.Add(Index);
+			}
+
+			if (CompiledQuery.Matches(Containers[Index]) != bExpected || CompiledQuery.Matches(Bitsets[Index]) != bExpected)
+			{
+				AddError(FString::Printf(TEXT("[%s] compiled doesn't match [%s] like the original query"), *Query.GetDescription(), *Containers[Index].ToStringSimple()));
+				return false;
+			}
+		}
+
+		TArray<int32> MatchingIndices;
+		CompiledQuery.FilterMatches(Bitsets, MatchingIndices);
+		if (MatchingIndices != ExpectedIndices)
+		{
+			AddError(FString::Printf(TEXT("[%s] compiled doesn't filter the same bitsets as the original query"), *Query.GetDescription()));
+			return false;
+		}
+	}
+
+	const FGameplayTagQuery EmptyQuery;
+	const FNekoCompiledTagQuery CompiledEmptyQuery(EmptyQuery);
+	TestTrue(TEXT("An empty query is empty once compiled"), CompiledEmptyQuery.IsEmpty());
+	TestEqual(TEXT("An empty query matches like the original one"), CompiledEmptyQuery.Matches(Bitsets[0]), EmptyQuery.Matches(Containers[0]));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNekoCompiledTagQueryStaleTest, "NekoUtils.GameplayTags.CompiledTagQuery.Stale",
+	NEKO_AUTOMATION_TEST_CONTEXT | EAutomationTestFlags::EngineFilter)
+
+bool FNekoCompiledTagQueryStaleTest::RunTest(const FString& Parameters)
+{
+	using namespace InternalNekoCompiledTagQueryTests;
+	using namespace NekoAutomationTest;
+
+	TArray<FGameplayTag> AllTags;
+	if (!GetGameplayTagsToTestWith(*this, AllTags))
+	{
+		return true;
+	}
+
+	FRandomStream Random(42);
+	FGameplayTagQueryExpression Expression;
+	Expression.NoTagsMatch().AddTag(PickRandomTag(Random, AllTags)).AddTag(PickRandomTag(Random, AllTags));
+	const FGameplayTagQuery Query = FGameplayTagQuery::BuildQuery(Expression);
+	FNekoCompiledTagQuery CompiledQuery(Query);
+	TestFalse(TEXT("The query was compiled"), CompiledQuery.UsesFallback());
+
+	// Like a query compiled before the tag tree changed
+	FNekoGameplayTagTestAccess::MakeStale(CompiledQuery);
+	TestTrue(TEXT("A query compiled before the tree changed falls back to the original query"), CompiledQuery.UsesFallback());
+
+	for (int32 Index = 0; Index < 100; ++Index)
+	{
+		const FGameplayTagContainer Container = MakeRandomContainer(Random, AllTags, Random.RandRange(0, 4));
+		if (CompiledQuery.Matches(FNekoTagBitset(Container)) != Query.Matches(Container))
+		{
+			AddError(FString::Printf(TEXT("The stale compiled query doesn't match [%s] like the original query"), *Container.ToStringSimple()));
+			return false;
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNekoCompiledTagQueryBenchmark, "NekoUtils.GameplayTags.CompiledTagQuery.Benchmark",
+	NEKO_AUTOMATION_TEST_CONTEXT | EAutomationTestFlags::PerfFilter)
+
+bool FNekoCompiledTagQueryBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace InternalNekoCompiledTagQueryTests;
+	using namespace NekoAutomationTest;
+
+	constexpr int32 NumContainers = 10000;
+	constexpr int32 NumRuns = 100;
+
+	TArray<FGameplayTag> AllTags;
+	if (!GetGameplayTagsToTestWith(*this, AllTags))
+	{
+		return true;
+	}
+
+	FRandomStream Random(42);
+
+	// Any of two tags, but none of two others, or all of two exact tags
+	FGameplayTagQueryExpression AnyExpression;
+	AnyExpression.AnyTagsMatch().AddTag(PickRandomTag(Random, AllTags)).AddTag(PickRandomTag(Random, AllTags));
+	FGameplayTagQueryExpression NoneExpression;
+	NoneExpression.NoTagsMatch().AddTag(PickRandomTag(Random, AllTags)).AddTag(PickRandomTag(Random, AllTags));
+	FGameplayTagQueryExpression AllExpression;
+	AllExpression.AllExprMatch().AddExpr(AnyExpression).AddExpr(NoneExpression);
+	FGameplayTagQueryExpression ExactExpression;
+	ExactExpression.AllTagsExactMatch().AddTag(PickRandomTag(Random, AllTags)).AddTag(PickRandomTag(Random, AllTags));
+	FGameplayTagQueryExpression RootExpression;
+	RootExpression.AnyExprMatch().AddExpr(AllExpression).AddExpr(ExactExpression);
+
+	const FGameplayTagQuery Query = FGameplayTagQuery::BuildQuery(RootExpression);
+	const FNekoCompiledTagQuery CompiledQuery(Query);
+
+	TArray<FGameplayTagContainer> Containers;
+	TArray<FNekoTagBitset> Bitsets;
+	for (int32 Index = 0; Index < NumContainers; ++Index)
+	{
+		FGameplayTagContainer& Container = Containers.AddDefaulted_GetRef();
+		for (int32 TagIndex = 0; TagIndex < 4; ++TagIndex)
+		{
+			Container.AddTag(PickRandomTag(Random, AllTags));
+		}
+		Bitsets.Emplace(Container);
+	}
+
+	int32 NumMatches = 0;
+	const double QueryNanoseconds = NekoAutomationTest::MeasureNanoseconds(NumRuns, [&]()
+	{
+		for (const FGameplayTagContainer& Container : Containers)
+		{
+			NumMatches += Query.Matches(Container);
+		}
+	});
+	const double ContainerNanoseconds = NekoAutomationTest::MeasureNanoseconds(NumRuns, [&]()
+	{
+		for (const FGameplayTagContainer& Container : Containers)
+		{
+			NumMatches += CompiledQuery.Matches(Container);
+		}
+	});
+	const double BitsetNanoseconds = NekoAutomationTest::MeasureNanoseconds(NumRuns, [&]()
+	{
+		for (const FNekoTagBitset& Bitset : Bitsets)
+		{
+			NumMatches += CompiledQuery.Matches(Bitset);
+		}
+	});
+	TArray<int32> MatchingIndices;
+	const double FilterNanoseconds = NekoAutomationTest::MeasureNanoseconds(NumRuns, [&]()
+	{
+		CompiledQuery.FilterMatches(Bitsets, MatchingIndices);
+		NumMatches += MatchingIndices.Num();
+	});
+
+	AddInfo(FString::Printf(TEXT("%d containers, FGameplayTagQuery: %.2f us, compiled on containers: %.2f us, compiled on bitsets: %.2f us (x%.1f), filtered bitsets: %.2f us, %d matches"),
+		NumContainers, QueryNanoseconds / 1000.0, ContainerNanoseconds / 1000.0, BitsetNanoseconds / 1000.0,
+		QueryNanoseconds / FMath::Max(BitsetNanoseconds, UE_DOUBLE_SMALL_NUMBER), FilterNanoseconds / 1000.0, NumMatches));
+	return true;
+}
+
+#endif
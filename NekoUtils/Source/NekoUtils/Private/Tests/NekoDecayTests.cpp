@@ -0,0 +1,124 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#include "Tests/NekoAutomationTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "NekoDecay.h"
+#include "NekoFunctionLibrary.h"
+
+#include "Math/RandomStream.h"
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNekoDecayBatchTest, "NekoUtils.Math.ExponentialDecay.Batch",
+	NEKO_AUTOMATION_TEST_CONTEXT | EAutomationTestFlags::EngineFilter)
+
+bool FNekoDecayBatchTest::RunTest(const FString& Parameters)
+{
+	constexpr float Decay = 16.0f;
+	constexpr float DeltaTime = 1.0f / 60.0f;
+
+	FRandomStream Random(42);
+
+	// Every size up to a few registers, so that sizes that don't fill the last register are covered
+	for (int32 Num = 0; Num <= 13; ++Num)
+	{
+		TArray<double> Values;
+		TArray<double> Targets;
+		TArray<double> Factors;
+		TArray<FVector> Vectors;
+		TArray<FVector> VectorTargets;
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Values.Add(Random.FRandRange(-1000.0f, 1000.0f));
+			Targets.Add(Random.FRandRange(-1000.0f, 1000.0f));
+			Factors.Add(Random.GetFraction());
+			Vectors.Add(Random.GetUnitVector() * 1000.0);
+			VectorTargets.Add(Random.GetUnitVector() * 1000.0);
+		}
+
+		const TArray<double> Decayed = UNekoFunctionLibrary::ExponentialDecay_DoubleArray(Values, Targets, Decay, DeltaTime);
+		const TArray<FVector> DecayedVectors = UNekoFunctionLibrary::ExponentialDecay_VectorArray(Vectors, VectorTargets, Decay, DeltaTime);
+
+		TArray<double> DecayedInPlace = Values;
+		UNekoFunctionLibrary::ExponentialDecayInPlace_DoubleArray(DecayedInPlace, Targets, Decay, DeltaTime);
+		TArray<FVector> DecayedVectorsInPlace = Vectors;
+		UNekoFunctionLibrary::ExponentialDecayInPlace_VectorArray(DecayedVectorsInPlace, VectorTargets, Decay, DeltaTime);
+
+		TArray<double> DecayedPerFactor;
+		DecayedPerFactor.SetNumUninitialized(Num);
+		NekoDecay::Apply(Values.GetData(), Targets.GetData(), Factors.GetData(), DecayedPerFactor.GetData(), Num);
+
+		if (!TestEqual(TEXT("The batch returns a value per value"), Decayed.Num(), Num)
+			|| !TestEqual(TEXT("The batch returns a vector per vector"), DecayedVectors.Num(), Num))
+		{
+			return false;
+		}
+
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			const double Expected = UNekoFunctionLibrary::ExponentialDecay_Double(Values[Index], Targets[Index], Decay, DeltaTime);
+			const FVector ExpectedVector = UNekoFunctionLibrary::ExponentialDecay_Vector(Vectors[Index], VectorTargets[Index], Decay, DeltaTime);
+			const double ExpectedPerFactor = Targets[Index] + (Values[Index] - Targets[Index]) * Factors[Index];
+
+			if (!FMath::IsNearlyEqual(Decayed[Index], Expected, UE_KINDA_SMALL_NUMBER)
+				|| !FMath::IsNearlyEqual(DecayedInPlace[Index], Expected, UE_KINDA_SMALL_NUMBER)
+				|| !FMath::IsNearlyEqual(DecayedPerFactor[Index], ExpectedPerFactor, UE_KINDA_SMALL_NUMBER)
+				|| !DecayedVectors[Index].Equals(ExpectedVector, UE_KINDA_SMALL_NUMBER)
+				|| !DecayedVectorsInPlace[Index].Equals(ExpectedVector, UE_KINDA_SMALL_NUMBER))
+			{
+				AddError(FString::Printf(TEXT("Element %d of a batch of %d doesn't decay like a single value"), Index, Num));
+				return false;
+			}
+		}
+	}
+
+	// Mismatched sizes only decay the values that have a target
+	TArray<double> Values = { 10.0, 20.0, 30.0 };
+	const TArray<double> Targets = { 0.0, 0.0 };
+	AddExpectedError(TEXT("Tried to decay 3 values towards 2 targets"), EAutomationExpectedErrorFlags::Contains, 1);
+	UNekoFunctionLibrary::ExponentialDecayInPlace_DoubleArray(Values, Targets, Decay, DeltaTime);
+	TestTrue(TEXT("Values with a target are decayed"), Values[0] < 10.0 && Values[1] < 20.0);
+	TestEqual(TEXT("Values without a target are left as is"), Values[2], 30.0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNekoDecayBenchmark, "NekoUtils.Math.ExponentialDecay.Benchmark",
+	NEKO_AUTOMATION_TEST_CONTEXT | EAutomationTestFlags::PerfFilter)
+
+bool FNekoDecayBenchmark::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumVectors = 10000;
+	constexpr int32 NumRuns = 100;
+	constexpr float Decay = 16.0f;
+	constexpr float DeltaTime = 1.0f / 60.0f;
+
+	FRandomStream Random(42);
+	TArray<FVector> Targets;
+	TArray<FVector> ScalarValues;
+	for (int32 Index = 0; Index < NumVectors; ++Index)
+	{
+		Targets.Add(Random.GetUnitVector() * 1000.0);
+		ScalarValues.Add(Random.GetUnitVector() * 1000.0);
+	}
+	TArray<FVector> BatchedValues = ScalarValues;
+
+	const double ScalarNanoseconds = NekoAutomationTest::MeasureNanoseconds(NumRuns, [&]()
+	{
+		for (int32 Index = 0; Index < NumVectors; ++Index)
+		{
+			ScalarValues[Index] = UNekoFunctionLibrary::ExponentialDecay_Vector(ScalarValues[Index], Targets[Index], Decay, DeltaTime);
+		}
+	});
+	const double BatchedNanoseconds = NekoAutomationTest::MeasureNanoseconds(NumRuns, [&]()
+	{
+		NekoDecay::ExponentialDecay(BatchedValues, Targets, Decay, DeltaTime);
+	});
+
+	AddInfo(FString::Printf(TEXT("%d vectors, per element: %.2f us, batched: %.2f us (x%.1f)"), NumVectors,
+		ScalarNanoseconds / 1000.0, BatchedNanoseconds / 1000.0, ScalarNanoseconds / FMath::Max(BatchedNanoseconds, UE_DOUBLE_SMALL_NUMBER)));
+	return true;
+}
+
+#endif
@@ -0,0 +1,92 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#include "Tests/NekoAutomationTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/NekoTestObjects.h"
+#include "UI/NekoFocusedWidgetTracker.h"
+
+#include "Blueprint/UserWidget.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/Button.h"
+#include "Components/VerticalBox.h"
+#include "Engine/LocalPlayer.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Framework/Application/SlateUser.h"
+#include "Subsystems/SubsystemCollection.h"
+#include "UObject/Package.h"
+#include "Widgets/SWindow.h"
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNekoFocusedWidgetTrackerTest, "NekoUtils.UI.FocusedWidgetTracker",
+	NEKO_AUTOMATION_TEST_CONTEXT | EAutomationTestFlags::EngineFilter)
+
+bool FNekoFocusedWidgetTrackerTest::RunTest(const FString& Parameters)
+{
+	if (!FSlateApplication::IsInitialized())
+	{
+		AddWarning(TEXT("Slate isn't initialized, so nothing can be focused"));
+		return true;
+	}
+
+	FSlateApplication& SlateApplication = FSlateApplication::Get();
+
+	ULocalPlayer* LocalPlayer = NewObject<ULocalPlayer>(GetTransientPackage());
+	const TSharedPtr<FSlateUser> SlateUser = LocalPlayer->GetSlateUser();
+	if (!SlateUser.IsValid())
+	{
+		AddWarning(TEXT("The local player has no Slate user, so it can't focus anything"));
+		return true;
+	}
+
+	// Only the tracker is initialized, the other subsystems of the local player aren't needed
+	UNekoFocusedWidgetTracker* Tracker = NewObject<UNekoFocusedWidgetTracker>(LocalPlayer);
+	FSubsystemCollection<ULocalPlayerSubsystem> Collection;
+	Tracker->Initialize(Collection);
+
+	// A user widget with two buttons, shown in its own window so that Slate can find a path to them
+	UUserWidget* UserWidget = NewObject<UNekoTestUserWidget>(GetTransientPackage());
+	UserWidget->WidgetTree = NewObject<UWidgetTree>(UserWidget, NAME_None, RF_Transient);
+	UVerticalBox* Box = UserWidget->WidgetTree->ConstructWidget<UVerticalBox>();
+	UButton* FirstButton = UserWidget->WidgetTree->ConstructWidget<UButton>();
+	UButton* SecondButton = UserWidget->WidgetTree->ConstructWidget<UButton>();
+	Box->AddChildToVerticalBox(FirstButton);
+	Box->AddChildToVerticalBox(SecondButton);
+	UserWidget->WidgetTree->RootWidget = Box;
+
+	const TSharedRef<SWindow> Window = SNew(SWindow).ClientSize(FVector2D(200.0, 200.0));
+	Window->SetContent(UserWidget->TakeWidget());
+	SlateApplication.AddWindow(Window, false);
+	Window->SlatePrepass(1.0f);
+
+	const int32 UserIndex = SlateUser->GetUserIndex();
+	const int32 OtherUserIndex = UserIndex + 1;
+	const bool bOtherUserExisted = SlateApplication.GetUser(OtherUserIndex).IsValid();
+	SlateApplication.GetOrCreateUser(OtherUserIndex);
+
+	SlateApplication.SetUserFocus(UserIndex, FirstButton->GetCachedWidget(), EFocusCause::SetDirectly);
+	TestTrue(TEXT("The first button is focused"), Tracker->GetFocusedWidget() == FirstButton);
+
+	SlateApplication.SetUserFocus(UserIndex, SecondButton->GetCachedWidget(), EFocusCause::Navigation);
+	TestTrue(TEXT("The focus followed the player to the second button"), Tracker->GetFocusedWidget() == SecondButton);
+
+	SlateApplication.SetUserFocus(OtherUserIndex, FirstButton->GetCachedWidget(), EFocusCause::SetDirectly);
+	TestTrue(TEXT("Focusing with another user doesn't change the focused widget"), Tracker->GetFocusedWidget() == SecondButton);
+
+	SlateApplication.ClearUserFocus(UserIndex, EFocusCause::Cleared);
+	TestNull(TEXT("Clearing the focus forgets the focused widget"), Tracker->GetFocusedWidget());
+
+	SlateApplication.ClearUserFocus(OtherUserIndex, EFocusCause::Cleared);
+	if (!bOtherUserExisted)
+	{
+		SlateApplication.UnregisterUser(OtherUserIndex);
+	}
+
+	Tracker->Deinitialize();
+	SlateApplication.RequestDestroyWindow(Window);
+
+	return true;
+}
+
+#endif
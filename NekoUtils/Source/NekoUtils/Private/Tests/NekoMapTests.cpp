@@ -0,0 +1,174 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#include "Tests/NekoAutomationTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "NekoFunctionLibrary.h"
+
+#include "Kismet/BlueprintMapLibrary.h"
+
+
+namespace InternalNekoMapTests
+{
+	// The parameters of the Blueprint map nodes, which are what the thunks pass to the generic functions
+	template <typename PropertyType>
+	const PropertyType* FindParameter(const FName FunctionName, const FName ParameterName)
+	{
+		const UFunction* Function = UNekoFunctionLibrary::StaticClass()->FindFunctionByName(FunctionName);
+		return Function ? FindFProperty<PropertyType>(Function, ParameterName) : nullptr;
+	}
+
+	// Goes through the map with every function, which all have to return the elements in the same order as the map
+	void TestIteration(FAutomationTestBase& Test, const TCHAR* What, TMap<int32, int32>& Map, const FMapProperty* MapProp,
+		const FArrayProperty* KeysProp, const FArrayProperty* ValuesProp)
+	{
+		TArray<int32> ExpectedKeys;
+		TArray<int32> ExpectedValues;
+		for (const TPair<int32, int32>& Pair : Map)
+		{
+			ExpectedKeys.Add(Pair.Key);
+			ExpectedValues.Add(Pair.Value);
+		}
+
+		// Starts with an element, since the arrays must be replaced rather than appended to
+		TArray<int32> Keys = { -1 };
+		TArray<int32> Values = { -1 };
+		UNekoFunctionLibrary::GenericMap_ToArrays(&Map, MapProp, &Keys, KeysProp, &Values, ValuesProp);
+		Test.TestTrue(FString::Printf(TEXT("ToArrays returns the keys of %s"), What), Keys == ExpectedKeys);
+		Test.TestTrue(FString::Printf(TEXT("ToArrays returns the values of %s"), What), Values == ExpectedValues);
+
+		Keys.Reset();
+		Values.Reset();
+		int32 Cursor = 0;
+		int32 Key = 0;
+		int32 Value = 0;
+		while (UNekoFunctionLibrary::GenericMap_Next(&Map, MapProp, Cursor, &Key, &Value))
+		{
+			Keys.Add(Key);
+			Values.Add(Value);
+		}
+		Test.TestTrue(FString::Printf(TEXT("Next returns the keys of %s"), What), Keys == ExpectedKeys);
+		Test.TestTrue(FString::Printf(TEXT("Next returns the values of %s"), What), Values == ExpectedValues);
+		Test.TestFalse(FString::Printf(TEXT("Next keeps returning false once done with %s"), What),
+			UNekoFunctionLibrary::GenericMap_Next(&Map, MapProp, Cursor, &Key, &Value));
+
+		Keys.Reset();
+		Values.Reset();
+		for (int32 Index = 0; Index < Map.Num(); ++Index)
+		{
+			UNekoFunctionLibrary::GenericMap_Get(&Map, MapProp, Index, &Key, &Value);
+			Keys.Add(Key);
+			Values.Add(Value);
+		}
+		Test.TestTrue(FString::Printf(TEXT("Get returns the keys of %s"), What), Keys == ExpectedKeys);
+		Test.TestTrue(FString::Printf(TEXT("Get returns the values of %s"), What), Values == ExpectedValues);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNekoMapIterationTest, "NekoUtils.Map.Iteration",
+	NEKO_AUTOMATION_TEST_CONTEXT | EAutomationTestFlags::EngineFilter)
+
+bool FNekoMapIterationTest::RunTest(const FString& Parameters)
+{
+	using namespace InternalNekoMapTests;
+
+	const FName FunctionName = GET_FUNCTION_NAME_CHECKED(UNekoFunctionLibrary, Map_PairsToArrays);
+	const FMapProperty* MapProp = FindParameter<FMapProperty>(FunctionName, TEXT("TargetMap"));
+	const FArrayProperty* KeysProp = FindParameter<FArrayProperty>(FunctionName, TEXT("Keys"));
+	const FArrayProperty* ValuesProp = FindParameter<FArrayProperty>(FunctionName, TEXT("Values"));
+	if (!TestTrue(TEXT("The parameters of Map_PairsToArrays were found"), MapProp && KeysProp && ValuesProp))
+	{
+		return false;
+	}
+
+	TMap<int32, int32> Map;
+	TestIteration(*this, TEXT("an empty map"), Map, MapProp, KeysProp, ValuesProp);
+
+	for (int32 Index = 0; Index < 100; ++Index)
+	{
+		Map.Add(Index * 7, Index);
+	}
+	TestIteration(*this, TEXT("a map"), Map, MapProp, KeysProp, ValuesProp);
+
+	// Removing elements leaves holes in the storage, which every function has to skip
+	for (int32 Index = 0; Index < 100; Index += 3)
+	{
+		Map.Remove(Index * 7);
+	}
+	TestIteration(*this, TEXT("a map with holes"), Map, MapProp, KeysProp, ValuesProp);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNekoMapIterationBenchmark, "NekoUtils.Map.Iteration.Benchmark",
+	NEKO_AUTOMATION_TEST_CONTEXT | EAutomationTestFlags::PerfFilter)
+
+bool FNekoMapIterationBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace InternalNekoMapTests;
+
+	const FName FunctionName = GET_FUNCTION_NAME_CHECKED(UNekoFunctionLibrary, Map_PairsToArrays);
+	const FMapProperty* MapProp = FindParameter<FMapProperty>(FunctionName, TEXT("TargetMap"));
+	const FArrayProperty* KeysProp = FindParameter<FArrayProperty>(FunctionName, TEXT("Keys"));
+	const FArrayProperty* ValuesProp = FindParameter<FArrayProperty>(FunctionName, TEXT("Values"));
+	if (!TestTrue(TEXT("The parameters of Map_PairsToArrays were found"), MapProp && KeysProp && ValuesProp))
+	{
+		return false;
+	}
+
+	constexpr int32 NumElements = 10000;
+	TMap<int32, int32> Map;
+	for (int32 Index = 0; Index < NumElements; ++Index)
+	{
+		Map.Add(Index * 7, Index);
+	}
+
+	TArray<int32> Keys;
+	TArray<int32> Values;
+	int32 Key = 0;
+	int32 Value = 0;
+	int64 Sum = 0;
+	const double KeysFindNanoseconds = NekoAutomationTest::MeasureNanoseconds(10, [&]()
+	{
+		TArray<int32> MapKeys;
+		UBlueprintMapLibrary::GenericMap_Keys(&Map, MapProp, &MapKeys, KeysProp);
+		for (const int32 MapKey : MapKeys)
+		{
+			UBlueprintMapLibrary::GenericMap_Find(&Map, MapProp, &MapKey, &Value);
+			Sum += Value;
+		}
+	});
+	const double NextNanoseconds = NekoAutomationTest::MeasureNanoseconds(10, [&]()
+	{
+		int32 NextCursor = 0;
+		while (UNekoFunctionLibrary::GenericMap_Next(&Map, MapProp, NextCursor, &Key, &Value))
+		{
+			Sum += Value;
+		}
+	});
+	const double ToArraysNanoseconds = NekoAutomationTest::MeasureNanoseconds(10, [&]()
+	{
+		UNekoFunctionLibrary::GenericMap_ToArrays(&Map, MapProp, &Keys, KeysProp, &Values, ValuesProp);
+		for (const int32 ArrayValue : Values)
+		{
+			Sum += ArrayValue;
+		}
+	});
+	const double GetNanoseconds = NekoAutomationTest::MeasureNanoseconds(10, [&]()
+	{
+		for (int32 Index = 0; Index < NumElements; ++Index)
+		{
+			UNekoFunctionLibrary::GenericMap_Get(&Map, MapProp, Index, &Key, &Value);
+			Sum += Value;
+		}
+	});
+
+	AddInfo(FString::Printf(TEXT("%d elements, keys and find: %.2f us, next: %.2f us, to arrays: %.2f us, get: %.2f us, sum %lld"),
+		NumElements, KeysFindNanoseconds / 1000.0, NextNanoseconds / 1000.0, ToArraysNanoseconds / 1000.0,
+		GetNanoseconds / 1000.0, Sum));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,177 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#include "Tests/NekoAutomationTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "NekoLogCategories.h"
+#include "NekoTagBitset.h"
+
+#include "Math/RandomStream.h"
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNekoTagBitsetMatchTest, "NekoUtils.GameplayTags.TagBitset.Match",
+	NEKO_AUTOMATION_TEST_CONTEXT | EAutomationTestFlags::EngineFilter)
+
+bool FNekoTagBitsetMatchTest::RunTest(const FString& Parameters)
+{
+	using namespace NekoAutomationTest;
+
+	TArray<FGameplayTag> AllTags;
+	if (!GetGameplayTagsToTestWith(*this, AllTags))
+	{
+		return true;
+	}
+
+	TestFalse(TEXT("An empty bitset has no tag"), FNekoTagBitset().HasTag(AllTags[0]));
+	TestTrue(TEXT("An empty bitset has all the tags of an empty bitset"), FNekoTagBitset().HasAll(FNekoTagBitset()));
+	TestFalse(TEXT("An empty bitset has none of the tags of an empty bitset"), FNekoTagBitset().HasAny(FNekoTagBitset()));
+
+	// Empty containers and queries included, so that both ends of HasAny and HasAll are covered
+	FRandomStream Random(42);
+	for (int32 Run = 0; Run < 1000; ++Run)
+	{
+		const FGameplayTagContainer Container = MakeRandomContainer(Random, AllTags, Random.RandRange(0, 4));
+		const FGameplayTagContainer Query = MakeRandomContainer(Random, AllTags, Random.RandRange(0, 3));
+		const FNekoTagBitset Bitset(Container);
+		const FNekoTagBitset QueryBitset(Query);
+
+		const auto TestMatch = [&](const TCHAR* What, const bool bBitsetResult, const bool bContainerResult)
+		{
+			if (bBitsetResult != bContainerResult)
+			{
+				AddError(FString::Printf(TEXT("%s of [%s] against [%s] is %s for the bitset, %s for the container"), What,
+					*Container.ToStringSimple(), *Query.ToStringSimple(), bBitsetResult ? TEXT("true") : TEXT("false"),
+					bContainerResult ? TEXT("true") : TEXT("false")));
+				return false;
+			}
+			return true;
+		};
+
+		bool bMatches = TestMatch(TEXT("HasAny"), Bitset.HasAny(QueryBitset), Container.HasAny(Query))
+			&& TestMatch(TEXT("HasAll"), Bitset.HasAll(QueryBitset), Container.HasAll(Query))
+			&& TestMatch(TEXT("HasAnyExact"), Bitset.HasAnyExact(QueryBitset), Container.HasAnyExact(Query))
+			&& TestMatch(TEXT("HasAllExact"), Bitset.HasAllExact(QueryBitset), Container.HasAllExact(Query))
+			&& TestMatch(TEXT("=="), Bitset == QueryBitset, Container == Query);
+
+		for (const FGameplayTag& Tag : Query)
+		{
+			bMatches = bMatches
+				&& TestMatch(TEXT("HasTag"), Bitset.HasTag(Tag), Container.HasTag(Tag))
+				&& TestMatch(TEXT("HasTagExact"), Bitset.HasTagExact(Tag), Container.HasTagExact(Tag));
+		}
+
+		if (!bMatches)
+		{
+			return false;
+		}
+
+		if (Bitset.ToContainer() != Container)
+		{
+			AddError(FString::Printf(TEXT("The bitset of [%s] converts back to [%s]"), *Container.ToStringSimple(), *Bitset.ToContainer().ToStringSimple()));
+			return false;
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNekoTagBitsetStaleTest, "NekoUtils.GameplayTags.TagBitset.Stale",
+	NEKO_AUTOMATION_TEST_CONTEXT | EAutomationTestFlags::EngineFilter)
+
+bool FNekoTagBitsetStaleTest::RunTest(const FString& Parameters)
+{
+	TArray<FGameplayTag> AllTags;
+	if (!NekoAutomationTest::GetGameplayTagsToTestWith(*this, AllTags, 2))
+	{
+		return true;
+	}
+
+	const FGameplayTag& FirstTag = AllTags[0];
+	const FGameplayTag& SecondTag = AllTags[1];
+
+	FNekoTagBitset StaleBitset;
+	StaleBitset.AddTag(FirstTag);
+	TestTrue(TEXT("A new bitset is up to date"), StaleBitset.IsUpToDate());
+
+	// Like bitsets built before the tag tree changed
+	FNekoGameplayTagTestAccess::MakeStale(StaleBitset);
+	FNekoTagBitset OtherStaleBitset = StaleBitset;
+
+	FNekoTagBitset FreshBitset;
+	FreshBitset.AddTag(FirstTag);
+
+	// Stale bitsets log a warning only once per process, so it is silenced rather than expected
+	const ELogVerbosity::Type PreviousVerbosity = LogNekoUtils.GetVerbosity();
+	LogNekoUtils.SetVerbosity(ELogVerbosity::Error);
+
+	TestFalse(TEXT("A bitset built before the tree changed is stale"), StaleBitset.IsUpToDate());
+	TestTrue(TEXT("A bitset built after the tree changed is up to date"), FreshBitset.IsUpToDate());
+	TestFalse(TEXT("A stale bitset has no tag"), StaleBitset.HasTag(FirstTag));
+	TestFalse(TEXT("A stale bitset doesn't match an up to date one"), StaleBitset.HasAny(FreshBitset));
+	TestFalse(TEXT("An up to date bitset doesn't match a stale one"), FreshBitset.HasAll(StaleBitset));
+	TestTrue(TEXT("Stale bitsets of the same version still match each other"), StaleBitset == OtherStaleBitset);
+	TestTrue(TEXT("A stale bitset converts to an empty container"), StaleBitset.ToContainer().IsEmpty());
+	TestTrue(TEXT("An empty bitset is never stale"), FNekoTagBitset().IsUpToDate());
+
+	StaleBitset.AddTag(SecondTag);
+	TestTrue(TEXT("Adding a tag to a stale bitset makes it up to date"), StaleBitset.IsUpToDate());
+	TestTrue(TEXT("Adding a tag to a stale bitset drops its previous tags"), StaleBitset.ToContainer() == FGameplayTagContainer(SecondTag));
+
+	LogNekoUtils.SetVerbosity(PreviousVerbosity);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNekoTagBitsetBenchmark, "NekoUtils.GameplayTags.TagBitset.Benchmark",
+	NEKO_AUTOMATION_TEST_CONTEXT | EAutomationTestFlags::PerfFilter)
+
+bool FNekoTagBitsetBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace NekoAutomationTest;
+
+	TArray<FGameplayTag> AllTags;
+	if (!GetGameplayTagsToTestWith(*this, AllTags))
+	{
+		return true;
+	}
+
+	FRandomStream Random(42);
+	const FGameplayTagContainer Query = MakeRandomContainer(Random, AllTags, 2);
+	const FNekoTagBitset QueryBitset(Query);
+
+	for (const int32 NumContainers : { 100, 1000, 10000 })
+	{
+		TArray<FGameplayTagContainer> Containers;
+		TArray<FNekoTagBitset> Bitsets;
+		for (int32 Index = 0; Index < NumContainers; ++Index)
+		{
+			Containers.Add(MakeRandomContainer(Random, AllTags, 4));
+			Bitsets.Emplace(Containers.Last());
+		}
+
+		int32 NumMatches = 0;
+		const double ContainerNanoseconds = NekoAutomationTest::MeasureNanoseconds(100, [&]()
+		{
+			for (const FGameplayTagContainer& Container : Containers)
+			{
+				NumMatches += Container.HasAny(Query) + Container.HasAll(Query);
+			}
+		});
+		const double BitsetNanoseconds = NekoAutomationTest::MeasureNanoseconds(100, [&]()
+		{
+			for (const FNekoTagBitset& Bitset : Bitsets)
+			{
+				NumMatches += Bitset.HasAny(QueryBitset) + Bitset.HasAll(QueryBitset);
+			}
+		});
+
+		AddInfo(FString::Printf(TEXT("%d containers out of %d tags, containers: %.2f us, bitsets: %.2f us (x%.1f), %d matches"),
+			NumContainers, AllTags.Num(), ContainerNanoseconds / 1000.0, BitsetNanoseconds / 1000.0,
+			ContainerNanoseconds / FMath::Max(BitsetNanoseconds, UE_DOUBLE_SMALL_NUMBER), NumMatches));
+	}
+
+	return true;
+}
+
+#endif
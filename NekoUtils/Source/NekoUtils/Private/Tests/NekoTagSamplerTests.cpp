@@ -0,0 +1,155 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#include "Tests/NekoAutomationTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "NekoTagSampler.h"
+
+
+namespace InternalNekoTagSamplerTests
+{
+	// A container of the first tags of the project, in the same order
+	FGameplayTagContainer MakeContainer(const TArray<FGameplayTag>& AllTags, const int32 NumTags)
+	{
+		FGameplayTagContainer Container;
+		for (int32 Index = 0; Index < NumTags; ++Index)
+		{
+			Container.AddTag(AllTags[Index]);
+		}
+		return Container;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNekoTagSamplerWeightedTest, "NekoUtils.GameplayTags.TagSampler.Weighted",
+	NEKO_AUTOMATION_TEST_CONTEXT | EAutomationTestFlags::EngineFilter)
+
+bool FNekoTagSamplerWeightedTest::RunTest(const FString& Parameters)
+{
+	using namespace InternalNekoTagSamplerTests;
+
+	constexpr int32 NumDraws = 100000;
+
+	TArray<FGameplayTag> AllTags;
+	if (!NekoAutomationTest::GetGameplayTagsToTestWith(*this, AllTags, 3))
+	{
+		return true;
+	}
+
+	const FGameplayTagContainer Container = MakeContainer(AllTags, 3);
+	UNekoTagSampler* Sampler = UNekoTagSampler::CreateTagSampler(Container, { 1.0f, 3.0f, 0.0f }, ENekoTagSamplerMode::Weighted, 42);
+
+	TMap<FGameplayTag, int32> NumDrawn;
+	for (const FGameplayTag& Tag : Sampler->DrawTags(NumDraws))
+	{
+		++NumDrawn.FindOrAdd(Tag);
+	}
+
+	// About 7 standard deviations, the seed being fixed this only fails if the table is wrong
+	constexpr float Tolerance = 0.01f;
+	TestEqual(TEXT("Frequency of the tag of weight 1"), NumDrawn.FindRef(AllTags[0]) / static_cast<float>(NumDraws), 0.25f, Tolerance);
+	TestEqual(TEXT("Frequency of the tag of weight 3"), NumDrawn.FindRef(AllTags[1]) / static_cast<float>(NumDraws), 0.75f, Tolerance);
+	TestEqual(TEXT("Draws of the tag of weight 0"), NumDrawn.FindRef(AllTags[2]), 0);
+
+	// Tags without any weight are drawn like the others
+	UNekoTagSampler* UniformSampler = UNekoTagSampler::CreateTagSampler(Container, {}, ENekoTagSamplerMode::Weighted, 42);
+	NumDrawn.Reset();
+	for (const FGameplayTag& Tag : UniformSampler->DrawTags(NumDraws))
+	{
+		++NumDrawn.FindOrAdd(Tag);
+	}
+	for (int32 Index = 0; Index < 3; ++Index)
+	{
+		TestEqual(*FString::Printf(TEXT("Frequency of tag %d without weights"), Index), NumDrawn.FindRef(AllTags[Index]) / static_cast<float>(NumDraws), 1.0f / 3.0f, Tolerance);
+	}
+
+	UNekoTagSampler* EmptySampler = UNekoTagSampler::CreateTagSampler(FGameplayTagContainer(), {}, ENekoTagSamplerMode::Weighted, 42);
+	TestFalse(TEXT("An empty sampler draws an empty tag"), EmptySampler->DrawTag().IsValid());
+	TestTrue(TEXT("An empty sampler draws no tags"), EmptySampler->DrawTags(3).IsEmpty());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNekoTagSamplerShuffleBagTest, "NekoUtils.GameplayTags.TagSampler.ShuffleBag",
+	NEKO_AUTOMATION_TEST_CONTEXT | EAutomationTestFlags::EngineFilter)
+
+bool FNekoTagSamplerShuffleBagTest::RunTest(const FString& Parameters)
+{
+	using namespace InternalNekoTagSamplerTests;
+
+	constexpr int32 NumBags = 100;
+
+	TArray<FGameplayTag> AllTags;
+	if (!NekoAutomationTest::GetGameplayTagsToTestWith(*this, AllTags, 2))
+	{
+		return true;
+	}
+
+	// Small bags, so that the same tag often ends one bag and could start the next one
+	for (int32 NumTags = 2; NumTags <= FMath::Min(AllTags.Num(), 5); ++NumTags)
+	{
+		const FGameplayTagContainer Container = MakeContainer(AllTags, NumTags);
+		UNekoTagSampler* Sampler = UNekoTagSampler::CreateTagSampler(Container, {}, ENekoTagSamplerMode::ShuffleBag, NumTags);
+		const TArray<FGameplayTag> DrawnTags = Sampler->DrawTags(NumTags * NumBags);
+
+		for (int32 BagStart = 0; BagStart < DrawnTags.Num(); BagStart += NumTags)
+		{
+			FGameplayTagContainer BagTags;
+			for (int32 Index = BagStart; Index < BagStart + NumTags; ++Index)
+			{
+				BagTags.AddTag(DrawnTags[Index]);
+			}
+
+			if (BagTags.Num() != NumTags || !BagTags.HasAllExact(Container))
+			{
+				AddError(FString::Printf(TEXT("Bag %d of %d tags drew [%s]"), BagStart / NumTags, NumTags, *BagTags.ToStringSimple()));
+				return false;
+			}
+
+			if (BagStart > 0 && DrawnTags[BagStart] == DrawnTags[BagStart - 1])
+			{
+				AddError(FString::Printf(TEXT("Bag %d of %d tags starts with the last tag of the previous one"), BagStart / NumTags, NumTags));
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNekoTagSamplerSeedTest, "NekoUtils.GameplayTags.TagSampler.Seed",
+	NEKO_AUTOMATION_TEST_CONTEXT | EAutomationTestFlags::EngineFilter)
+
+bool FNekoTagSamplerSeedTest::RunTest(const FString& Parameters)
+{
+	using namespace InternalNekoTagSamplerTests;
+
+	constexpr int32 NumDraws = 100;
+
+	TArray<FGameplayTag> AllTags;
+	if (!NekoAutomationTest::GetGameplayTagsToTestWith(*this, AllTags, 2))
+	{
+		return true;
+	}
+
+	const FGameplayTagContainer Container = MakeContainer(AllTags, FMath::Min(AllTags.Num(), 5));
+	for (const ENekoTagSamplerMode Mode : { ENekoTagSamplerMode::Weighted, ENekoTagSamplerMode::ShuffleBag })
+	{
+		const TCHAR* ModeName = Mode == ENekoTagSamplerMode::Weighted ? TEXT("Weighted") : TEXT("Shuffle bag");
+
+		UNekoTagSampler* Sampler = UNekoTagSampler::CreateTagSampler(Container, { 1.0f, 2.0f }, Mode, 42);
+		UNekoTagSampler* SameSeedSampler = UNekoTagSampler::CreateTagSampler(Container, { 1.0f, 2.0f }, Mode, 42);
+		const TArray<FGameplayTag> DrawnTags = Sampler->DrawTags(NumDraws);
+		TestTrue(*FString::Printf(TEXT("%s: the same seed draws the same tags"), ModeName), SameSeedSampler->DrawTags(NumDraws) == DrawnTags);
+
+		Sampler->SetSeed(42);
+		TestTrue(*FString::Printf(TEXT("%s: setting the seed again draws the same tags"), ModeName), Sampler->DrawTags(NumDraws) == DrawnTags);
+
+		UNekoTagSampler* OtherSeedSampler = UNekoTagSampler::CreateTagSampler(Container, { 1.0f, 2.0f }, Mode, 43);
+		TestFalse(*FString::Printf(TEXT("%s: another seed draws other tags"), ModeName), OtherSeedSampler->DrawTags(NumDraws) == DrawnTags);
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,18 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#include "Tests/NekoTestObjects.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(NekoTestObjects)
+
+
+FLatentActionInfo UNekoTimelineTestObject::MakeLatentInfo(const int32 UUID)
+{
+	return FLatentActionInfo(0, UUID, GET_FUNCTION_NAME_STRING_CHECKED(UNekoTimelineTestObject, OnPseudoTimeline), this);
+}
+
+void UNekoTimelineTestObject::OnPseudoTimeline(int32 Linkage)
+{
+	FiredPins.Add(OutputPins);
+	FiredProgresses.Add(Progress);
+	FiredAlphas.Add(Alpha);
+}
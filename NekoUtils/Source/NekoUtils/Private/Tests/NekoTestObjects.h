@@ -0,0 +1,56 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#pragma once
+
+#include "NekoTimelineSubsystem.h"
+
+#include "Blueprint/UserWidget.h"
+
+#include "NekoTestObjects.generated.h"
+
+
+/**
+ * Callback target and target of the pseudo-timelines started by the automation tests, recording every pin they fire.
+ */
+UCLASS(Transient, HideDropdown)
+class UNekoTimelineTestObject final : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	// Latent info of a pseudo-timeline calling back into this object, with its own UUID
+	FLatentActionInfo MakeLatentInfo(const int32 UUID);
+
+	// Latent function of the pseudo-timelines, records the pin that was fired
+	UFUNCTION()
+	void OnPseudoTimeline(int32 Linkage);
+
+	// Output slots of the pseudo-timelines
+	EPseudoTimelineOutputPins OutputPins = EPseudoTimelineOutputPins::Update;
+	float Progress = 0.0f;
+	float Alpha = 0.0f;
+
+	// Every pin fired, with the progress and alpha of the slots at that time
+	TArray<EPseudoTimelineOutputPins> FiredPins;
+	TArray<float> FiredProgresses;
+	TArray<float> FiredAlphas;
+
+	// Properties driven by timeline targets. They have no Set<Property> function, so they are written in memory
+	UPROPERTY()
+	float DrivenFloat = 0.0f;
+
+	UPROPERTY()
+	FVector DrivenVector = FVector::ZeroVector;
+
+	UPROPERTY()
+	FLinearColor DrivenColor = FLinearColor::Transparent;
+};
+
+/**
+ * User widget that can be instantiated by the automation tests, UUserWidget being abstract.
+ */
+UCLASS(Transient, HideDropdown)
+class UNekoTestUserWidget final : public UUserWidget
+{
+	GENERATED_BODY()
+};
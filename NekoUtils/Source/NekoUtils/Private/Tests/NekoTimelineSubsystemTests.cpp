@@ -0,0 +1,505 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#include "Tests/NekoAutomationTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "NekoBakedCurve.h"
+#include "NekoFunctionLibrary.h"
+#include "NekoTimelineSubsystem.h"
+#include "Tests/NekoTestObjects.h"
+
+#include "Curves/CurveFloat.h"
+#include "Curves/CurveLinearColor.h"
+#include "Curves/CurveVector.h"
+#include "GameFramework/PlayerState.h"
+#include "GameFramework/WorldSettings.h"
+#include "Misc/App.h"
+#include "UObject/Package.h"
+
+
+namespace InternalNekoTimelineTests
+{
+	// Ticks of the same duration
+	TArray<float> MakeTicks(const int32 NumTicks, const float DeltaTime)
+	{
+		TArray<float> DeltaTimes;
+		DeltaTimes.Init(DeltaTime, NumTicks);
+		return DeltaTimes;
+	}
+
+	FNekoPseudoTimelineOptions MakeOptions(const ENekoPseudoTimelinePlayMode PlayMode, const int32 LoopCount = 0,
+		const bool bReverse = false, const float StartPosition = 0.0f)
+	{
+		FNekoPseudoTimelineOptions Options;
+		Options.PlayMode = PlayMode;
+		Options.LoopCount = LoopCount;
+		Options.bReverse = bReverse;
+		Options.StartPosition = StartPosition;
+		return Options;
+	}
+
+	// Starts a pseudo-timeline of one second without any curve, calling back into a new test object, and ticks the
+	// subsystem once per delta time
+	UNekoTimelineTestObject* PlayTimeline(UNekoTimelineSubsystem& Subsystem, const FNekoPseudoTimelineOptions& Options,
+		const TArray<float>& DeltaTimes)
+	{
+		UNekoTimelineTestObject* Object = NewObject<UNekoTimelineTestObject>(GetTransientPackage());
+		Subsystem.StartTimeline(Object->MakeLatentInfo(0), 1.0f, nullptr, Options, Object->OutputPins, Object->Progress, Object->Alpha, false);
+		for (const float DeltaTime : DeltaTimes)
+		{
+			Subsystem.Tick(DeltaTime);
+		}
+		return Object;
+	}
+
+	// Checks that the object received exactly one Update per expected progress, with an alpha equal to the progress since
+	// there is no curve, followed by Finished if expected
+	void TestUpdates(FAutomationTestBase& Test, const FString& What, const UNekoTimelineTestObject& Object,
+		const TArray<float>& ExpectedProgresses, const bool bExpectFinished)
+	{
+		const int32 NumExpectedPins = ExpectedProgresses.Num() + (bExpectFinished ? 1 : 0);
+		if (!Test.TestEqual(*(What + TEXT(": number of pins fired")), Object.FiredPins.Num(), NumExpectedPins))
+		{
+			return;
+		}
+
+		for (int32 Index = 0; Index < ExpectedProgresses.Num(); ++Index)
+		{
+			const FString Update = FString::Printf(TEXT("%s: Update %d"), *What, Index);
+			Test.TestTrue(*(Update + TEXT(" pin")), Object.FiredPins[Index] == EPseudoTimelineOutputPins::Update);
+			Test.TestEqual(*(Update + TEXT(" progress")), Object.FiredProgresses[Index], ExpectedProgresses[Index]);
+			Test.TestEqual(*(Update + TEXT(" alpha")), Object.FiredAlphas[Index], ExpectedProgresses[Index]);
+		}
+
+		if (bExpectFinished)
+		{
+			Test.TestTrue(*(What + TEXT(": last pin")), Object.FiredPins.Last() == EPseudoTimelineOutputPins::Finished);
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNekoTimelinePlayModesTest, "NekoUtils.PseudoTimeline.PlayModes",
+	NEKO_AUTOMATION_TEST_CONTEXT | EAutomationTestFlags::EngineFilter)
+
+bool FNekoTimelinePlayModesTest::RunTest(const FString& Parameters)
+{
+	using namespace InternalNekoTimelineTests;
+	using EPlayMode = ENekoPseudoTimelinePlayMode;
+
+	NekoAutomationTest::FScopedTestWorld World;
+	UNekoTimelineSubsystem* Subsystem = World->GetSubsystem<UNekoTimelineSubsystem>();
+	if (!TestNotNull(TEXT("Timeline subsystem"), Subsystem))
+	{
+		return false;
+	}
+
+	// Quarters of a second are exact in floating point, so every progress can be compared exactly. The last Update of a
+	// cycle gets the start of the next one, except for the last cycle which ends on its final value
+	TestUpdates(*this, TEXT("Once"), *PlayTimeline(*Subsystem, MakeOptions(EPlayMode::Once), MakeTicks(5, 0.25f)),
+		{ 0.25f, 0.5f, 0.75f, 1.0f }, true);
+	TestUpdates(*this, TEXT("Loop 2"), *PlayTimeline(*Subsystem, MakeOptions(EPlayMode::Loop, 2), MakeTicks(9, 0.25f)),
+		{ 0.25f, 0.5f, 0.75f, 0.0f, 0.25f, 0.5f, 0.75f, 1.0f }, true);
+	TestUpdates(*this, TEXT("PingPong 2"), *PlayTimeline(*Subsystem, MakeOptions(EPlayMode::PingPong, 2), MakeTicks(9, 0.25f)),
+		{ 0.25f, 0.5f, 0.75f, 1.0f, 0.75f, 0.5f, 0.25f, 0.0f }, true);
+
+	TestUpdates(*this, TEXT("Reverse"), *PlayTimeline(*Subsystem, MakeOptions(EPlayMode::Once, 0, true), MakeTicks(5, 0.25f)),
+		{ 0.75f, 0.5f, 0.25f, 0.0f }, true);
+	TestUpdates(*this, TEXT("Reverse loop 2"), *PlayTimeline(*Subsystem, MakeOptions(EPlayMode::Loop, 2, true), MakeTicks(9, 0.25f)),
+		{ 0.75f, 0.5f, 0.25f, 1.0f, 0.75f, 0.5f, 0.25f, 0.0f }, true);
+	TestUpdates(*this, TEXT("Reverse PingPong 2"), *PlayTimeline(*Subsystem, MakeOptions(EPlayMode::PingPong, 2, true), MakeTicks(9, 0.25f)),
+		{ 0.75f, 0.5f, 0.25f, 0.0f, 0.25f, 0.5f, 0.75f, 1.0f }, true);
+
+	TestUpdates(*this, TEXT("Start position"), *PlayTimeline(*Subsystem, MakeOptions(EPlayMode::Once, 0, false, 0.25f), MakeTicks(4, 0.25f)),
+		{ 0.5f, 0.75f, 1.0f }, true);
+	TestUpdates(*this, TEXT("Reverse start position"), *PlayTimeline(*Subsystem, MakeOptions(EPlayMode::Once, 0, true, 0.25f), MakeTicks(4, 0.25f)),
+		{ 0.5f, 0.25f, 0.0f }, true);
+
+	// Several cycles ending during the same tick, keeping the time past the end of the last one
+	TestUpdates(*this, TEXT("Loop 3 with long ticks"), *PlayTimeline(*Subsystem, MakeOptions(EPlayMode::Loop, 3), { 2.5f, 1.0f, 0.25f }),
+		{ 0.5f, 1.0f }, true);
+	TestUpdates(*this, TEXT("PingPong 4 with long ticks"), *PlayTimeline(*Subsystem, MakeOptions(EPlayMode::PingPong, 4), { 2.25f, 1.5f, 1.0f, 0.25f }),
+		{ 0.25f, 0.25f, 0.0f }, true);
+	TestUpdates(*this, TEXT("PingPong 3 past its end"), *PlayTimeline(*Subsystem, MakeOptions(EPlayMode::PingPong, 3), { 10.0f, 0.25f }),
+		{ 1.0f }, true);
+	TestUpdates(*this, TEXT("PingPong 2 past its end"), *PlayTimeline(*Subsystem, MakeOptions(EPlayMode::PingPong, 2), { 10.0f, 0.25f }),
+		{ 0.0f }, true);
+
+	const UNekoTimelineTestObject* EndlessObject = PlayTimeline(*Subsystem, MakeOptions(EPlayMode::Loop), { 10.25f, 10.0f });
+	TestUpdates(*this, TEXT("Endless loop"), *EndlessObject, { 0.25f, 0.25f }, false);
+	TestTrue(TEXT("An endless loop keeps running"), Subsystem->IsTimelineRunning(EndlessObject, 0));
+
+	// Retriggering resets the alpha of the last Update, so the first Update of the new run isn't skipped even though its
+	// alpha is the same as the last one
+	FNekoPseudoTimelineOptions SkippingOptions;
+	SkippingOptions.MinAlphaDelta = 0.6f;
+	UNekoTimelineTestObject* RetriggeredObject = PlayTimeline(*Subsystem, SkippingOptions, MakeTicks(3, 0.25f));
+	TestTrue(TEXT("Retriggered"), Subsystem->StartTimeline(RetriggeredObject->MakeLatentInfo(0), 1.0f, nullptr, SkippingOptions,
+		RetriggeredObject->OutputPins, RetriggeredObject->Progress, RetriggeredObject->Alpha, true));
+	Subsystem->Tick(0.25f);
+	TestUpdates(*this, TEXT("Retriggered"), *RetriggeredObject, { 0.25f, 0.25f }, false);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNekoTimelineTimeDomainsTest, "NekoUtils.PseudoTimeline.TimeDomains",
+	NEKO_AUTOMATION_TEST_CONTEXT | EAutomationTestFlags::EngineFilter)
+
+bool FNekoTimelineTimeDomainsTest::RunTest(const FString& Parameters)
+{
+	using namespace InternalNekoTimelineTests;
+
+	NekoAutomationTest::FScopedTestWorld World;
+	UNekoTimelineSubsystem* Subsystem = World->GetSubsystem<UNekoTimelineSubsystem>();
+	if (!TestNotNull(TEXT("Timeline subsystem"), Subsystem))
+	{
+		return false;
+	}
+
+	// The last Update is fired on the tick reaching the end, and Finished only on the next one
+	UNekoTimelineTestObject* OrderObject = PlayTimeline(*Subsystem, FNekoPseudoTimelineOptions(), MakeTicks(4, 0.25f));
+	TestUpdates(*this, TEXT("Before the end"), *OrderObject, { 0.25f, 0.5f, 0.75f, 1.0f }, false);
+	TestTrue(TEXT("Still running after the last Update"), Subsystem->IsTimelineRunning(OrderObject, 0));
+	Subsystem->Tick(0.25f);
+	TestUpdates(*this, TEXT("After the end"), *OrderObject, { 0.25f, 0.5f, 0.75f, 1.0f }, true);
+	TestFalse(TEXT("Not running once finished"), Subsystem->IsTimelineRunning(OrderObject, 0));
+
+	// The world's time, an actor's time dilated by its CustomTimeDilation, and the undilated application time of widgets
+	UNekoTimelineTestObject* WorldObject = NewObject<UNekoTimelineTestObject>(GetTransientPackage());
+	AActor* Actor = World->SpawnActor<AActor>();
+	Actor->CustomTimeDilation = 0.5f;
+	UNekoTimelineTestObject* ActorObject = NewObject<UNekoTimelineTestObject>(Actor);
+	UNekoTestUserWidget* Widget = NewObject<UNekoTestUserWidget>(GetTransientPackage());
+	EPseudoTimelineOutputPins WidgetOutputPins;
+	float WidgetProgress = 0.0f;
+	float WidgetAlpha = 0.0f;
+
+	for (UNekoTimelineTestObject* Object : { WorldObject, ActorObject })
+	{
+		Subsystem->StartTimeline(Object->MakeLatentInfo(0), 1.0f, nullptr, FNekoPseudoTimelineOptions(), Object->OutputPins, Object->Progress, Object->Alpha, false);
+	}
+	FLatentActionInfo WidgetLatentInfo;
+	WidgetLatentInfo.CallbackTarget = Widget;
+	Subsystem->StartTimeline(WidgetLatentInfo, 1.0f, nullptr, FNekoPseudoTimelineOptions(), WidgetOutputPins, WidgetProgress, WidgetAlpha, false);
+
+	// The world's delta time is already dilated when the subsystem is ticked, here by half
+	const double PreviousDeltaTime = FApp::GetDeltaTime();
+	FApp::SetDeltaTime(0.25);
+
+	Subsystem->Tick(0.125f);
+	TestEqual(TEXT("World time"), WorldObject->Progress, 0.125f);
+	TestEqual(TEXT("Actor time"), ActorObject->Progress, 0.0625f);
+	TestEqual(TEXT("Widget time"), WidgetProgress, 0.25f);
+
+	// Only widgets keep running, without the other pseudo-timelines firing any pin
+	APlayerState* Pauser = World->SpawnActor<APlayerState>();
+	World->GetWorldSettings()->SetPauserPlayerState(Pauser);
+	TestTrue(TEXT("The world is paused"), World->IsPaused());
+	Subsystem->Tick(0.125f);
+	TestEqual(TEXT("Paused world time"), WorldObject->Progress, 0.125f);
+	TestEqual(TEXT("Paused actor time"), ActorObject->Progress, 0.0625f);
+	TestEqual(TEXT("Paused widget time"), WidgetProgress, 0.5f);
+	TestEqual(TEXT("Pins fired while paused"), WorldObject->FiredPins.Num() + ActorObject->FiredPins.Num(), 2);
+
+	World->GetWorldSettings()->SetPauserPlayerState(nullptr);
+	Subsystem->Tick(0.125f);
+	TestEqual(TEXT("Unpaused world time"), WorldObject->Progress, 0.25f);
+	TestEqual(TEXT("Unpaused actor time"), ActorObject->Progress, 0.125f);
+	TestEqual(TEXT("Unpaused widget time"), WidgetProgress, 0.75f);
+
+	FApp::SetDeltaTime(PreviousDeltaTime);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNekoTimelineTargetTest, "NekoUtils.PseudoTimeline.Target",
+	NEKO_AUTOMATION_TEST_CONTEXT | EAutomationTestFlags::EngineFilter)
+
+bool FNekoTimelineTargetTest::RunTest(const FString& Parameters)
+{
+	using namespace InternalNekoTimelineTests;
+
+	NekoAutomationTest::FScopedTestWorld World;
+	UNekoTimelineSubsystem* Subsystem = World->GetSubsystem<UNekoTimelineSubsystem>();
+	if (!TestNotNull(TEXT("Timeline subsystem"), Subsystem))
+	{
+		return false;
+	}
+
+	// Overshoots B in the middle, so that the alpha of the curve is used rather than the progress
+	UCurveFloat* Curve = NewObject<UCurveFloat>(GetTransientPackage());
+	Curve->FloatCurve.AddKey(0.0f, 0.0f);
+	Curve->FloatCurve.AddKey(0.5f, 2.0f);
+	Curve->FloatCurve.AddKey(1.0f, 1.0f);
+	const TArray<float> Alphas = { 1.0f, 2.0f, 1.5f, 1.0f };
+
+	const FVector VectorB(4.0, 8.0, -4.0);
+	const FLinearColor ColorB(1.0f, 0.5f, 0.25f, 1.0f);
+
+	UNekoTimelineTestObject* Object = NewObject<UNekoTimelineTestObject>(GetTransientPackage());
+	const TArray<FNekoTimelineTarget> Targets =
+	{
+		UNekoFunctionLibrary::MakeTimelineTarget_FloatProperty(Object, GET_MEMBER_NAME_CHECKED(UNekoTimelineTestObject, DrivenFloat), 0.0, 10.0),
+		UNekoFunctionLibrary::MakeTimelineTarget_VectorProperty(Object, GET_MEMBER_NAME_CHECKED(UNekoTimelineTestObject, DrivenVector), FVector::ZeroVector, VectorB),
+		UNekoFunctionLibrary::MakeTimelineTarget_ColorProperty(Object, GET_MEMBER_NAME_CHECKED(UNekoTimelineTestObject, DrivenColor), FLinearColor::Transparent, ColorB)
+	};
+	for (int32 Index = 0; Index < Targets.Num(); ++Index)
+	{
+		TestTrue(TEXT("Property target started"), Subsystem->StartTargetTimeline(Object->MakeLatentInfo(Index), 1.0f, Curve, FNekoPseudoTimelineOptions(), Targets[Index], false));
+	}
+
+	// Written as soon as it starts, at the start of the curve
+	TestEqual(TEXT("Float at the start"), Object->DrivenFloat, 0.0f);
+
+	for (int32 Tick = 0; Tick < Alphas.Num(); ++Tick)
+	{
+		Subsystem->Tick(0.25f);
+
+		const float Alpha = Alphas[Tick];
+		const FString What = FString::Printf(TEXT("Tick %d"), Tick);
+		TestEqual(*(What + TEXT(" float")), Object->DrivenFloat, 10.0f * Alpha);
+		TestEqual(*(What + TEXT(" vector")), Object->DrivenVector, VectorB * Alpha);
+		TestEqual(*(What + TEXT(" color")), Object->DrivenColor, ColorB * Alpha);
+	}
+
+	// Target nodes only have their Finished pin, fired as soon as their last value is written
+	TestEqual(TEXT("Finished pins"), Object->FiredPins.Num(), Targets.Num());
+	TestEqual(TEXT("Float at the end"), Object->DrivenFloat, 10.0f);
+	TestEqual(TEXT("Vector at the end"), Object->DrivenVector, VectorB);
+	TestEqual(TEXT("Color at the end"), Object->DrivenColor, ColorB);
+
+	// A target destroyed while it is driven is left alone, and the node still finishes
+	UNekoTimelineTestObject* CallbackObject = NewObject<UNekoTimelineTestObject>(GetTransientPackage());
+	UNekoTimelineTestObject* DestroyedObject = NewObject<UNekoTimelineTestObject>(GetTransientPackage());
+	const FNekoTimelineTarget DestroyedTarget = UNekoFunctionLibrary::MakeTimelineTarget_FloatProperty(DestroyedObject,
+		GET_MEMBER_NAME_CHECKED(UNekoTimelineTestObject, DrivenFloat), 0.0, 10.0);
+	Subsystem->StartTargetTimeline(CallbackObject->MakeLatentInfo(0), 1.0f, nullptr, FNekoPseudoTimelineOptions(), DestroyedTarget, false);
+	Subsystem->Tick(0.25f);
+	TestEqual(TEXT("Target before being destroyed"), DestroyedObject->DrivenFloat, 2.5f);
+
+	DestroyedObject->MarkAsGarbage();
+	DestroyedObject->DrivenFloat = -1.0f;
+	for (int32 Tick = 0; Tick < 3; ++Tick)
+	{
+		Subsystem->Tick(0.25f);
+	}
+	TestEqual(TEXT("Destroyed target"), DestroyedObject->DrivenFloat, -1.0f);
+	TestEqual(TEXT("Finished pin with a destroyed target"), CallbackObject->FiredPins.Num(), 1);
+	TestFalse(TEXT("Running with a destroyed target"), Subsystem->IsTimelineRunning(CallbackObject, 0));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNekoTimelineUpdateThrottlingTest, "NekoUtils.PseudoTimeline.UpdateThrottling",
+	NEKO_AUTOMATION_TEST_CONTEXT | EAutomationTestFlags::EngineFilter)
+
+bool FNekoTimelineUpdateThrottlingTest::RunTest(const FString& Parameters)
+{
+	using namespace InternalNekoTimelineTests;
+
+	NekoAutomationTest::FScopedTestWorld World;
+	UNekoTimelineSubsystem* Subsystem = World->GetSubsystem<UNekoTimelineSubsystem>();
+	if (!TestNotNull(TEXT("Timeline subsystem"), Subsystem))
+	{
+		return false;
+	}
+
+	// Ticked by eighths of a second: the first Update always goes through, then one every half second, and the last one
+	// goes through before Finished even though it comes too early
+	FNekoPseudoTimelineOptions RateOptions;
+	RateOptions.MaxUpdateRate = 2.0f;
+	TestUpdates(*this, TEXT("Max update rate"), *PlayTimeline(*Subsystem, RateOptions, MakeTicks(9, 0.125f)),
+		{ 0.125f, 0.625f, 1.0f }, true);
+
+	// Same for the alpha, which has to change by 0.3 since the last Update
+	FNekoPseudoTimelineOptions AlphaOptions;
+	AlphaOptions.MinAlphaDelta = 0.3f;
+	TestUpdates(*this, TEXT("Min alpha delta"), *PlayTimeline(*Subsystem, AlphaOptions, MakeTicks(9, 0.125f)),
+		{ 0.125f, 0.5f, 0.875f, 1.0f }, true);
+
+	// Targets are throttled too, and still end on their final value before Finished
+	UNekoTimelineTestObject* TargetObject = NewObject<UNekoTimelineTestObject>(GetTransientPackage());
+	const FNekoTimelineTarget Target = UNekoFunctionLibrary::MakeTimelineTarget_FloatProperty(TargetObject,
+		GET_MEMBER_NAME_CHECKED(UNekoTimelineTestObject, DrivenFloat), 0.0, 10.0);
+	Subsystem->StartTargetTimeline(TargetObject->MakeLatentInfo(0), 1.0f, nullptr, RateOptions, Target, false);
+	for (int32 Tick = 0; Tick < 7; ++Tick)
+	{
+		Subsystem->Tick(0.125f);
+	}
+	TestEqual(TEXT("Throttled target"), TargetObject->DrivenFloat, 6.25f);
+	TestEqual(TEXT("Throttled target pins"), TargetObject->FiredPins.Num(), 0);
+
+	Subsystem->Tick(0.125f);
+	TestEqual(TEXT("Throttled target at the end"), TargetObject->DrivenFloat, 10.0f);
+	// Target nodes only have their Finished pin, so they have no output pin slot telling which pin fired
+	TestEqual(TEXT("Throttled target finished"), TargetObject->FiredPins.Num(), 1);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNekoTimelineTypedOutputTest, "NekoUtils.PseudoTimeline.TypedOutput",
+	NEKO_AUTOMATION_TEST_CONTEXT | EAutomationTestFlags::EngineFilter)
+
+bool FNekoTimelineTypedOutputTest::RunTest(const FString& Parameters)
+{
+	constexpr float Alphas[] = { 0.0f, 0.5f, 1.0f };
+
+	FVector Vector;
+	const FNekoTimelineTypedOutput VectorOutput = FNekoTimelineTypedOutput::MakeVector(Vector, FVector::ZeroVector, FVector(2.0, 4.0, -6.0));
+	const FVector ExpectedVectors[] = { FVector::ZeroVector, FVector(1.0, 2.0, -3.0), FVector(2.0, 4.0, -6.0) };
+
+	FLinearColor Color;
+	const FNekoTimelineTypedOutput ColorOutput = FNekoTimelineTypedOutput::MakeLinearColor(Color, FLinearColor::Transparent, FLinearColor(1.0f, 0.5f, 0.25f, 1.0f));
+	const FLinearColor ExpectedColors[] = { FLinearColor::Transparent, FLinearColor(0.5f, 0.25f, 0.125f, 0.5f), FLinearColor(1.0f, 0.5f, 0.25f, 1.0f) };
+
+	// Slerped through the shortest path, which crosses 180 degrees instead of going back through 0
+	FRotator Rotator;
+	const FNekoTimelineTypedOutput RotatorOutput = FNekoTimelineTypedOutput::MakeRotator(Rotator, FRotator(0.0, 170.0, 0.0), FRotator(0.0, -170.0, 0.0));
+	const FRotator ExpectedRotators[] = { FRotator(0.0, 170.0, 0.0), FRotator(0.0, 180.0, 0.0), FRotator(0.0, -170.0, 0.0) };
+
+	FTransform Transform;
+	const FTransform TransformA(FRotator::ZeroRotator, FVector::ZeroVector, FVector::OneVector);
+	const FTransform TransformB(FRotator(0.0, 90.0, 0.0), FVector(10.0, 20.0, 30.0), FVector(3.0));
+	const FNekoTimelineTypedOutput TransformOutput = FNekoTimelineTypedOutput::MakeTransform(Transform, TransformA, TransformB);
+	const FTransform ExpectedTransforms[] = { TransformA, FTransform(FRotator(0.0, 45.0, 0.0), FVector(5.0, 10.0, 15.0), FVector(2.0)), TransformB };
+
+	// The progress is ignored when interpolating between endpoints
+	for (int32 Index = 0; Index < UE_ARRAY_COUNT(Alphas); ++Index)
+	{
+		const float Alpha = Alphas[Index];
+		const FString What = FString::Printf(TEXT("At alpha %.1f"), Alpha);
+
+		VectorOutput.Write(0.25f, Alpha);
+		TestEqual(*(What + TEXT(", vector")), Vector, ExpectedVectors[Index]);
+
+		ColorOutput.Write(0.25f, Alpha);
+		TestEqual(*(What + TEXT(", linear color")), Color, ExpectedColors[Index]);
+
+		RotatorOutput.Write(0.25f, Alpha);
+		TestTrue(*(What + TEXT(", rotator")), Rotator.Equals(ExpectedRotators[Index], UE_KINDA_SMALL_NUMBER));
+
+		TransformOutput.Write(0.25f, Alpha);
+		TestTrue(*(What + TEXT(", transform")), Transform.Equals(ExpectedTransforms[Index], UE_KINDA_SMALL_NUMBER));
+	}
+
+	// Curves are sampled at the progress instead, each channel with its own slope so that swapped channels are noticed
+	UCurveVector* VectorCurve = NewObject<UCurveVector>(GetTransientPackage());
+	UCurveLinearColor* ColorCurve = NewObject<UCurveLinearColor>(GetTransientPackage());
+	for (int32 Channel = 0; Channel < 4; ++Channel)
+	{
+		if (Channel < 3)
+		{
+			VectorCurve->FloatCurves[Channel].AddKey(0.0f, 0.0f);
+			VectorCurve->FloatCurves[Channel].AddKey(1.0f, Channel + 1.0f);
+		}
+		ColorCurve->FloatCurves[Channel].AddKey(0.0f, 0.0f);
+		ColorCurve->FloatCurves[Channel].AddKey(1.0f, Channel + 1.0f);
+	}
+
+	FNekoTimelineTypedOutput VectorCurveOutput = FNekoTimelineTypedOutput::MakeVector(Vector, VectorCurve);
+	FNekoTimelineTypedOutput ColorCurveOutput = FNekoTimelineTypedOutput::MakeLinearColor(Color, ColorCurve);
+
+	// Linear curves are baked exactly, so the lookup tables give the same values
+	for (const bool bBaked : { false, true })
+	{
+		VectorCurveOutput.BakedCurve = bBaked ? FNekoBakedCurveCache::Get().FindOrBake(VectorCurve) : nullptr;
+		ColorCurveOutput.BakedCurve = bBaked ? FNekoBakedCurveCache::Get().FindOrBake(ColorCurve) : nullptr;
+
+		for (const float Progress : Alphas)
+		{
+			const FString What = FString::Printf(TEXT("%s at progress %.1f"), bBaked ? TEXT("Baked curve") : TEXT("Curve"), Progress);
+
+			VectorCurveOutput.Write(Progress, 0.25f);
+			TestEqual(*(What + TEXT(", vector")), Vector, FVector(1.0, 2.0, 3.0) * Progress);
+
+			ColorCurveOutput.Write(Progress, 0.25f);
+			TestEqual(*(What + TEXT(", linear color")), Color, FLinearColor(1.0f, 2.0f, 3.0f, 4.0f) * Progress);
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNekoTimelinePoolStressTest, "NekoUtils.PseudoTimeline.PoolStress",
+	NEKO_AUTOMATION_TEST_CONTEXT | EAutomationTestFlags::StressFilter)
+
+bool FNekoTimelinePoolStressTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumTimelines = 100000;
+	constexpr int32 BatchSize = 1000;
+	constexpr float DeltaTime = 1.0f / 60.0f;
+
+	NekoAutomationTest::FScopedTestWorld World;
+	UNekoTimelineSubsystem* Subsystem = World->GetSubsystem<UNekoTimelineSubsystem>();
+	if (!TestNotNull(TEXT("Timeline subsystem"), Subsystem))
+	{
+		return false;
+	}
+
+	Subsystem->ReserveTimelines(BatchSize);
+	const int32 InitialPoolMisses = Subsystem->GetPoolStats().PoolMisses;
+
+	// Without any execution function, so that no pin is fired
+	FLatentActionInfo LatentInfo;
+	LatentInfo.CallbackTarget = NewObject<UObject>(GetTransientPackage());
+
+	// Shared by every pseudo-timeline, they are only written to
+	EPseudoTimelineOutputPins OutputPins;
+	float Progress;
+	float Alpha;
+	FVector Vector;
+	UNekoTimelineTestObject* TargetObject = NewObject<UNekoTimelineTestObject>(GetTransientPackage());
+	const FNekoTimelineTarget Target = UNekoFunctionLibrary::MakeTimelineTarget_FloatProperty(TargetObject,
+		GET_MEMBER_NAME_CHECKED(UNekoTimelineTestObject, DrivenFloat), 0.0, 1.0);
+	const FNekoTimelineTypedOutput TypedOutput = FNekoTimelineTypedOutput::MakeVector(Vector, FVector::ZeroVector, FVector::OneVector);
+
+	// Every kind of pseudo-timeline, so that the bindings and typed outputs are pooled too
+	const auto RunBatch = [&](const int32 Batch)
+	{
+		for (int32 Index = 0; Index < BatchSize; ++Index)
+		{
+			LatentInfo.UUID = Batch * BatchSize + Index;
+			switch (Index % 3)
+			{
+				case 0:
+					Subsystem->StartTimeline(LatentInfo, 0.0f, nullptr, FNekoPseudoTimelineOptions(), OutputPins, Progress, Alpha, false);
+					break;
+				case 1:
+					Subsystem->StartTypedTimeline(LatentInfo, 0.0f, nullptr, FNekoPseudoTimelineOptions(), TypedOutput, OutputPins, Progress, false);
+					break;
+				default:
+					Subsystem->StartTargetTimeline(LatentInfo, 0.0f, nullptr, FNekoPseudoTimelineOptions(), Target, false);
+					break;
+			}
+		}
+
+		// Timelines without any duration fire their last Update on the first tick, and Finished on the next one
+		Subsystem->Tick(DeltaTime);
+		Subsystem->Tick(DeltaTime);
+	};
+
+	// The first batch fills the free lists of the bindings and typed outputs, which are only reserved up front
+	RunBatch(0);
+
+	int32 NumAllocations = 0;
+	const double StartTime = FPlatformTime::Seconds();
+	{
+		const NekoAutomationTest::FScopedAllocationCounter AllocationCounter;
+		for (int32 Batch = 1; Batch < NumTimelines / BatchSize; ++Batch)
+		{
+			RunBatch(Batch);
+		}
+		NumAllocations = AllocationCounter.GetNumAllocations();
+	}
+	const double ElapsedTime = FPlatformTime::Seconds() - StartTime;
+
+	AddInfo(FString::Printf(TEXT("Started and finished %d pseudo-timelines in %.2f ms"), NumTimelines - BatchSize, ElapsedTime * 1000.0));
+
+	TestEqual(TEXT("Allocations once warmed up"), NumAllocations, 0);
+	TestEqual(TEXT("Live pseudo-timelines"), Subsystem->GetNumTimelines(), 0);
+	TestEqual(TEXT("Pool misses"), Subsystem->GetPoolStats().PoolMisses, InitialPoolMisses);
+	TestEqual(TEXT("Peak pseudo-timelines"), Subsystem->GetPoolStats().Peak, BatchSize);
+	TestEqual(TEXT("Driven property"), TargetObject->DrivenFloat, 1.0f);
+	return true;
+}
+
+#endif
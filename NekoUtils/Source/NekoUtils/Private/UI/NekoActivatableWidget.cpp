@@ -27,6 +27,12 @@ TOptional<FUIInputConfig> UNekoActivatableWidget::GetDesiredInputConfig() const
 	}
 }
 
+void UNekoActivatableWidget::ResetForPool()
+{
+	NativeResetForPool();
+	BP_ResetForPool();
+}
+
 #if WITH_EDITOR
 void UNekoActivatableWidget::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
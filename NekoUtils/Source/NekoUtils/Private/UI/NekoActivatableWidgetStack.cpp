@@ -0,0 +1,212 @@
+// All Rights Reserved (c) Juniper Bouchard
+
+#include "UI/NekoActivatableWidgetStack.h"
+
+#include "CommonActivatableWidget.h"
+#include "Slate/SCommonAnimatedSwitcher.h"
+#include "Widgets/SNullWidget.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(NekoActivatableWidgetStack)
+
+
+namespace InternalNekoActivatableWidgetStack
+{
+	int32 CountSlateWidgets(const TSharedRef<SWidget>& Widget)
+	{
+		int32 Count = 1;
+		if (FChildren* Children = Widget->GetChildren())
+		{
+			for (int32 Index = 0; Index < Children->Num(); ++Index)
+			{
+				Count += CountSlateWidgets(Children->GetChildAt(Index));
+			}
+		}
+		return Count;
+	}
+}
+
+UNekoActivatableWidgetStack::UNekoActivatableWidgetStack(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	if (!HasAnyFlags(RF_ClassDefaultObject))
+	{
+		OnDisplayedWidgetChanged().AddUObject(this, &UNekoActivatableWidgetStack::HandleDisplayedWidgetChanged);
+	}
+}
+
+void UNekoActivatableWidgetStack::ReleaseSlateResources(bool bReleaseChildren)
+{
+	Super::ReleaseSlateResources(bReleaseChildren);
+
+	// The switcher holding the released slots is gone, every widget is rebuilt with the stack
+	VirtualizedWidgets.Reset();
+	SlateDroppedPoolWidgets.Reset();
+}
+
+void UNekoActivatableWidgetStack::RestoreWidget(UCommonActivatableWidget& Widget)
+{
+	const int32 Index = GetWidgetList().IndexOfByKey(&Widget);
+	if (Index != INDEX_NONE)
+	{
+		RestoreWidgetAt(Index);
+	}
+}
+
+bool UNekoActivatableWidgetStack::IsWidgetVirtualized(const UCommonActivatableWidget* Widget) const
+{
+	return VirtualizedWidgets.Contains(Widget);
+}
+
+FNekoLayerVirtualizationReport UNekoActivatableWidgetStack::GetVirtualizationReport() const
+{
+	FNekoLayerVirtualizationReport Report;
+	Report.NumWidgets = GetNumWidgets();
+	Report.NumVirtualizedWidgets = VirtualizedWidgets.Num();
+	for (const TPair<TWeakObjectPtr<UCommonActivatableWidget>, int32>& VirtualizedWidget : VirtualizedWidgets)
+	{
+		Report.NumReleasedSlateWidgets += VirtualizedWidget.Value;
+	}
+	Report.NumReleases = NumReleases;
+	Report.NumRebuilds = NumRebuilds;
+	Report.NumPoolRebuilds = NumPoolRebuilds;
+	Report.AverageRebuildTime = NumRebuilds > 0 ? static_cast<float>(TotalRebuildTime / NumRebuilds * 1000.0) : 0.0f;
+	Report.MaxRebuildTime = static_cast<float>(MaxRebuildTime * 1000.0);
+	return Report;
+}
+
+void UNekoActivatableWidgetStack::OnWidgetAddedToList(UCommonActivatableWidget& AddedWidget)
+{
+	if (SlateDroppedPoolWidgets.Remove(&AddedWidget) > 0)
+	{
+		++NumPoolRebuilds;
+	}
+
+	// Only the widgets created by the widget pool of the stack have their Slate widget cached by it
+	if (bVirtualizeBuriedWidgets && GeneratedWidgetsPool.GetActiveWidgets().Contains(&AddedWidget))
+	{
+		PoolWidgets.Add(&AddedWidget);
+	}
+
+	Super::OnWidgetAddedToList(AddedWidget);
+
+	UpdateVirtualization();
+}
+
+void UNekoActivatableWidgetStack::HandleDisplayedWidgetChanged(UCommonActivatableWidget* DisplayedWidget)
+{
+	UpdateVirtualization();
+}
+
+void UNekoActivatableWidgetStack::UpdateVirtualization()
+{
+	if (!bVirtualizeBuriedWidgets && VirtualizedWidgets.IsEmpty())
+	{
+		return;
+	}
+
+	// Slots are matched to widgets by index, which only holds while the stack isn't releasing a widget
+	const int32 NumWidgets = GetNumWidgets();
+	if (!MySwitcher.IsValid() || MySwitcher->GetNumWidgets() != NumWidgets)
+	{
+		return;
+	}
+
+	const int32 LiveDepth = bVirtualizeBuriedWidgets ? FMath::Max(1, MaxLiveDepth) : NumWidgets;
+	for (int32 Index = 0; Index < NumWidgets; ++Index)
+	{
+		const int32 Depth = NumWidgets - 1 - Index;
+		if (Depth > LiveDepth)
+		{
+			VirtualizeWidgetAt(Index);
+		}
+		else
+		{
+			RestoreWidgetAt(Index);
+		}
+	}
+}
+
+void UNekoActivatableWidgetStack::VirtualizeWidgetAt(const int32 Index)
+{
+	UCommonActivatableWidget* Widget = GetWidgetList()[Index];
+	if (Widget == nullptr || Widget->IsActivated() || VirtualizedWidgets.Contains(Widget))
+	{
+		return;
+	}
+
+	SWidgetSwitcher::FSlot* Slot = MySwitcher.IsValid() ? MySwitcher->GetChildSlot(Index) : nullptr;
+	if (Slot == nullptr)
+	{
+		return;
+	}
+
+	const TWeakPtr<SWidget> WeakContent = Slot->GetWidget();
+	const int32 NumSlateWidgets = InternalNekoActivatableWidgetStack::CountSlateWidgets(Slot->GetWidget());
+
+	// Besides the slot, the widget pool of the container caches the Slate widget of every widget it created, and can
+	// only drop all of them at once. The widgets on the stack keep theirs through their slots, but the popped widgets
+	// waiting in the pool have to rebuild theirs when pushed again, which NumPoolRebuilds counts
+	Slot->AttachWidget(SNullWidget::NullWidget);
+	GeneratedWidgetsPool.ReleaseAllSlateResources();
+	ForgetPoolSlateWidgets();
+
+	if (const TSharedPtr<SWidget> Content = WeakContent.Pin())
+	{
+		// Still referenced from somewhere else, so the widget would lose its Slate state without freeing anything
+		Slot->AttachWidget(Content.ToSharedRef());
+		return;
+	}
+
+	VirtualizedWidgets.Add(Widget, NumSlateWidgets);
+	++NumReleases;
+}
+
+void UNekoActivatableWidgetStack::ForgetPoolSlateWidgets()
+{
+	const TArray<TObjectPtr<UCommonActivatableWidget>>& WidgetList = GetWidgetList();
+	for (auto It = PoolWidgets.CreateIterator(); It; ++It)
+	{
+		const UCommonActivatableWidget* Widget = It->Get();
+		if (Widget == nullptr)
+		{
+			It.RemoveCurrent();
+		}
+		else if (!WidgetList.Contains(Widget))
+		{
+			SlateDroppedPoolWidgets.Add(*It);
+			It.RemoveCurrent();
+		}
+	}
+
+	for (auto It = SlateDroppedPoolWidgets.CreateIterator(); It; ++It)
+	{
+		if (!It->IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UNekoActivatableWidgetStack::RestoreWidgetAt(const int32 Index)
+{
+	UCommonActivatableWidget* Widget = GetWidgetList()[Index];
+	if (Widget == nullptr || !VirtualizedWidgets.Contains(Widget))
+	{
+		return;
+	}
+
+	SWidgetSwitcher::FSlot* Slot = MySwitcher.IsValid() ? MySwitcher->GetChildSlot(Index) : nullptr;
+	if (Slot == nullptr)
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	Slot->AttachWidget(Widget->TakeWidget());
+	const double RebuildTime = FPlatformTime::Seconds() - StartTime;
+
+	VirtualizedWidgets.Remove(Widget);
+	++NumRebuilds;
+	TotalRebuildTime += RebuildTime;
+	MaxRebuildTime = FMath::Max(MaxRebuildTime, RebuildTime);
+}
@@ -0,0 +1,95 @@
+// All Rights Reserved (c) Juniper Bouchard
+
+#include "UI/NekoAsyncAction_PushWidgetToLayer.h"
+
+#include "NekoLogCategories.h"
+#include "UI/NekoRootUILayout.h"
+#include "UI/NekoUIManager.h"
+
+#include "Engine/LocalPlayer.h"
+#include "Engine/StreamableManager.h"
+#include "GameFramework/PlayerController.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(NekoAsyncAction_PushWidgetToLayer)
+
+
+UNekoAsyncAction_PushWidgetToLayer* UNekoAsyncAction_PushWidgetToLayer::PushWidgetToLayerForPlayerAsync(
+	APlayerController* OwningPlayer, const TSoftClassPtr<UCommonActivatableWidget> WidgetClass, const FGameplayTag LayerName,
+	const bool bSuspendInputUntilComplete, const bool bShowPlaceholder)
+{
+	if (OwningPlayer == nullptr || WidgetClass.IsNull())
+	{
+		UE_LOG(LogNekoUtils, Warning, TEXT("PushWidgetToLayerForPlayerAsync was passed a null OwningPlayer or WidgetClass"));
+		return nullptr;
+	}
+
+	UNekoAsyncAction_PushWidgetToLayer* Action = NewObject<UNekoAsyncAction_PushWidgetToLayer>();
+	Action->OwningPlayer = OwningPlayer;
+	Action->WidgetClass = WidgetClass;
+	Action->LayerName = LayerName;
+	Action->bSuspendInputUntilComplete = bSuspendInputUntilComplete;
+	Action->bShowPlaceholder = bShowPlaceholder;
+	Action->RegisterWithGameInstance(OwningPlayer);
+
+	return Action;
+}
+
+void UNekoAsyncAction_PushWidgetToLayer::Activate()
+{
+	const APlayerController* Player = OwningPlayer.Get();
+	const ULocalPlayer* LocalPlayer = Player ? Player->GetLocalPlayer() : nullptr;
+	const UNekoUIManager* UIManager = ULocalPlayer::GetSubsystem<UNekoUIManager>(LocalPlayer);
+	UNekoRootUILayout* RootLayout = UIManager ? UIManager->GetRootUILayout() : nullptr;
+	if (RootLayout == nullptr)
+	{
+		UE_LOG(LogNekoUtils, Warning, TEXT("[%s] found no root layout for player [%s]"), *GetName(), *GetNameSafe(Player));
+		Canceled.Broadcast(nullptr);
+		SetReadyToDestroy();
+		return;
+	}
+
+	TWeakObjectPtr<UNekoAsyncAction_PushWidgetToLayer> WeakThis = this;
+	PushingLayout = RootLayout;
+	StreamingHandle = RootLayout->PushWidgetToLayerStackAsync(LayerName, WidgetClass, bSuspendInputUntilComplete, bShowPlaceholder,
+		[WeakThis](const ENekoAsyncWidgetLayerState State, UCommonActivatableWidget* Widget)
+		{
+			UNekoAsyncAction_PushWidgetToLayer* This = WeakThis.Get();
+			if (This == nullptr)
+			{
+				return;
+			}
+
+			switch (State)
+			{
+			case ENekoAsyncWidgetLayerState::Initialize:
+				This->BeforePush.Broadcast(Widget);
+				break;
+			case ENekoAsyncWidgetLayerState::AfterPush:
+				This->AfterPush.Broadcast(Widget);
+				This->StreamingHandle.Reset();
+				This->SetReadyToDestroy();
+				break;
+			case ENekoAsyncWidgetLayerState::Canceled:
+				This->Canceled.Broadcast(nullptr);
+				This->StreamingHandle.Reset();
+				This->SetReadyToDestroy();
+				break;
+			}
+		});
+}
+
+void UNekoAsyncAction_PushWidgetToLayer::Cancel()
+{
+	Super::Cancel();
+
+	// Moved out first, since canceling the push calls back into the state function which resets it
+	const TSharedPtr<FStreamableHandle> Handle = MoveTemp(StreamingHandle);
+	if (UNekoRootUILayout* RootLayout = PushingLayout.Get())
+	{
+		RootLayout->CancelPendingPush(Handle);
+	}
+	else if (Handle.IsValid())
+	{
+		Handle->CancelHandle();
+	}
+}
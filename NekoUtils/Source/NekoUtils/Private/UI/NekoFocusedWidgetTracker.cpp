@@ -0,0 +1,141 @@
+// All Rights Reserved (c) Juniper Bouchard
+
+#include "UI/NekoFocusedWidgetTracker.h"
+
+#include "NekoLogCategories.h"
+
+#include "Blueprint/UserWidget.h"
+#include "Blueprint/WidgetTree.h"
+#include "Engine/LocalPlayer.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Framework/Application/SlateUser.h"
+#include "GameFramework/PlayerController.h"
+#include "Slate/SObjectWidget.h"
+#include "UObject/UObjectIterator.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(NekoFocusedWidgetTracker)
+
+
+#if !UE_BUILD_SHIPPING
+namespace InternalNekoFocusedWidgetTracker
+{
+	static bool bValidateFocusedWidget = false;
+	static FAutoConsoleVariableRef CVarValidateFocusedWidget(
+		TEXT("Neko.UI.ValidateFocusedWidget"),
+		bValidateFocusedWidget,
+		TEXT("Compares the widget focused according to UNekoFocusedWidgetTracker against a search through every widget, and logs a warning when they don't match. Slow!"));
+}
+#endif
+
+void UNekoFocusedWidgetTracker::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (FSlateApplication::IsInitialized())
+	{
+		FocusChangingHandle = FSlateApplication::Get().OnFocusChanging().AddUObject(this, &UNekoFocusedWidgetTracker::HandleFocusChanging);
+	}
+}
+
+void UNekoFocusedWidgetTracker::Deinitialize()
+{
+	if (FSlateApplication::IsInitialized())
+	{
+		FSlateApplication::Get().OnFocusChanging().Remove(FocusChangingHandle);
+	}
+
+	FocusedWidget.Reset();
+
+	Super::Deinitialize();
+}
+
+UWidget* UNekoFocusedWidgetTracker::GetFocusedWidget() const
+{
+	UWidget* Widget = FocusedWidget.Get();
+
+#if !UE_BUILD_SHIPPING
+	if (InternalNekoFocusedWidgetTracker::bValidateFocusedWidget)
+	{
+		const APlayerController* PlayerController = GetLocalPlayer()->GetPlayerController(GetWorld());
+
+		UWidget* FoundWidget = nullptr;
+		for (TObjectIterator<UWidget> It; It; ++It)
+		{
+			if (It->HasUserFocus(PlayerController))
+			{
+				FoundWidget = *It;
+				break;
+			}
+		}
+
+		if (FoundWidget != Widget)
+		{
+			UE_LOG(LogNekoUtils, Warning, TEXT("[%s] tracked [%s] as focused by [%s], but [%s] has its focus"), *GetName(), *GetNameSafe(Widget), *GetNameSafe(GetLocalPlayer()), *GetNameSafe(FoundWidget));
+		}
+	}
+#endif
+
+	return Widget;
+}
+
+void UNekoFocusedWidgetTracker::HandleFocusChanging(const FFocusEvent& FocusEvent,
+	const FWeakWidgetPath& OldFocusedWidgetPath, const TSharedPtr<SWidget>& OldFocusedWidget,
+	const FWidgetPath& NewFocusedWidgetPath, const TSharedPtr<SWidget>& NewFocusedWidget)
+{
+	const TSharedPtr<FSlateUser> SlateUser = GetLocalPlayer()->GetSlateUser();
+	if (!SlateUser.IsValid() || SlateUser->GetUserIndex() != static_cast<int32>(FocusEvent.GetUser()))
+	{
+		return;
+	}
+
+	FocusedWidget = NewFocusedWidget.IsValid() ? FindWidgetForPath(NewFocusedWidgetPath) : nullptr;
+}
+
+UWidget* UNekoFocusedWidgetTracker::FindWidgetForPath(const FWidgetPath& WidgetPath)
+{
+	static const FName ObjectWidgetType(TEXT("SObjectWidget"));
+
+	const FArrangedChildren& PathWidgets = WidgetPath.Widgets;
+
+	// The nearest user widget owns the tree in which the focused widget was created
+	for (int32 OwnerIndex = PathWidgets.Num() - 1; OwnerIndex >= 0; --OwnerIndex)
+	{
+		const TSharedRef<SWidget>& OwnerSlateWidget = PathWidgets[OwnerIndex].Widget;
+		if (OwnerSlateWidget->GetType() != ObjectWidgetType)
+		{
+			continue;
+		}
+
+		UUserWidget* UserWidget = StaticCastSharedRef<SObjectWidget>(OwnerSlateWidget)->GetWidgetObject();
+		if (UserWidget == nullptr || UserWidget->WidgetTree == nullptr || OwnerIndex == PathWidgets.Num() - 1)
+		{
+			return UserWidget;
+		}
+
+		// Keeps the deepest widget of the path below the user widget that has a matching UWidget
+		UWidget* DeepestWidget = UserWidget;
+		int32 DeepestIndex = OwnerIndex;
+		UserWidget->WidgetTree->ForEachWidget([&PathWidgets, &DeepestWidget, &DeepestIndex](UWidget* Widget)
+		{
+			const SWidget* CachedWidget = Widget->GetCachedWidget().Get();
+			if (CachedWidget == nullptr)
+			{
+				return;
+			}
+
+			for (int32 Index = PathWidgets.Num() - 1; Index > DeepestIndex; --Index)
+			{
+				if (&PathWidgets[Index].Widget.Get() == CachedWidget)
+				{
+					DeepestWidget = Widget;
+					DeepestIndex = Index;
+					break;
+				}
+			}
+		});
+
+		return DeepestWidget;
+	}
+
+	return nullptr;
+}
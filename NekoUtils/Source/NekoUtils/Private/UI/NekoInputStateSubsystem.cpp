@@ -0,0 +1,54 @@
+// All Rights Reserved (c) Juniper Bouchard
+
+#include "UI/NekoInputStateSubsystem.h"
+
+#include "NekoLogCategories.h"
+
+#include "CommonInputSubsystem.h"
+#include "Engine/LocalPlayer.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(NekoInputStateSubsystem)
+
+
+UNekoInputStateSubsystem* UNekoInputStateSubsystem::Get(const ULocalPlayer* LocalPlayer)
+{
+	return ULocalPlayer::GetSubsystem<UNekoInputStateSubsystem>(LocalPlayer);
+}
+
+void UNekoInputStateSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (UCommonInputSubsystem* InputSubsystem = Collection.InitializeDependency<UCommonInputSubsystem>())
+	{
+		CurrentInputType = InputSubsystem->GetCurrentInputType();
+		InputSubsystem->OnInputMethodChangedNative.AddUObject(this, &UNekoInputStateSubsystem::HandleInputMethodChanged);
+	}
+}
+
+void UNekoInputStateSubsystem::Deinitialize()
+{
+	if (UCommonInputSubsystem* InputSubsystem = UCommonInputSubsystem::Get(GetLocalPlayer()))
+	{
+		InputSubsystem->OnInputMethodChangedNative.RemoveAll(this);
+	}
+
+	OnInputTypeChangedNative.Clear();
+	OnInputTypeChanged.Clear();
+
+	Super::Deinitialize();
+}
+
+void UNekoInputStateSubsystem::HandleInputMethodChanged(ECommonInputType NewInputType)
+{
+	if (NewInputType == CurrentInputType)
+	{
+		return;
+	}
+
+	UE_LOG(LogNekoUtils, Verbose, TEXT("[%s] input type of player [%s] changed from [%s] to [%s]"), *GetName(), *GetNameSafe(GetLocalPlayer()), *UEnum::GetValueAsString(CurrentInputType), *UEnum::GetValueAsString(NewInputType));
+
+	CurrentInputType = NewInputType;
+	OnInputTypeChangedNative.Broadcast(NewInputType);
+	OnInputTypeChanged.Broadcast(NewInputType);
+}
@@ -0,0 +1,114 @@
+// All Rights Reserved (c) Juniper Bouchard
+
+#include "UI/NekoInputTypeVisibilityExtension.h"
+
+#include "UI/NekoInputStateSubsystem.h"
+
+#include "Blueprint/UserWidget.h"
+#include "Components/Widget.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(NekoInputTypeVisibilityExtension)
+
+
+void UNekoInputTypeVisibilityExtension::Construct()
+{
+	Super::Construct();
+
+	BindInputState();
+}
+
+void UNekoInputTypeVisibilityExtension::Destruct()
+{
+	if (UNekoInputStateSubsystem* InputStateSubsystem = InputState.Get())
+	{
+		InputStateSubsystem->OnInputTypeChangedNative.Remove(InputTypeChangedHandle);
+	}
+
+	InputState.Reset();
+	InputTypeChangedHandle.Reset();
+
+	Super::Destruct();
+}
+
+void UNekoInputTypeVisibilityExtension::AddBinding(UWidget* Widget, const int32 InputTypes,
+	const ESlateVisibility VisibleVisibility, const ESlateVisibility HiddenVisibility)
+{
+	if (Widget == nullptr)
+	{
+		return;
+	}
+
+	FBinding* Binding = Bindings.FindByPredicate([Widget](const FBinding& Other) { return Other.Widget == Widget; });
+	if (Binding == nullptr)
+	{
+		Binding = &Bindings.AddDefaulted_GetRef();
+		Binding->Widget = Widget;
+	}
+
+	Binding->InputTypes = InputTypes;
+	Binding->VisibleVisibility = VisibleVisibility;
+	Binding->HiddenVisibility = HiddenVisibility;
+
+	BindInputState();
+
+	if (const UNekoInputStateSubsystem* InputStateSubsystem = InputState.Get())
+	{
+		ApplyBinding(*Binding, InputStateSubsystem->GetCurrentInputType());
+	}
+}
+
+void UNekoInputTypeVisibilityExtension::RemoveBinding(const UWidget* Widget)
+{
+	const int32 Index = Bindings.IndexOfByPredicate([Widget](const FBinding& Binding) { return Binding.Widget == Widget; });
+	if (Index != INDEX_NONE)
+	{
+		Bindings.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	}
+}
+
+void UNekoInputTypeVisibilityExtension::BindInputState()
+{
+	if (InputState.IsValid())
+	{
+		return;
+	}
+
+	const UUserWidget* UserWidget = GetUserWidget();
+	UNekoInputStateSubsystem* InputStateSubsystem = UserWidget ? UNekoInputStateSubsystem::Get(UserWidget->GetOwningLocalPlayer()) : nullptr;
+	if (InputStateSubsystem == nullptr)
+	{
+		return;
+	}
+
+	InputState = InputStateSubsystem;
+	InputTypeChangedHandle = InputStateSubsystem->OnInputTypeChangedNative.AddUObject(this, &UNekoInputTypeVisibilityExtension::HandleInputTypeChanged);
+
+	// The input type may have changed while the widget wasn't constructed
+	HandleInputTypeChanged(InputStateSubsystem->GetCurrentInputType());
+}
+
+void UNekoInputTypeVisibilityExtension::HandleInputTypeChanged(ECommonInputType NewInputType)
+{
+	for (int32 Index = Bindings.Num() - 1; Index >= 0; --Index)
+	{
+		if (!Bindings[Index].Widget.IsValid())
+		{
+			Bindings.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		ApplyBinding(Bindings[Index], NewInputType);
+	}
+}
+
+void UNekoInputTypeVisibilityExtension::ApplyBinding(const FBinding& Binding, const ECommonInputType InputType)
+{
+	UWidget* Widget = Binding.Widget.Get();
+	if (Widget == nullptr)
+	{
+		return;
+	}
+
+	const bool bVisible = InputType != ECommonInputType::Count && (Binding.InputTypes & (1 << static_cast<int32>(InputType))) != 0;
+	Widget->SetVisibility(bVisible ? Binding.VisibleVisibility : Binding.HiddenVisibility);
+}
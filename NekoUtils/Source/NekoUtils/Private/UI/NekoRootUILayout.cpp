@@ -2,11 +2,27 @@
 
 #include "UI/NekoRootUILayout.h"
 
+#include "NekoStats.h"
+#include "UI/NekoActivatableWidget.h"
+#include "UI/NekoActivatableWidgetStack.h"
+#include "UI/NekoUITelemetrySubsystem.h"
+
+#include "Algo/AnyOf.h"
+#include "CommonInputSubsystem.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(NekoRootUILayout)
 
 
 DEFINE_LOG_CATEGORY_STATIC(LogNekoRootUILayout, Log, All);
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Widget Pool Hits"), STAT_NekoWidgetPoolHits, STATGROUP_NekoUtils);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Widget Pool Misses"), STAT_NekoWidgetPoolMisses, STATGROUP_NekoUtils);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Widgets Pushed To Layers"), STAT_NekoLayerPushes, STATGROUP_NekoUtils);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Widgets Removed From Layers"), STAT_NekoLayerRemovals, STATGROUP_NekoUtils);
+DECLARE_CYCLE_STAT(TEXT("Remove Widget From Layer"), STAT_NekoRemoveWidgetFromLayer, STATGROUP_NekoUtils);
+
 namespace NekoUILayers
 {
 	UE_DEFINE_GAMEPLAY_TAG_COMMENT(UI_Layer_Game, "UI.Layer.Game", "");
@@ -22,6 +38,12 @@ void UNekoRootUILayout::RegisterLayer(const FGameplayTag LayerTag, UCommonActiva
 		LayerWidget->SetTransitionDuration(0.0);
 
 		Layers.Add(LayerTag, LayerWidget);
+
+		const int32 NativeLayerIndex = GetNativeLayerIndex(LayerTag);
+		if (NativeLayerIndex != INDEX_NONE)
+		{
+			NativeLayers[NativeLayerIndex] = LayerWidget;
+		}
 	}
 }
 
@@ -36,6 +58,347 @@ UCommonActivatableWidget* UNekoRootUILayout::PushWidgetToLayerStack(const FGamep
 	return PushWidgetToLayerStack(LayerName, WidgetClass.LoadSynchronous());
 }
 
+TSharedPtr<FStreamableHandle> UNekoRootUILayout::PushWidgetToLayerStackAsync(const FGameplayTag LayerName,
+	const TSoftClassPtr<UCommonActivatableWidget> WidgetClass, const bool bSuspendInputUntilComplete, const bool bShowPlaceholder,
+	TFunction<void(ENekoAsyncWidgetLayerState, UCommonActivatableWidget*)> StateFunc)
+{
+	if (WidgetClass.IsNull())
+	{
+		UE_LOG(LogNekoRootUILayout, Warning, TEXT("No WidgetClass was provided to PushWidgetToLayerStackAsync"));
+		StateFunc(ENekoAsyncWidgetLayerState::Canceled, nullptr);
+		return nullptr;
+	}
+
+	const int32 PushId = NextPushId++;
+
+	FPendingPush PendingPush;
+	PendingPush.Id = PushId;
+	PendingPush.LayerName = LayerName;
+	PendingPush.StateFunc = StateFunc;
+	PendingPush.SuspendInputToken = bSuspendInputUntilComplete ? SuspendInput() : NAME_None;
+
+	if (bShowPlaceholder && PlaceholderWidgetClass)
+	{
+		PendingPush.Placeholder = PushPlaceholderToLayerStack(LayerName);
+	}
+
+	PendingPushes.Add(MoveTemp(PendingPush));
+
+	// Even resident classes complete on a later frame, so the push stays pending, and cancelable, until then
+	FStreamableManager& StreamableManager = UAssetManager::GetStreamableManager();
+	TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(WidgetClass.ToSoftObjectPath(), FStreamableDelegate::CreateWeakLambda(this,
+		[this, PushId, LayerName, WidgetClass]()
+		{
+			FPendingPush FinishedPush;
+			if (!FinishPendingPush(PushId, FinishedPush))
+			{
+				return;
+			}
+
+			UCommonActivatableWidget* Widget = PushWidgetToLayerStack<UCommonActivatableWidget>(LayerName, WidgetClass.Get(), [&FinishedPush](UCommonActivatableWidget& WidgetToInit)
+			{
+				FinishedPush.StateFunc(ENekoAsyncWidgetLayerState::Initialize, &WidgetToInit);
+			});
+
+			FinishedPush.StateFunc(Widget ? ENekoAsyncWidgetLayerState::AfterPush : ENekoAsyncWidgetLayerState::Canceled, Widget);
+		}),
+		FStreamableManager::AsyncLoadHighPriority);
+
+	if (!Handle.IsValid())
+	{
+		UE_LOG(LogNekoRootUILayout, Warning, TEXT("Failed to request the load of [%s] in PushWidgetToLayerStackAsync"), *WidgetClass.ToString());
+		CancelPendingPush(PushId);
+		return nullptr;
+	}
+
+	// Handles canceled by someone else, e.g. the streamable manager, cancel the push as well
+	Handle->BindCancelDelegate(FStreamableDelegate::CreateWeakLambda(this, [this, PushId]()
+	{
+		CancelPendingPush(PushId);
+	}));
+
+	if (FPendingPush* AddedPush = PendingPushes.FindByPredicate([PushId](const FPendingPush& Push) { return Push.Id == PushId; }))
+	{
+		AddedPush->Handle = Handle;
+	}
+
+	return Handle;
+}
+
+void UNekoRootUILayout::CancelPendingPushes(const FGameplayTag LayerName)
+{
+	// Canceling removes the push from the array
+	TArray<int32, TInlineAllocator<8>> PushIdsToCancel;
+	for (const FPendingPush& PendingPush : PendingPushes)
+	{
+		if (!LayerName.IsValid() || PendingPush.LayerName == LayerName)
+		{
+			PushIdsToCancel.Add(PendingPush.Id);
+		}
+	}
+
+	for (const int32 PushId : PushIdsToCancel)
+	{
+		CancelPendingPush(PushId);
+	}
+}
+
+void UNekoRootUILayout::CancelPendingPush(const TSharedPtr<FStreamableHandle>& Handle)
+{
+	if (!Handle.IsValid())
+	{
+		return;
+	}
+
+	if (const FPendingPush* PendingPush = PendingPushes.FindByPredicate([&Handle](const FPendingPush& Push) { return Push.Handle == Handle; }))
+	{
+		CancelPendingPush(PendingPush->Id);
+	}
+}
+
+void UNekoRootUILayout::PrewarmWidgetPool(const TSubclassOf<UCommonActivatableWidget> WidgetClass, const int32 Count)
+{
+	const int32 Capacity = GetPoolCapacity(WidgetClass);
+	if (Capacity <= 0)
+	{
+		UE_LOG(LogNekoRootUILayout, Warning, TEXT("[%s] can't prewarm the pool of [%s], it has no pool capacity"), *GetName(), *GetNameSafe(WidgetClass));
+		return;
+	}
+
+	FNekoWidgetPool& Pool = WidgetPools.FindOrAdd(WidgetClass);
+	const int32 TargetCount = FMath::Min(Count, Capacity);
+	while (Pool.Widgets.Num() < TargetCount)
+	{
+		UCommonActivatableWidget* Widget = CreatePooledWidget(WidgetClass);
+		if (Widget == nullptr)
+		{
+			return;
+		}
+
+		Pool.Widgets.Add(Widget);
+		Pool.SlateWidgets.Add(Widget->TakeWidget());
+	}
+}
+
+void UNekoRootUILayout::EmptyWidgetPools()
+{
+	// The pools themselves are kept, so that their hit and miss counters run across the flush
+	for (TPair<TObjectPtr<UClass>, FNekoWidgetPool>& Pair : WidgetPools)
+	{
+		Pair.Value.Widgets.Empty();
+		Pair.Value.SlateWidgets.Empty();
+	}
+}
+
+void UNekoRootUILayout::ResetWidgetPoolStats()
+{
+	for (TPair<TObjectPtr<UClass>, FNekoWidgetPool>& Pair : WidgetPools)
+	{
+		Pair.Value.Hits = 0;
+		Pair.Value.Misses = 0;
+	}
+}
+
+FNekoWidgetPoolStats UNekoRootUILayout::GetWidgetPoolStats(const TSubclassOf<UCommonActivatableWidget> WidgetClass) const
+{
+	FNekoWidgetPoolStats Stats;
+	Stats.Capacity = GetPoolCapacity(WidgetClass);
+
+	if (const FNekoWidgetPool* Pool = WidgetPools.Find(WidgetClass))
+	{
+		Stats.Pooled = Pool->Widgets.Num();
+		Stats.Hits = Pool->Hits;
+		Stats.Misses = Pool->Misses;
+	}
+
+	return Stats;
+}
+
+void UNekoRootUILayout::BeginDestroy()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(PoolReturnTickerHandle);
+	PoolReturnTickerHandle.Reset();
+
+	Super::BeginDestroy();
+}
+
+void UNekoRootUILayout::NativeDestruct()
+{
+	CancelPendingPushes(FGameplayTag());
+
+	Super::NativeDestruct();
+}
+
+int32 UNekoRootUILayout::GetPoolCapacity(const UClass* WidgetClass)
+{
+	const UNekoActivatableWidget* DefaultWidget = WidgetClass ? Cast<UNekoActivatableWidget>(WidgetClass->GetDefaultObject()) : nullptr;
+	return DefaultWidget ? DefaultWidget->GetPoolCapacity() : 0;
+}
+
+UCommonActivatableWidget* UNekoRootUILayout::AcquirePooledWidget(UClass* WidgetClass)
+{
+	if (GetPoolCapacity(WidgetClass) <= 0)
+	{
+		return nullptr;
+	}
+
+	FNekoWidgetPool& Pool = WidgetPools.FindOrAdd(WidgetClass);
+	while (!Pool.Widgets.IsEmpty())
+	{
+		UCommonActivatableWidget* Widget = Pool.Widgets.Pop(EAllowShrinking::No);
+		Pool.SlateWidgets.Pop(EAllowShrinking::No);
+		if (IsValid(Widget))
+		{
+			++Pool.Hits;
+			INC_DWORD_STAT(STAT_NekoWidgetPoolHits);
+			return Widget;
+		}
+	}
+
+	++Pool.Misses;
+	INC_DWORD_STAT(STAT_NekoWidgetPoolMisses);
+	return CreatePooledWidget(WidgetClass);
+}
+
+UCommonActivatableWidget* UNekoRootUILayout::CreatePooledWidget(UClass* WidgetClass)
+{
+	UCommonActivatableWidget* Widget = CreateWidget<UCommonActivatableWidget>(GetOwningPlayer(), WidgetClass);
+	if (Widget != nullptr)
+	{
+		Widget->OnDeactivated().AddUObject(this, &UNekoRootUILayout::HandlePooledWidgetDeactivated, TWeakObjectPtr<UCommonActivatableWidget>(Widget));
+	}
+
+	return Widget;
+}
+
+void UNekoRootUILayout::HandlePooledWidgetDeactivated(const TWeakObjectPtr<UCommonActivatableWidget> Widget)
+{
+	// Layers only remove their deactivated widgets once their transition is done, so wait for the next frame to know
+	// whether the widget was popped or only covered by another one
+	PendingPoolReturns.AddUnique(Widget);
+
+	if (!PoolReturnTickerHandle.IsValid())
+	{
+		PoolReturnTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateWeakLambda(this, [this](float)
+		{
+			PoolReturnTickerHandle.Reset();
+			ReturnPendingWidgetsToPool();
+			return false;
+		}));
+	}
+}
+
+void UNekoRootUILayout::ReturnPendingWidgetsToPool()
+{
+	for (const TWeakObjectPtr<UCommonActivatableWidget>& WeakWidget : PendingPoolReturns)
+	{
+		UCommonActivatableWidget* Widget = WeakWidget.Get();
+		if (Widget == nullptr || Widget->IsActivated())
+		{
+			continue;
+		}
+
+		const bool bOnLayer = Algo::AnyOf(Layers, [Widget](const TPair<FGameplayTag, TObjectPtr<UCommonActivatableWidgetContainerBase>>& Layer)
+		{
+			return Layer.Value->GetWidgetList().Contains(Widget);
+		});
+		if (bOnLayer)
+		{
+			continue;
+		}
+
+		FNekoWidgetPool& Pool = WidgetPools.FindOrAdd(Widget->GetClass());
+		if (Pool.Widgets.Num() >= GetPoolCapacity(Widget->GetClass()) || Pool.Widgets.Contains(Widget))
+		{
+			continue;
+		}
+
+		if (UNekoActivatableWidget* NekoWidget = Cast<UNekoActivatableWidget>(Widget))
+		{
+			NekoWidget->ResetForPool();
+		}
+
+		Pool.Widgets.Add(Widget);
+		Pool.SlateWidgets.Add(Widget->TakeWidget());
+	}
+
+	PendingPoolReturns.Reset();
+}
+
+FName UNekoRootUILayout::SuspendInput() const
+{
+	static const FName NAME_PushingWidgetToLayer(TEXT("PushingWidgetToLayer"));
+
+	UCommonInputSubsystem* InputSubsystem = UCommonInputSubsystem::Get(GetOwningLocalPlayer());
+	if (InputSubsystem == nullptr)
+	{
+		return NAME_None;
+	}
+
+	// Each push gets its own reason, so that pushes overlapping each other don't resume the input of the others
+	static int32 SuspendInputCount = 0;
+	const FName SuspendInputToken(NAME_PushingWidgetToLayer, ++SuspendInputCount);
+
+	InputSubsystem->SetInputTypeFilter(ECommonInputType::MouseAndKeyboard, SuspendInputToken, true);
+	InputSubsystem->SetInputTypeFilter(ECommonInputType::Gamepad, SuspendInputToken, true);
+	InputSubsystem->SetInputTypeFilter(ECommonInputType::Touch, SuspendInputToken, true);
+
+	return SuspendInputToken;
+}
+
+void UNekoRootUILayout::ResumeInput(const FName SuspendInputToken) const
+{
+	if (SuspendInputToken.IsNone())
+	{
+		return;
+	}
+
+	if (UCommonInputSubsystem* InputSubsystem = UCommonInputSubsystem::Get(GetOwningLocalPlayer()))
+	{
+		InputSubsystem->SetInputTypeFilter(ECommonInputType::MouseAndKeyboard, SuspendInputToken, false);
+		InputSubsystem->SetInputTypeFilter(ECommonInputType::Gamepad, SuspendInputToken, false);
+		InputSubsystem->SetInputTypeFilter(ECommonInputType::Touch, SuspendInputToken, false);
+	}
+}
+
+bool UNekoRootUILayout::FinishPendingPush(const int32 PushId, FPendingPush& OutPendingPush)
+{
+	const int32 Index = PendingPushes.IndexOfByPredicate([PushId](const FPendingPush& PendingPush) { return PendingPush.Id == PushId; });
+	if (Index == INDEX_NONE)
+	{
+		return false;
+	}
+
+	OutPendingPush = MoveTemp(PendingPushes[Index]);
+	PendingPushes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+	ResumeInput(OutPendingPush.SuspendInputToken);
+
+	if (UCommonActivatableWidget* PlaceholderWidget = OutPendingPush.Placeholder.Get())
+	{
+		FindAndRemoveWidgetFromLayer(PlaceholderWidget);
+	}
+
+	return true;
+}
+
+void UNekoRootUILayout::CancelPendingPush(const int32 PushId)
+{
+	FPendingPush CanceledPush;
+	if (!FinishPendingPush(PushId, CanceledPush))
+	{
+		return;
+	}
+
+	// Also drops the completion delegate of handles that already completed, but haven't called it yet
+	if (CanceledPush.Handle.IsValid())
+	{
+		CanceledPush.Handle->CancelHandle();
+	}
+
+	CanceledPush.StateFunc(ENekoAsyncWidgetLayerState::Canceled, nullptr);
+}
+
 void UNekoRootUILayout::PushWidgetInstanceToLayerStack(const FGameplayTag LayerName, UCommonActivatableWidget* Widget)
 {
 	if (!Widget)
@@ -46,20 +409,139 @@ void UNekoRootUILayout::PushWidgetInstanceToLayerStack(const FGameplayTag LayerN
 
 	if (UCommonActivatableWidgetContainerBase* Layer = GetLayerWidget(LayerName))
 	{
-		return Layer->AddWidgetInstance(*Widget);
+		const double PushStartTime = FPlatformTime::Seconds();
+		Layer->AddWidgetInstance(*Widget);
+		TrackWidgetLayer(Widget, Layer, PushStartTime);
 	}
 }
 
 void UNekoRootUILayout::FindAndRemoveWidgetFromLayer(UCommonActivatableWidget* ActivatableWidget)
 {
-	// We're not sure what layer the widget is on so go searching.
+	SCOPE_CYCLE_COUNTER(STAT_NekoRemoveWidgetFromLayer);
+
+	if (ActivatableWidget == nullptr)
+	{
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_NekoLayerRemovals);
+
+	TWeakObjectPtr<UCommonActivatableWidgetContainerBase> TrackedLayer;
+	if (WidgetLayers.RemoveAndCopyValue(ActivatableWidget, TrackedLayer))
+	{
+		if (UCommonActivatableWidgetContainerBase* Layer = TrackedLayer.Get())
+		{
+			RemoveWidgetFromLayer(*Layer, *ActivatableWidget);
+			return;
+		}
+	}
+
+	// Not pushed through this layout, so we're not sure what layer the widget is on so go searching.
 	for (const auto& Layer : Layers)
 	{
-		Layer.Value->RemoveWidget(*ActivatableWidget);
+		RemoveWidgetFromLayer(*Layer.Value, *ActivatableWidget);
+	}
+}
+
+FNekoLayerVirtualizationReport UNekoRootUILayout::GetLayerVirtualizationReport(const FGameplayTag LayerName) const
+{
+	if (const UNekoActivatableWidgetStack* Stack = Cast<UNekoActivatableWidgetStack>(GetLayerWidget(LayerName)))
+	{
+		return Stack->GetVirtualizationReport();
 	}
+
+	return FNekoLayerVirtualizationReport();
+}
+
+void UNekoRootUILayout::RemoveWidgetFromLayer(UCommonActivatableWidgetContainerBase& Layer, UCommonActivatableWidget& Widget)
+{
+	// Stacks can only remove widgets whose Slate widget exists
+	if (UNekoActivatableWidgetStack* Stack = Cast<UNekoActivatableWidgetStack>(&Layer))
+	{
+		Stack->RestoreWidget(Widget);
+	}
+
+	Layer.RemoveWidget(Widget);
 }
 
 UCommonActivatableWidgetContainerBase* UNekoRootUILayout::GetLayerWidget(const FGameplayTag LayerName) const
 {
+	const int32 NativeLayerIndex = GetNativeLayerIndex(LayerName);
+	if (NativeLayerIndex != INDEX_NONE)
+	{
+		return NativeLayers[NativeLayerIndex];
+	}
+
 	return Layers.FindRef(LayerName);
 }
+
+int32 UNekoRootUILayout::GetNativeLayerIndex(const FGameplayTag& LayerName)
+{
+	static_assert(UE_ARRAY_COUNT(NativeLayers) == 4, "NativeLayers must have a slot for each NekoUILayers tag");
+
+	if (LayerName == NekoUILayers::UI_Layer_Game)
+	{
+		return 0;
+	}
+	if (LayerName == NekoUILayers::UI_Layer_GameMenu)
+	{
+		return 1;
+	}
+	if (LayerName == NekoUILayers::UI_Layer_Menu)
+	{
+		return 2;
+	}
+	if (LayerName == NekoUILayers::UI_Layer_Modal)
+	{
+		return 3;
+	}
+	return INDEX_NONE;
+}
+
+UCommonActivatableWidget* UNekoRootUILayout::PushPlaceholderToLayerStack(const FGameplayTag LayerName)
+{
+	UCommonActivatableWidgetContainerBase* Layer = GetLayerWidget(LayerName);
+	if (Layer == nullptr)
+	{
+		return nullptr;
+	}
+
+	UCommonActivatableWidget* Widget = Layer->AddWidget<UCommonActivatableWidget>(PlaceholderWidgetClass);
+
+	// Not recorded, otherwise the widgets predicted to follow a screen would be the placeholder instead of the screen it stands for
+	TrackWidgetLayer(Widget, Layer, FPlatformTime::Seconds(), false);
+	return Widget;
+}
+
+void UNekoRootUILayout::TrackWidgetLayer(UCommonActivatableWidget* Widget, UCommonActivatableWidgetContainerBase* Layer,
+	const double PushStartTime, const bool bRecordPush)
+{
+	if (Widget == nullptr)
+	{
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_NekoLayerPushes);
+
+	UNekoUITelemetrySubsystem* Telemetry = bRecordPush ? UNekoUITelemetrySubsystem::Get(this) : nullptr;
+	if (Telemetry != nullptr)
+	{
+		Telemetry->RecordPush(Widget, PushStartTime);
+	}
+
+	WidgetLayers.Add(Widget, Layer);
+
+	// Popped widgets that were garbage collected are forgotten in batches, so that tracking stays amortized O(1)
+	if (WidgetLayers.Num() > WidgetLayersPruneThreshold)
+	{
+		for (auto It = WidgetLayers.CreateIterator(); It; ++It)
+		{
+			if (!It.Key().IsValid() || !It.Value().IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+
+		WidgetLayersPruneThreshold = FMath::Max(64, WidgetLayers.Num() * 2);
+	}
+}
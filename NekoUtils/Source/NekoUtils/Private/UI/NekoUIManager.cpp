@@ -3,21 +3,68 @@
 #include "UI/NekoUIManager.h"
 
 #include "NekoLogCategories.h"
+#include "NekoStats.h"
 #include "UI/NekoRootUILayout.h"
 
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(NekoUIManager)
 
 
+DECLARE_CYCLE_STAT(TEXT("Create Root Layout"), STAT_NekoCreateRootLayout, STATGROUP_NekoUtils);
+DECLARE_CYCLE_STAT(TEXT("Rebind Root Layout"), STAT_NekoRebindRootLayout, STATGROUP_NekoUtils);
+
+void UNekoUIManager::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	InitializeTime = FPlatformTime::Seconds();
+
+	// Requested first, the preloads have a lower priority anyway
+	RequestLayoutClassLoad();
+	RequestPreloadedClassesLoad();
+}
+
+void UNekoUIManager::Deinitialize()
+{
+	if (LayoutClassHandle.IsValid())
+	{
+		LayoutClassHandle->CancelHandle();
+		LayoutClassHandle.Reset();
+	}
+
+	if (PreloadedClassesHandle.IsValid())
+	{
+		PreloadedClassesHandle->CancelHandle();
+		PreloadedClassesHandle.Reset();
+	}
+
+	bCreateLayoutWhenLoaded = false;
+
+	Super::Deinitialize();
+}
+
 void UNekoUIManager::PlayerControllerChanged(APlayerController* NewPlayerController)
 {
 	Super::PlayerControllerChanged(NewPlayerController);
 
 	if (CurrentRootUILayout)
 	{
-		UE_LOG(LogNekoUtils, Log, TEXT("[%s] is refreshing the player context of player [%s]'s root layout [%s]"), *GetName(), *GetNameSafe(GetLocalPlayer()), *GetNameSafe(CurrentRootUILayout));
-		CurrentRootUILayout->RemoveFromParent();
+		SCOPE_CYCLE_COUNTER(STAT_NekoRebindRootLayout);
+		const double StartTime = FPlatformTime::Seconds();
+
+		CurrentRootUILayout->CancelPendingPushes(FGameplayTag());
+
+		// The player context resolves the player controller through the local player, so the layout only needs to be
+		// rebound, without tearing down its Slate hierarchy
 		CurrentRootUILayout->SetPlayerContext(FLocalPlayerContext(GetLocalPlayer()));
-		CurrentRootUILayout->AddToPlayerScreen(1000);
+		if (!CurrentRootUILayout->IsInViewport())
+		{
+			CurrentRootUILayout->AddToPlayerScreen(1000);
+		}
+
+		UE_LOG(LogNekoUtils, Log, TEXT("[%s] refreshed the player context of player [%s]'s root layout [%s] in %.2f ms"), *GetName(), *GetNameSafe(GetLocalPlayer()), *GetNameSafe(CurrentRootUILayout), (FPlatformTime::Seconds() - StartTime) * 1000.0);
 	}
 	else
 	{
@@ -35,13 +82,26 @@ void UNekoUIManager::CreateLayoutWidget()
 			return;
 		}
 
-		auto LayoutClass = DefaultRootUILayoutClass.LoadSynchronous();
-		if (ensure(LayoutClass && !LayoutClass->HasAnyClassFlags(CLASS_Abstract)))
+		auto LayoutClass = DefaultRootUILayoutClass.Get();
+		if (LayoutClass == nullptr)
+		{
+			// Created once the class is streamed in, instead of blocking the game thread on it
+			UE_LOG(LogNekoUtils, Log, TEXT("[%s] is waiting for the root layout class [%s] of player [%s] to load"), *GetName(), *DefaultRootUILayoutClass.ToString(), *GetNameSafe(LocalPlayer));
+			bCreateLayoutWhenLoaded = true;
+			RequestLayoutClassLoad();
+			return;
+		}
+
+		if (ensure(!LayoutClass->HasAnyClassFlags(CLASS_Abstract)))
 		{
+			SCOPE_CYCLE_COUNTER(STAT_NekoCreateRootLayout);
+			const double StartTime = FPlatformTime::Seconds();
+
 			CurrentRootUILayout = CreateWidget<UNekoRootUILayout>(PlayerController, LayoutClass);
 			CurrentRootUILayout->SetPlayerContext(FLocalPlayerContext(LocalPlayer));
 			CurrentRootUILayout->AddToPlayerScreen(1000);
-			UE_LOG(LogNekoUtils, Log, TEXT("[%s] is adding player [%s]'s root layout [%s] to the viewport"), *GetName(), *GetNameSafe(LocalPlayer), *GetNameSafe(CurrentRootUILayout));
+			const double EndTime = FPlatformTime::Seconds();
+			UE_LOG(LogNekoUtils, Log, TEXT("[%s] added player [%s]'s root layout [%s] to the viewport in %.2f ms, %.2f ms after the local player was created"), *GetName(), *GetNameSafe(LocalPlayer), *GetNameSafe(CurrentRootUILayout), (EndTime - StartTime) * 1000.0, (EndTime - InitializeTime) * 1000.0);
 #if WITH_EDITOR
 			if (GIsEditor && LocalPlayer->IsPrimaryPlayer())
 			{
@@ -52,3 +112,73 @@ void UNekoUIManager::CreateLayoutWidget()
 		}
 	}
 }
+
+void UNekoUIManager::RequestLayoutClassLoad()
+{
+	if (LayoutClassHandle.IsValid() || DefaultRootUILayoutClass.IsNull())
+	{
+		return;
+	}
+
+	LayoutLoadStartTime = FPlatformTime::Seconds();
+
+	FStreamableManager& StreamableManager = UAssetManager::GetStreamableManager();
+	LayoutClassHandle = StreamableManager.RequestAsyncLoad(DefaultRootUILayoutClass.ToSoftObjectPath(),
+		FStreamableDelegate::CreateUObject(this, &UNekoUIManager::HandleLayoutClassLoaded),
+		FStreamableManager::AsyncLoadHighPriority);
+}
+
+void UNekoUIManager::RequestPreloadedClassesLoad()
+{
+	if (PreloadedClassesHandle.IsValid())
+	{
+		return;
+	}
+
+	TArray<FSoftObjectPath> ClassPaths;
+	for (const TSoftClassPtr<UCommonActivatableWidget>& WidgetClass : PreloadedWidgetClasses)
+	{
+		if (!WidgetClass.IsNull())
+		{
+			ClassPaths.Add(WidgetClass.ToSoftObjectPath());
+		}
+	}
+
+	if (ClassPaths.IsEmpty())
+	{
+		return;
+	}
+
+	PreloadStartTime = FPlatformTime::Seconds();
+
+	FStreamableManager& StreamableManager = UAssetManager::GetStreamableManager();
+	PreloadedClassesHandle = StreamableManager.RequestAsyncLoad(MoveTemp(ClassPaths),
+		FStreamableDelegate::CreateUObject(this, &UNekoUIManager::HandlePreloadedClassesLoaded),
+		FStreamableManager::DefaultAsyncLoadPriority);
+}
+
+void UNekoUIManager::HandleLayoutClassLoaded()
+{
+	if (DefaultRootUILayoutClass.Get() == nullptr)
+	{
+		UE_LOG(LogNekoUtils, Error, TEXT("[%s] failed to load the root layout class [%s] of player [%s], it will be requested again on the next player controller change"), *GetName(), *DefaultRootUILayoutClass.ToString(), *GetNameSafe(GetLocalPlayer()));
+
+		// Released, so that the next CreateLayoutWidget requests it again instead of waiting on a failed handle
+		LayoutClassHandle.Reset();
+		bCreateLayoutWhenLoaded = false;
+		return;
+	}
+
+	UE_LOG(LogNekoUtils, Log, TEXT("[%s] streamed the root layout class [%s] of player [%s] in %.2f ms"), *GetName(), *DefaultRootUILayoutClass.ToString(), *GetNameSafe(GetLocalPlayer()), (FPlatformTime::Seconds() - LayoutLoadStartTime) * 1000.0);
+
+	if (bCreateLayoutWhenLoaded && CurrentRootUILayout == nullptr)
+	{
+		bCreateLayoutWhenLoaded = false;
+		CreateLayoutWidget();
+	}
+}
+
+void UNekoUIManager::HandlePreloadedClassesLoaded()
+{
+	UE_LOG(LogNekoUtils, Log, TEXT("[%s] streamed %d preloaded widget classes of player [%s] in %.2f ms"), *GetName(), PreloadedWidgetClasses.Num(), *GetNameSafe(GetLocalPlayer()), (FPlatformTime::Seconds() - PreloadStartTime) * 1000.0);
+}
@@ -0,0 +1,269 @@
+// All Rights Reserved (c) Juniper Bouchard
+
+#include "UI/NekoUITelemetrySubsystem.h"
+
+#include "NekoLogCategories.h"
+
+#include "CommonActivatableWidget.h"
+#include "Engine/AssetManager.h"
+#include "Engine/GameInstance.h"
+#include "Engine/StreamableManager.h"
+#include "JsonObjectConverter.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(NekoUITelemetrySubsystem)
+
+
+UNekoUITelemetrySubsystem* UNekoUITelemetrySubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UNekoUITelemetrySubsystem>() : nullptr;
+}
+
+bool UNekoUITelemetrySubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return !IsRunningDedicatedServer() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UNekoUITelemetrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (!bEnableTelemetry)
+	{
+		return;
+	}
+
+	LoadProfile();
+
+	TArray<const FNekoUIClassTelemetry*> SortedClasses;
+	for (const FNekoUIClassTelemetry& ClassTelemetry : Profile.Classes)
+	{
+		SortedClasses.Add(&ClassTelemetry);
+	}
+	SortedClasses.Sort([](const FNekoUIClassTelemetry& A, const FNekoUIClassTelemetry& B) { return A.PushCount > B.PushCount; });
+
+	for (int32 Index = 0; Index < FMath::Min(MaxPreloadedClasses, SortedClasses.Num()); ++Index)
+	{
+		QueuePreload(SortedClasses[Index]->ClassPath, false);
+	}
+}
+
+void UNekoUITelemetrySubsystem::Deinitialize()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(PreloadTickerHandle);
+	PreloadTickerHandle.Reset();
+
+	for (const TSharedPtr<FStreamableHandle>& Handle : PreloadHandles)
+	{
+		Handle->ReleaseHandle();
+	}
+	PreloadHandles.Reset();
+	PreloadQueue.Reset();
+
+	if (bEnableTelemetry)
+	{
+		SaveProfile();
+	}
+
+	Super::Deinitialize();
+}
+
+void UNekoUITelemetrySubsystem::RecordPush(UCommonActivatableWidget* Widget, const double PushStartTime)
+{
+	if (!bEnableTelemetry || Widget == nullptr)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	const FString ClassPath = Widget->GetClass()->GetPathName();
+
+	if (!LastPushedClassPath.IsEmpty())
+	{
+		++FindOrAddClassTelemetry(LastPushedClassPath).NextClasses.FindOrAdd(ClassPath);
+	}
+	LastPushedClassPath = ClassPath;
+
+	FNekoUIClassTelemetry& ClassTelemetry = FindOrAddClassTelemetry(ClassPath);
+	++ClassTelemetry.PushCount;
+	ClassTelemetry.TotalConstructTime += Now - PushStartTime;
+
+	// Layers without transitions can activate the widget while adding it
+	if (Widget->IsActivated())
+	{
+		++ClassTelemetry.ActivationCount;
+		ClassTelemetry.TotalActivateTime += Now - PushStartTime;
+	}
+	else
+	{
+		RemoveDestroyedWidgets();
+
+		PendingActivations.Add(Widget, PushStartTime);
+		if (!BoundWidgets.Contains(Widget))
+		{
+			BoundWidgets.Add(Widget);
+			Widget->OnActivated().AddUObject(this, &UNekoUITelemetrySubsystem::HandleWidgetActivated, TWeakObjectPtr<UCommonActivatableWidget>(Widget));
+		}
+	}
+
+	// The classes that usually follow this one, most frequent first
+	TArray<TPair<FString, int32>> NextClasses = ClassTelemetry.NextClasses.Array();
+	NextClasses.Sort([](const TPair<FString, int32>& A, const TPair<FString, int32>& B) { return A.Value > B.Value; });
+	for (int32 Index = FMath::Min(MaxPredictedClasses, NextClasses.Num()) - 1; Index >= 0; --Index)
+	{
+		QueuePreload(NextClasses[Index].Key, true);
+	}
+}
+
+void UNekoUITelemetrySubsystem::SaveProfile() const
+{
+	FString Json;
+	if (!FJsonObjectConverter::UStructToJsonObjectString(Profile, Json))
+	{
+		UE_LOG(LogNekoUtils, Warning, TEXT("[%s] failed to serialize the UI telemetry profile"), *GetName());
+		return;
+	}
+
+	if (!FFileHelper::SaveStringToFile(Json, *GetProfilePath()))
+	{
+		UE_LOG(LogNekoUtils, Warning, TEXT("[%s] failed to write the UI telemetry profile to [%s]"), *GetName(), *GetProfilePath());
+	}
+}
+
+void UNekoUITelemetrySubsystem::ResetProfile()
+{
+	Profile.Classes.Reset();
+	ClassIndices.Reset();
+	LastPushedClassPath.Reset();
+}
+
+FString UNekoUITelemetrySubsystem::GetProfilePath() const
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("NekoUtils"), ProfileFileName);
+}
+
+void UNekoUITelemetrySubsystem::LoadProfile()
+{
+	ResetProfile();
+
+	FString Json;
+	if (!FFileHelper::LoadFileToString(Json, *GetProfilePath()))
+	{
+		return;
+	}
+
+	if (!FJsonObjectConverter::JsonObjectStringToUStruct(Json, &Profile))
+	{
+		UE_LOG(LogNekoUtils, Warning, TEXT("[%s] ignored the invalid UI telemetry profile [%s]"), *GetName(), *GetProfilePath());
+		Profile.Classes.Reset();
+		return;
+	}
+
+	for (int32 Index = 0; Index < Profile.Classes.Num(); ++Index)
+	{
+		ClassIndices.Add(Profile.Classes[Index].ClassPath, Index);
+	}
+
+	UE_LOG(LogNekoUtils, Log, TEXT("[%s] loaded the UI telemetry of %d widget classes"), *GetName(), Profile.Classes.Num());
+}
+
+FNekoUIClassTelemetry& UNekoUITelemetrySubsystem::FindOrAddClassTelemetry(const FString& ClassPath)
+{
+	if (const int32* Index = ClassIndices.Find(ClassPath))
+	{
+		return Profile.Classes[*Index];
+	}
+
+	ClassIndices.Add(ClassPath, Profile.Classes.Num());
+	FNekoUIClassTelemetry& ClassTelemetry = Profile.Classes.AddDefaulted_GetRef();
+	ClassTelemetry.ClassPath = ClassPath;
+	return ClassTelemetry;
+}
+
+void UNekoUITelemetrySubsystem::HandleWidgetActivated(const TWeakObjectPtr<UCommonActivatableWidget> Widget)
+{
+	double PushStartTime;
+	if (!PendingActivations.RemoveAndCopyValue(Widget, PushStartTime) || !Widget.IsValid())
+	{
+		return;
+	}
+
+	FNekoUIClassTelemetry& ClassTelemetry = FindOrAddClassTelemetry(Widget->GetClass()->GetPathName());
+	++ClassTelemetry.ActivationCount;
+	ClassTelemetry.TotalActivateTime += FPlatformTime::Seconds() - PushStartTime;
+}
+
+void UNekoUITelemetrySubsystem::RemoveDestroyedWidgets()
+{
+	for (auto It = PendingActivations.CreateIterator(); It; ++It)
+	{
+		if (!It->Key.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	for (auto It = BoundWidgets.CreateIterator(); It; ++It)
+	{
+		if (!It->IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UNekoUITelemetrySubsystem::QueuePreload(const FString& ClassPath, const bool bUrgent)
+{
+	const FSoftObjectPath Path(ClassPath);
+	if (Path.IsNull() || Path.ResolveObject() != nullptr || RequestedPreloads.Contains(Path))
+	{
+		return;
+	}
+
+	RequestedPreloads.Add(Path);
+	if (bUrgent)
+	{
+		PreloadQueue.Insert(Path, 0);
+	}
+	else
+	{
+		PreloadQueue.Add(Path);
+	}
+
+	if (!PreloadTickerHandle.IsValid())
+	{
+		PreloadTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UNekoUITelemetrySubsystem::TickPreloads));
+	}
+}
+
+bool UNekoUITelemetrySubsystem::TickPreloads(float DeltaTime)
+{
+	// One preload at a time, and only when the frame had time to spare and nothing else is streaming
+	const bool bPreloading = !PreloadHandles.IsEmpty() && PreloadHandles.Last()->IsLoadingInProgress();
+	if (bPreloading || FApp::GetDeltaTime() > MaxIdleDeltaTime || IsAsyncLoading())
+	{
+		return true;
+	}
+
+	if (PreloadQueue.IsEmpty())
+	{
+		PreloadTickerHandle.Reset();
+		return false;
+	}
+
+	const FSoftObjectPath Path = PreloadQueue[0];
+	PreloadQueue.RemoveAt(0, 1, EAllowShrinking::No);
+
+	FStreamableManager& StreamableManager = UAssetManager::GetStreamableManager();
+	if (TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(Path, FStreamableDelegate(), FStreamableManager::DefaultAsyncLoadPriority))
+	{
+		UE_LOG(LogNekoUtils, Verbose, TEXT("[%s] is preloading the widget class [%s]"), *GetName(), *Path.ToString());
+		PreloadHandles.Add(MoveTemp(Handle));
+	}
+
+	return true;
+}
@@ -0,0 +1,101 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#pragma once
+
+#include "UObject/ObjectKey.h"
+#include "UObject/UnrealType.h"
+
+class UCurveBase;
+
+
+/**
+ * A curve sampled once over [0, 1] at a fixed resolution, so that sampling it is only an index and a lerp instead of
+ * a key search and a cubic interpolation.
+ *
+ * Float, vector and linear color curves are supported, their channels are interleaved so that all of them are
+ * evaluated in one pass.
+ *
+ * The error against the exact curve is measured when baking and stored in MaxError. For a smooth curve it is bounded
+ * by (1 / Resolution)^2 / 8 * max|f''|, so it only gets noticeable on curves with very sharp changes.
+ */
+struct NEKOUTILS_API FNekoBakedCurve
+{
+	// Number of intervals in the lookup table
+	static constexpr int32 Resolution = 256;
+
+	// Enough for a linear color curve
+	static constexpr int32 MaxChannels = 4;
+
+	// Resolution + 1 samples per channel, so that both 0.0 and 1.0 land exactly on a sample
+	float Samples[(Resolution + 1) * MaxChannels] = {};
+
+	// Number of channels of the baked curve, 1 for a float curve, 3 for a vector curve and 4 for a linear color curve
+	int32 NumChannels = 1;
+
+	// Maximum absolute error against the exact curve over all channels, measured when baking
+	float MaxError = 0.0f;
+
+	// Samples the first channel of the lookup table. Time is clamped to [0, 1]
+	float Sample(const float Time) const
+	{
+		int32 Index;
+		const float Fraction = GetSamplePosition(Time, Index);
+		return FMath::Lerp(Samples[Index * MaxChannels], Samples[(Index + 1) * MaxChannels], Fraction);
+	}
+
+	// Samples every channel of the lookup table. Time is clamped to [0, 1]
+	void SampleChannels(const float Time, float (&OutValues)[MaxChannels]) const
+	{
+		int32 Index;
+		const float Fraction = GetSamplePosition(Time, Index);
+		const float* From = &Samples[Index * MaxChannels];
+		const float* To = From + MaxChannels;
+		for (int32 Channel = 0; Channel < MaxChannels; ++Channel)
+		{
+			OutValues[Channel] = FMath::Lerp(From[Channel], To[Channel], Fraction);
+		}
+	}
+
+	// Samples the provided float, vector or linear color curve into the lookup table, and measures the error
+	void Bake(const UCurveBase& Curve);
+
+private:
+	// Returns the index of the sample before Time, and the fraction between it and the next one
+	static float GetSamplePosition(const float Time, int32& OutIndex)
+	{
+		const float Position = FMath::Clamp(Time, 0.0f, 1.0f) * Resolution;
+		OutIndex = FMath::Min(FMath::FloorToInt32(Position), Resolution - 1);
+		return Position - OutIndex;
+	}
+
+	// Evaluates every channel of the exact curve
+	static int32 EvaluateCurve(const UCurveBase& Curve, const float Time, float (&OutValues)[MaxChannels]);
+};
+
+/**
+ * Lookup tables shared by every user of a curve asset. The tables are baked the first time they are requested, and
+ * baked again in place when the curve is edited, so pointers to them stay valid as long as the curve is alive.
+ */
+class NEKOUTILS_API FNekoBakedCurveCache final
+{
+public:
+	static FNekoBakedCurveCache& Get();
+
+	~FNekoBakedCurveCache();
+
+	// Gets the lookup table of the provided curve, baking it if needed
+	const FNekoBakedCurve* FindOrBake(const UCurveBase* Curve);
+
+private:
+	FNekoBakedCurveCache();
+
+#if WITH_EDITOR
+	void HandleCurveUpdated(UCurveBase* Curve, EPropertyChangeType::Type ChangeType);
+#endif
+
+	// Releases the tables of the curves that were garbage collected
+	void HandlePostGarbageCollect();
+
+private:
+	TMap<FObjectKey, TUniquePtr<FNekoBakedCurve>> BakedCurves;
+};
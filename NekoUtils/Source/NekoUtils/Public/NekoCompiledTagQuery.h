@@ -0,0 +1,79 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#pragma once
+
+#include "GameplayTagContainer.h"
+#include "NekoTagBitset.h"
+
+#include "NekoCompiledTagQuery.generated.h"
+
+
+/**
+ * A FGameplayTagQuery flattened once into a list of operations on tag bitsets, instead of reading its token stream
+ * again every time it is matched.
+ *
+ * The expressions are stored in pre-order, each with the index right after its sub-expressions, so evaluating it is
+ * a walk through a contiguous array where every tag set is a single FNekoTagBitset match. Queries using expressions this
+ * doesn't know about are matched with FGameplayTagQuery::Matches instead, and so are queries compiled before the tag
+ * tree changed.
+ *
+ * Use UNekoFunctionLibrary::CompileGameplayTagQuery to create one.
+ */
+USTRUCT(BlueprintType)
+struct NEKOUTILS_API FNekoCompiledTagQuery
+{
+	GENERATED_BODY()
+
+	FNekoCompiledTagQuery() = default;
+	explicit FNekoCompiledTagQuery(const FGameplayTagQuery& InQuery);
+
+	// Whether the provided tags match the query, the fastest way to evaluate it
+	bool Matches(const FNekoTagBitset& Tags) const;
+
+	// Whether the provided tags match the query. Builds a bitset from the container on every call, so tags matched more
+	// than once should be converted to a FNekoTagBitset once instead
+	bool Matches(const FGameplayTagContainer& Tags) const;
+
+	// Gets the indices of the tag bitsets matching the query
+	void FilterMatches(TConstArrayView<FNekoTagBitset> Bitsets, TArray<int32>& OutIndices) const;
+
+	bool IsEmpty() const { return Query.IsEmpty(); }
+
+	// Whether the query couldn't be compiled, or was compiled before the tag tree changed
+	bool UsesFallback() const;
+
+private:
+	// Lets the automation tests make queries stale without rebuilding the gameplay tag index
+	friend struct FNekoGameplayTagTestAccess;
+
+	struct FOperation
+	{
+		EGameplayTagQueryExprType::Type Type = EGameplayTagQueryExprType::Undefined;
+
+		// Index of the operation right after this one and all of its sub-expressions
+		int32 End = 0;
+
+		// Index of the tag set in Masks, INDEX_NONE for expressions of expressions
+		int32 MaskIndex = INDEX_NONE;
+	};
+
+	// Appends the provided expression and its sub-expressions, returns false if one of them isn't supported
+	bool Compile(const FGameplayTagQueryExpression& Expression);
+
+	bool Evaluate(const int32 OperationIndex, const FNekoTagBitset& Tags) const;
+
+private:
+	// The original query, used when it couldn't be compiled
+	UPROPERTY()
+	FGameplayTagQuery Query;
+
+	TArray<FOperation> Operations;
+
+	TArray<FNekoTagBitset> Masks;
+
+	bool bCompiled = false;
+
+	// Version of the gameplay tag index the masks were built with, so that staleness is checked once per match instead of
+	// once per mask
+	uint32 Version = 0;
+};
@@ -0,0 +1,42 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#pragma once
+
+#include "Containers/ArrayView.h"
+#include "Math/Vector.h"
+
+
+/**
+ * Batched versions of UNekoFunctionLibrary::ExponentialDecay_Double and UNekoFunctionLibrary::ExponentialDecay_Vector,
+ * for smoothing many values at once from native code.
+ *
+ * The decay factor is only computed once per call, and the values are processed four doubles at a time using the
+ * engine's vector registers. Vectors are processed as a flat array of doubles, so their channels are not padded.
+ */
+namespace NekoDecay
+{
+	// The fraction of the distance to the target that is left after DeltaTime
+	FORCEINLINE double GetFactor(const float Decay, const float DeltaTime)
+	{
+		// See https://www.youtube.com/watch?v=LSNQuFEDOyQ
+		return FMath::Exp(-Decay * DeltaTime);
+	}
+
+	/**
+	 * Writes Targets + (Values - Targets) * Factor to OutValues, for Num doubles.
+	 * OutValues can be the same as Values, to decay them in place.
+	 */
+	NEKOUTILS_API void Apply(const double* Values, const double* Targets, double* OutValues, const int32 Num, const double Factor);
+
+	/**
+	 * Writes Targets + (Values - Targets) * Factors to OutValues, for Num doubles each using their own factor.
+	 * OutValues can be the same as Values, to decay them in place.
+	 */
+	NEKOUTILS_API void Apply(const double* Values, const double* Targets, const double* Factors, double* OutValues, const int32 Num);
+
+	// Decays every value towards the target at the same index. Both views must have the same size
+	NEKOUTILS_API void ExponentialDecay(TArrayView<double> Values, TConstArrayView<double> Targets, const float Decay, const float DeltaTime);
+
+	// Decays every vector towards the target at the same index. Both views must have the same size
+	NEKOUTILS_API void ExponentialDecay(TArrayView<FVector> Values, TConstArrayView<FVector> Targets, const float Decay, const float DeltaTime);
+}
@@ -4,15 +4,22 @@
 
 #include "CommonInputModeTypes.h"
 #include "CommonInputTypeEnum.h"
+#include "Components/SlateWrapperTypes.h"
 #include "GameplayTagContainer.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
+#include "NekoCompiledTagQuery.h"
+#include "NekoSpring.h"
+#include "NekoTagBitset.h"
+#include "NekoTimelineSubsystem.h"
 
 #include "NekoFunctionLibrary.generated.h"
 
 struct FGameplayTag;
 struct FGameplayTagContainer;
+class UCurveLinearColor;
+class UCurveVector;
+class UMaterialInstanceDynamic;
 class UWidget;
-enum class EPseudoTimelineOutputPins : uint8;
 
 
 UENUM(BlueprintType)
@@ -115,11 +122,38 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Gameplay Tags")
 	static FGameplayTagContainer GetGameplayTagChildren(const FGameplayTag GameplayTag, bool bRecursive);
 
+	/**
+	 * Get the number of children of a gameplay tag, without building a container.
+	 * For example, calling this on x.y, which has "x.y.z" and "x.y.w" children would return 2
+	 *
+	 * @param GameplayTag The parent gameplay tag to search from
+	 * @param bRecursive Whether to count the children of the children
+	 */
+	UFUNCTION(BlueprintPure, Category = "Gameplay Tags")
+	static int32 GetNumGameplayTagChildren(const FGameplayTag GameplayTag, bool bRecursive);
+
+	/**
+	 * Whether a gameplay tag is a child, or a child of a child, of another one. A tag isn't its own descendant.
+	 * For example, calling this on x.y.z with x as the ancestor would return true
+	 */
+	UFUNCTION(BlueprintPure, Category = "Gameplay Tags")
+	static bool IsGameplayTagDescendantOf(const FGameplayTag GameplayTag, const FGameplayTag Ancestor);
+
 	/**
 	 * Get a random gameplay tag from the provided tag container
+	 *
+	 * @see UNekoTagSampler to draw weighted tags, or many tags from the same container
 	 */
 	UFUNCTION(BlueprintPure, Category = "Gameplay Tags")
-	static FGameplayTag GetRandomGameplayTagFromContainer(const FGameplayTagContainer GameplayTagContainer);
+	static FGameplayTag GetRandomGameplayTagFromContainer(const FGameplayTagContainer& GameplayTagContainer);
+
+	/**
+	 * Get a random gameplay tag from the provided tag container, using a random stream so that it can be reproduced
+	 *
+	 * @see UNekoTagSampler to draw weighted tags, or many tags from the same container
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Gameplay Tags")
+	static FGameplayTag GetRandomGameplayTagFromContainerFromStream(const FGameplayTagContainer& GameplayTagContainer, UPARAM(ref) FRandomStream& Stream);
 
 	/**
 	 * Parses the tag name and returns the name of the leaf.
@@ -130,6 +164,55 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Gameplay Tags")
 	static FName GetTagLeafName(const FGameplayTag GameplayTag);
 
+	/**
+	 * Converts a gameplay tag container to a bitset, which is much faster to match against other bitsets.
+	 * Best done once, e.g. when the tags are loaded, and not before every match.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Gameplay Tags | Bitset", meta = (BlueprintAutocast, CompactNodeTitle = "->"))
+	static FNekoTagBitset MakeTagBitset(const FGameplayTagContainer& GameplayTagContainer);
+
+	// Converts a bitset back to a gameplay tag container, with the tags that were explicitly added to it
+	UFUNCTION(BlueprintPure, Category = "Gameplay Tags | Bitset", meta = (BlueprintAutocast, CompactNodeTitle = "->"))
+	static FGameplayTagContainer BreakTagBitset(const FNekoTagBitset& TagBitset);
+
+	// Whether the bitset contains the provided tag or one of its children
+	UFUNCTION(BlueprintPure, Category = "Gameplay Tags | Bitset")
+	static bool TagBitsetHasTag(const FNekoTagBitset& TagBitset, const FGameplayTag GameplayTag, const bool bExactMatch = false);
+
+	// Whether the bitset contains any tag of Other, or any of their children unless bExactMatch is set
+	UFUNCTION(BlueprintPure, Category = "Gameplay Tags | Bitset")
+	static bool TagBitsetHasAny(const FNekoTagBitset& TagBitset, const FNekoTagBitset& Other, const bool bExactMatch = false);
+
+	// Whether the bitset contains every tag of Other, or any of their children unless bExactMatch is set
+	UFUNCTION(BlueprintPure, Category = "Gameplay Tags | Bitset")
+	static bool TagBitsetHasAll(const FNekoTagBitset& TagBitset, const FNekoTagBitset& Other, const bool bExactMatch = false);
+
+	/**
+	 * Compiles a gameplay tag query, so that matching it is much faster.
+	 * Best done once, e.g. when the query is loaded, and not before every match.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Gameplay Tags | Query")
+	static FNekoCompiledTagQuery CompileGameplayTagQuery(const FGameplayTagQuery& Query);
+
+	// Whether the provided tags match the compiled query, the fastest way to evaluate it
+	UFUNCTION(BlueprintPure, Category = "Gameplay Tags | Query")
+	static bool MatchesCompiledTagQuery(const FNekoCompiledTagQuery& CompiledQuery, const FNekoTagBitset& TagBitset);
+
+	/**
+	 * Whether the provided tags match the compiled query.
+	 * The container is converted to a bitset on every call, so prefer converting it once with MakeTagBitset.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Gameplay Tags | Query")
+	static bool MatchesCompiledTagQuery_Container(const FNekoCompiledTagQuery& CompiledQuery, const FGameplayTagContainer& GameplayTagContainer);
+
+	/**
+	 * Matches every provided bitset against the compiled query in a single call
+	 *
+	 * @return The indices of the bitsets matching the query
+	 */
+	UFUNCTION(BlueprintPure, Category = "Gameplay Tags | Query")
+	static TArray<int32> FilterByCompiledTagQuery(const FNekoCompiledTagQuery& CompiledQuery, const TArray<FNekoTagBitset>& TagBitsets);
+
 	///////////////////////////////////////////////////////////////////////////
 	/// Timings and math
 
@@ -140,13 +223,15 @@ public:
 	 * @param Alpha The value of the curve at the current progress value (will be 0-1 if no curve is provided)
 	 * @param Time How much time to run for
 	 * @param Curve The curve to sample (optional)
+	 * @param Options Optional settings, e.g. to loop, or to sample a baked version of the curve
 	 */
-	UFUNCTION(BlueprintCallable, Category = "Utilities", meta = (WorldContext = "WorldContextObject", Latent, LatentInfo = "LatentInfo", Keywords = "lerp linear interpolate over time", ExpandEnumAsExecs = "OutputPins", Time = "1.0f"))
+	UFUNCTION(BlueprintCallable, Category = "Utilities", meta = (WorldContext = "WorldContextObject", Latent, LatentInfo = "LatentInfo", Keywords = "lerp linear interpolate over time", ExpandEnumAsExecs = "OutputPins", Time = "1.0f", AutoCreateRefTerm = "Options", AdvancedDisplay = "Options"))
 	static void PseudoTimeline(
 		const UObject* WorldContextObject,
 		const FLatentActionInfo LatentInfo,
 		const float Time,
 		const UCurveFloat* Curve,
+		const FNekoPseudoTimelineOptions& Options,
 		EPseudoTimelineOutputPins& OutputPins,
 		float& Progress,
 		float& Alpha);
@@ -160,17 +245,225 @@ public:
 	 * @param Alpha The value of the curve at the current progress value (will be 0-1 if no curve is provided)
 	 * @param Time How much time to run for
 	 * @param Curve The curve to sample (optional)
+	 * @param Options Optional settings, e.g. to loop, or to sample a baked version of the curve
 	 */
-	UFUNCTION(BlueprintCallable, Category = "Utilities", meta = (WorldContext = "WorldContextObject", Latent, LatentInfo = "LatentInfo", Keywords = "lerp linear interpolate over time", ExpandEnumAsExecs = "OutputPins", Time = "1.0f"))
+	UFUNCTION(BlueprintCallable, Category = "Utilities", meta = (WorldContext = "WorldContextObject", Latent, LatentInfo = "LatentInfo", Keywords = "lerp linear interpolate over time", ExpandEnumAsExecs = "OutputPins", Time = "1.0f", AutoCreateRefTerm = "Options", AdvancedDisplay = "Options"))
 	static void RetriggerablePseudoTimeline(
 		const UObject* WorldContextObject,
 		const FLatentActionInfo LatentInfo,
 		const float Time,
 		const UCurveFloat* Curve,
+		const FNekoPseudoTimelineOptions& Options,
 		EPseudoTimelineOutputPins& OutputPins,
 		float& Progress,
 		float& Alpha);
 
+	/**
+	 * Same as PseudoTimeline, but interpolates between two vectors natively instead of outputting an alpha.
+	 *
+	 * @param Progress The current progress along the curve, from 0 to 1
+	 * @param Value The value between A and B at the current progress
+	 * @param Time How much time to run for
+	 * @param A The value at the start
+	 * @param B The value at the end
+	 * @param Curve The curve to sample for the alpha between A and B (optional)
+	 * @param Options Optional settings, e.g. to loop, or to sample a baked version of the curve
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities", DisplayName = "Pseudo Timeline (Vector)", meta = (WorldContext = "WorldContextObject", Latent, LatentInfo = "LatentInfo", Keywords = "lerp linear interpolate over time vector", ExpandEnumAsExecs = "OutputPins", Time = "1.0f", AutoCreateRefTerm = "Options", AdvancedDisplay = "Options"))
+	static void PseudoTimeline_Vector(
+		const UObject* WorldContextObject,
+		const FLatentActionInfo LatentInfo,
+		const float Time,
+		const FVector A,
+		const FVector B,
+		const UCurveFloat* Curve,
+		const FNekoPseudoTimelineOptions& Options,
+		EPseudoTimelineOutputPins& OutputPins,
+		float& Progress,
+		FVector& Value);
+
+	/**
+	 * Same as PseudoTimeline, but samples a vector curve, evaluating all of its channels in one pass.
+	 *
+	 * @param Progress The current progress along the curve, from 0 to 1
+	 * @param Value The value of the curve at the current progress value
+	 * @param Time How much time to run for
+	 * @param Curve The vector curve to sample
+	 * @param Options Optional settings, e.g. to loop, or to sample a baked version of the curve
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities", DisplayName = "Pseudo Timeline (Vector Curve)", meta = (WorldContext = "WorldContextObject", Latent, LatentInfo = "LatentInfo", Keywords = "lerp linear interpolate over time vector curve", ExpandEnumAsExecs = "OutputPins", Time = "1.0f", AutoCreateRefTerm = "Options", AdvancedDisplay = "Options"))
+	static void PseudoTimeline_VectorCurve(
+		const UObject* WorldContextObject,
+		const FLatentActionInfo LatentInfo,
+		const float Time,
+		const UCurveVector* Curve,
+		const FNekoPseudoTimelineOptions& Options,
+		EPseudoTimelineOutputPins& OutputPins,
+		float& Progress,
+		FVector& Value);
+
+	/**
+	 * Same as PseudoTimeline, but interpolates between two rotations natively instead of outputting an alpha.
+	 * The rotations are slerped through quaternions, so they always take the shortest path.
+	 *
+	 * @param Progress The current progress along the curve, from 0 to 1
+	 * @param Value The value between A and B at the current progress
+	 * @param Time How much time to run for
+	 * @param A The rotation at the start
+	 * @param B The rotation at the end
+	 * @param Curve The curve to sample for the alpha between A and B (optional)
+	 * @param Options Optional settings, e.g. to loop, or to sample a baked version of the curve
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities", DisplayName = "Pseudo Timeline (Rotator)", meta = (WorldContext = "WorldContextObject", Latent, LatentInfo = "LatentInfo", Keywords = "lerp slerp rotation interpolate over time rotator", ExpandEnumAsExecs = "OutputPins", Time = "1.0f", AutoCreateRefTerm = "Options", AdvancedDisplay = "Options"))
+	static void PseudoTimeline_Rotator(
+		const UObject* WorldContextObject,
+		const FLatentActionInfo LatentInfo,
+		const float Time,
+		const FRotator A,
+		const FRotator B,
+		const UCurveFloat* Curve,
+		const FNekoPseudoTimelineOptions& Options,
+		EPseudoTimelineOutputPins& OutputPins,
+		float& Progress,
+		FRotator& Value);
+
+	/**
+	 * Same as PseudoTimeline, but interpolates between two colors natively instead of outputting an alpha.
+	 *
+	 * @param Progress The current progress along the curve, from 0 to 1
+	 * @param Value The value between A and B at the current progress
+	 * @param Time How much time to run for
+	 * @param A The color at the start
+	 * @param B The color at the end
+	 * @param Curve The curve to sample for the alpha between A and B (optional)
+	 * @param Options Optional settings, e.g. to loop, or to sample a baked version of the curve
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities", DisplayName = "Pseudo Timeline (Linear Color)", meta = (WorldContext = "WorldContextObject", Latent, LatentInfo = "LatentInfo", Keywords = "lerp linear interpolate over time color", ExpandEnumAsExecs = "OutputPins", Time = "1.0f", AutoCreateRefTerm = "Options", AdvancedDisplay = "Options"))
+	static void PseudoTimeline_LinearColor(
+		const UObject* WorldContextObject,
+		const FLatentActionInfo LatentInfo,
+		const float Time,
+		const FLinearColor A,
+		const FLinearColor B,
+		const UCurveFloat* Curve,
+		const FNekoPseudoTimelineOptions& Options,
+		EPseudoTimelineOutputPins& OutputPins,
+		float& Progress,
+		FLinearColor& Value);
+
+	/**
+	 * Same as PseudoTimeline, but samples a linear color curve, evaluating all of its channels in one pass.
+	 *
+	 * @param Progress The current progress along the curve, from 0 to 1
+	 * @param Value The value of the curve at the current progress value
+	 * @param Time How much time to run for
+	 * @param Curve The linear color curve to sample
+	 * @param Options Optional settings, e.g. to loop, or to sample a baked version of the curve
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities", DisplayName = "Pseudo Timeline (Linear Color Curve)", meta = (WorldContext = "WorldContextObject", Latent, LatentInfo = "LatentInfo", Keywords = "lerp linear interpolate over time color curve", ExpandEnumAsExecs = "OutputPins", Time = "1.0f", AutoCreateRefTerm = "Options", AdvancedDisplay = "Options"))
+	static void PseudoTimeline_LinearColorCurve(
+		const UObject* WorldContextObject,
+		const FLatentActionInfo LatentInfo,
+		const float Time,
+		const UCurveLinearColor* Curve,
+		const FNekoPseudoTimelineOptions& Options,
+		EPseudoTimelineOutputPins& OutputPins,
+		float& Progress,
+		FLinearColor& Value);
+
+	/**
+	 * Same as PseudoTimeline, but interpolates between two transforms natively instead of outputting an alpha.
+	 * The rotations are slerped through quaternions, so they always take the shortest path.
+	 *
+	 * @param Progress The current progress along the curve, from 0 to 1
+	 * @param Value The value between A and B at the current progress
+	 * @param Time How much time to run for
+	 * @param A The transform at the start
+	 * @param B The transform at the end
+	 * @param Curve The curve to sample for the alpha between A and B (optional)
+	 * @param Options Optional settings, e.g. to loop, or to sample a baked version of the curve
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities", DisplayName = "Pseudo Timeline (Transform)", meta = (WorldContext = "WorldContextObject", Latent, LatentInfo = "LatentInfo", Keywords = "lerp slerp interpolate over time transform", ExpandEnumAsExecs = "OutputPins", Time = "1.0f", AutoCreateRefTerm = "A, B, Options", AdvancedDisplay = "Options"))
+	static void PseudoTimeline_Transform(
+		const UObject* WorldContextObject,
+		const FLatentActionInfo LatentInfo,
+		const float Time,
+		const FTransform& A,
+		const FTransform& B,
+		const UCurveFloat* Curve,
+		const FNekoPseudoTimelineOptions& Options,
+		EPseudoTimelineOutputPins& OutputPins,
+		float& Progress,
+		FTransform& Value);
+
+	/**
+	 * Drives the provided target from A to B over time, sampling a curve if provided. Everything is done natively, so the
+	 * Blueprint VM is only entered once the pseudo-timeline is finished.
+	 *
+	 * @param Time How much time to run for
+	 * @param Curve The curve to sample for the alpha between A and B (optional)
+	 * @param Target The target to drive, see the "Make Timeline Target" functions
+	 * @param Options Optional settings, e.g. to loop, or to sample a baked version of the curve
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities", meta = (WorldContext = "WorldContextObject", Latent, LatentInfo = "LatentInfo", Keywords = "lerp linear interpolate over time animate", Time = "1.0f", AutoCreateRefTerm = "Options", AdvancedDisplay = "Options"))
+	static void PseudoTimelineToTarget(
+		const UObject* WorldContextObject,
+		const FLatentActionInfo LatentInfo,
+		const float Time,
+		const UCurveFloat* Curve,
+		const FNekoTimelineTarget& Target,
+		const FNekoPseudoTimelineOptions& Options);
+
+	/**
+	 * Makes a target for PseudoTimelineToTarget, driving a float or double property.
+	 *
+	 * The owner's Set<Property> function is called when it has one taking the value as its only parameter (e.g.
+	 * SetIntensity on a light component), so that the change is visible. Otherwise the value is written directly, and the
+	 * render state of components is marked dirty, which is only enough for plain variables and rendering properties.
+	 *
+	 * @param Object The object owning the property
+	 * @param PropertyPath The name of the property, can go through object and struct properties (e.g. "LightComponent.Intensity")
+	 */
+	UFUNCTION(BlueprintPure, Category = "Utilities | Timeline Target", meta = (B = "1.0"))
+	static FNekoTimelineTarget MakeTimelineTarget_FloatProperty(UObject* Object, const FName PropertyPath, const double A, const double B);
+
+	/**
+	 * Makes a target for PseudoTimelineToTarget, driving a vector property, see MakeTimelineTarget_FloatProperty
+	 *
+	 * @param Object The object owning the property
+	 * @param PropertyPath The name of the property, can go through object and struct properties (e.g. "Settings.Offset")
+	 */
+	UFUNCTION(BlueprintPure, Category = "Utilities | Timeline Target")
+	static FNekoTimelineTarget MakeTimelineTarget_VectorProperty(UObject* Object, const FName PropertyPath, const FVector A, const FVector B);
+
+	/**
+	 * Makes a target for PseudoTimelineToTarget, driving a linear color property, see MakeTimelineTarget_FloatProperty
+	 *
+	 * @param Object The object owning the property
+	 * @param PropertyPath The name of the property, can go through object and struct properties (e.g. "Settings.Tint")
+	 */
+	UFUNCTION(BlueprintPure, Category = "Utilities | Timeline Target")
+	static FNekoTimelineTarget MakeTimelineTarget_ColorProperty(UObject* Object, const FName PropertyPath, const FLinearColor A, const FLinearColor B);
+
+	/**
+	 * Makes a target for PseudoTimelineToTarget, driving a scalar parameter of a dynamic material instance
+	 */
+	UFUNCTION(BlueprintPure, Category = "Utilities | Timeline Target", meta = (B = "1.0"))
+	static FNekoTimelineTarget MakeTimelineTarget_MaterialScalar(UMaterialInstanceDynamic* Material, const FName ParameterName, const float A, const float B);
+
+	/**
+	 * Makes a target for PseudoTimelineToTarget, driving a vector parameter of a dynamic material instance
+	 */
+	UFUNCTION(BlueprintPure, Category = "Utilities | Timeline Target")
+	static FNekoTimelineTarget MakeTimelineTarget_MaterialVector(UMaterialInstanceDynamic* Material, const FName ParameterName, const FLinearColor A, const FLinearColor B);
+
+	/**
+	 * Makes a target for PseudoTimelineToTarget, driving the render opacity or a field of the render transform of a widget.
+	 * Opacity and angle only use the X component of A and B.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Utilities | Timeline Target")
+	static FNekoTimelineTarget MakeTimelineTarget_Widget(UWidget* Widget, const ENekoWidgetRenderField Field, const FVector2D A, const FVector2D B);
+
 	/**
 	 * A lerp-like function that doesn't depend on framerate at all.
 	 *
@@ -193,8 +486,132 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Math | Vector", DisplayName = "Exponential Decay (Vector)", meta = (Keywords = "lerp", Decay = "16.0f"))
 	static FVector ExponentialDecay_Vector(const FVector A, const FVector B, const float Decay, const float DeltaTime);
 
-	// Note: there are no exponential decay for rotators and transforms, because they should be done with quaternions and I didn't want to deal with it.
-	// This can be seen in UKismetMathLibrary::RLerp() and UKismetMathLibrary::TLerp()
+	/**
+	 * Same as ExponentialDecay (Float), but for every pair of values at the same index of A and B at once.
+	 * Much cheaper than calling it in a loop, see NekoDecay::ExponentialDecay.
+	 *
+	 * @param Decay Decay constant. Approximately from 1 to 25, slow to fast.
+	 * @return The decayed values, the values of A without any matching value in B are returned unchanged
+	 */
+	UFUNCTION(BlueprintPure, Category = "Math | Float", DisplayName = "Exponential Decay (Float Array)", meta = (Keywords = "lerp float batch", Decay = "16.0f"))
+	static TArray<double> ExponentialDecay_DoubleArray(const TArray<double>& A, const TArray<double>& B, const float Decay, const float DeltaTime);
+
+	/**
+	 * Same as ExponentialDecay (Float Array), but decays the values in place instead of copying them.
+	 *
+	 * @param Decay Decay constant. Approximately from 1 to 25, slow to fast.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Math | Float", DisplayName = "Exponential Decay In Place (Float Array)", meta = (Keywords = "lerp float batch", Decay = "16.0f"))
+	static void ExponentialDecayInPlace_DoubleArray(UPARAM(ref) TArray<double>& Values, const TArray<double>& Targets, const float Decay, const float DeltaTime);
+
+	/**
+	 * Same as ExponentialDecay (Vector), but for every pair of vectors at the same index of A and B at once.
+	 * Much cheaper than calling it in a loop, see NekoDecay::ExponentialDecay.
+	 *
+	 * @param Decay Decay constant. Approximately from 1 to 25, slow to fast.
+	 * @return The decayed vectors, the vectors of A without any matching vector in B are returned unchanged
+	 */
+	UFUNCTION(BlueprintPure, Category = "Math | Vector", DisplayName = "Exponential Decay (Vector Array)", meta = (Keywords = "lerp batch", Decay = "16.0f"))
+	static TArray<FVector> ExponentialDecay_VectorArray(const TArray<FVector>& A, const TArray<FVector>& B, const float Decay, const float DeltaTime);
+
+	/**
+	 * Same as ExponentialDecay (Vector Array), but decays the vectors in place instead of copying them.
+	 *
+	 * @param Decay Decay constant. Approximately from 1 to 25, slow to fast.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Math | Vector", DisplayName = "Exponential Decay In Place (Vector Array)", meta = (Keywords = "lerp batch", Decay = "16.0f"))
+	static void ExponentialDecayInPlace_VectorArray(UPARAM(ref) TArray<FVector>& Values, const TArray<FVector>& Targets, const float Decay, const float DeltaTime);
+
+	/**
+	 * A slerp-like function that doesn't depend on framerate at all.
+	 *
+	 * See https://www.youtube.com/watch?v=LSNQuFEDOyQ
+	 * 
+	 * @param Decay Decay constant. Approximately from 1 to 25, slow to fast.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Math | Quat", DisplayName = "Exponential Decay (Quat)", meta = (Keywords = "lerp slerp", Decay = "16.0f"))
+	static FQuat ExponentialDecay_Quat(const FQuat& A, const FQuat& B, const float Decay, const float DeltaTime);
+
+	/**
+	 * A slerp-like function that doesn't depend on framerate at all. Goes through quaternions, like UKismetMathLibrary::RLerp()
+	 * with bShortestPath.
+	 *
+	 * See https://www.youtube.com/watch?v=LSNQuFEDOyQ
+	 * 
+	 * @param Decay Decay constant. Approximately from 1 to 25, slow to fast.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Math | Rotator", DisplayName = "Exponential Decay (Rotator)", meta = (Keywords = "lerp slerp rotation", Decay = "16.0f"))
+	static FRotator ExponentialDecay_Rotator(const FRotator A, const FRotator B, const float Decay, const float DeltaTime);
+
+	/**
+	 * A lerp-like function that doesn't depend on framerate at all. The rotation is slerped, like UKismetMathLibrary::TLerp()
+	 * with ELerpInterpolationMode::QuatInterp.
+	 *
+	 * See https://www.youtube.com/watch?v=LSNQuFEDOyQ
+	 * 
+	 * @param Decay Decay constant. Approximately from 1 to 25, slow to fast.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Math | Transform", DisplayName = "Exponential Decay (Transform)", meta = (Keywords = "lerp slerp", Decay = "16.0f"))
+	static FTransform ExponentialDecay_Transform(const FTransform& A, const FTransform& B, const float Decay, const float DeltaTime);
+
+	/**
+	 * Moves a spring towards the target, without depending on framerate at all. Unlike ExponentialDecay, the spring
+	 * keeps its velocity when the target changes, so there is no visible kink when retargeting mid-motion.
+	 *
+	 * @param Spring The state of the spring, to keep between two updates
+	 * @param Frequency Number of oscillations per second when undamped. Higher is faster.
+	 * @param DampingRatio 1 is critically damped (fastest without overshooting), lower values bounce and higher values are slower
+	 * @return The new value of the spring
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Math | Float", DisplayName = "Update Spring (Float)", meta = (Keywords = "spring damp smooth float", Frequency = "2.0f", DampingRatio = "1.0f"))
+	static double UpdateSpring_Float(UPARAM(ref) FNekoSpringFloat& Spring, const double Target, const float Frequency, const float DampingRatio, const float DeltaTime);
+
+	/**
+	 * Moves a spring towards the target, without depending on framerate at all. Unlike ExponentialDecay, the spring
+	 * keeps its velocity when the target changes, so there is no visible kink when retargeting mid-motion.
+	 *
+	 * @param Spring The state of the spring, to keep between two updates
+	 * @param Frequency Number of oscillations per second when undamped. Higher is faster.
+	 * @param DampingRatio 1 is critically damped (fastest without overshooting), lower values bounce and higher values are slower
+	 * @return The new value of the spring
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Math | Vector", DisplayName = "Update Spring (Vector)", meta = (Keywords = "spring damp smooth", Frequency = "2.0f", DampingRatio = "1.0f"))
+	static FVector UpdateSpring_Vector(UPARAM(ref) FNekoSpringVector& Spring, const FVector Target, const float Frequency, const float DampingRatio, const float DeltaTime);
+
+	/**
+	 * Moves a rotation spring towards the target along the shortest path, without depending on framerate at all.
+	 * Unlike ExponentialDecay, the spring keeps its velocity when the target changes, so there is no visible kink when
+	 * retargeting mid-motion.
+	 *
+	 * @param Spring The state of the spring, to keep between two updates
+	 * @param Frequency Number of oscillations per second when undamped. Higher is faster.
+	 * @param DampingRatio 1 is critically damped (fastest without overshooting), lower values bounce and higher values are slower
+	 * @return The new value of the spring
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Math | Quat", DisplayName = "Update Spring (Quat)", meta = (Keywords = "spring damp smooth rotation", Frequency = "2.0f", DampingRatio = "1.0f"))
+	static FQuat UpdateSpring_Quat(UPARAM(ref) FNekoSpringQuat& Spring, const FQuat& Target, const float Frequency, const float DampingRatio, const float DeltaTime);
+
+	/**
+	 * Same as UpdateSpring (Float), but for every spring at once, all sharing the same parameters. Much cheaper than
+	 * calling it in a loop, see NekoSpring::UpdateBatch.
+	 *
+	 * @param Values The values of the springs, updated in place
+	 * @param Velocities The velocities of the springs, updated in place. Must have the same size as Values
+	 * @param Targets The target of each spring. Must have the same size as Values
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Math | Float", DisplayName = "Update Springs (Float Array)", meta = (Keywords = "spring damp smooth float batch", Frequency = "2.0f", DampingRatio = "1.0f"))
+	static void UpdateSprings_DoubleArray(UPARAM(ref) TArray<double>& Values, UPARAM(ref) TArray<double>& Velocities, const TArray<double>& Targets, const float Frequency, const float DampingRatio, const float DeltaTime);
+
+	/**
+	 * Same as UpdateSpring (Vector), but for every spring at once, all sharing the same parameters. Much cheaper than
+	 * calling it in a loop, see NekoSpring::UpdateBatch.
+	 *
+	 * @param Values The values of the springs, updated in place
+	 * @param Velocities The velocities of the springs, updated in place. Must have the same size as Values
+	 * @param Targets The target of each spring. Must have the same size as Values
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Math | Vector", DisplayName = "Update Springs (Vector Array)", meta = (Keywords = "spring damp smooth batch", Frequency = "2.0f", DampingRatio = "1.0f"))
+	static void UpdateSprings_VectorArray(UPARAM(ref) TArray<FVector>& Values, UPARAM(ref) TArray<FVector>& Velocities, const TArray<FVector>& Targets, const float Frequency, const float DampingRatio, const float DeltaTime);
 
 	/**
 	 * @note This actually returns a double, because floats in Blueprints default to double-precision since UE 5.0
@@ -234,9 +651,8 @@ public:
 	/// Widgets and UI stuff
 
 	/**
-	 * Finds the widget that is focused by the provided PlayerController, by looping through all widgets until it finds
-	 * it.
-	 * This is a slow operation, use with caution e.g. do not use every frame.
+	 * Finds the widget that is focused by the provided PlayerController.
+	 * The focused widget is tracked when the focus changes by UNekoFocusedWidgetTracker, so this is cheap to call.
 	 *
 	 * @param Player The user's focus to look for.
 	 * @return The widget focused by the provided user.
@@ -245,32 +661,62 @@ public:
 	static UWidget* FindFocusedWidget(APlayerController* Player);
 
 	/**
-	 * Get the owning player's UCommonInputSubsystem's current input type
+	 * Get the owning player's current input type, as cached by UNekoInputStateSubsystem
 	 * 
 	 * @note This requires the game to be using CommonInput/CommonUI
+	 * @note The input type is cached, but the subsystem is still looked up on every call, and a binding calls it every
+	 *       frame. Use BindVisibilityToInputType to only react when the input type changes
 	 * @return The owning player's input type
 	 */
 	UFUNCTION(BlueprintPure, BlueprintCosmetic, Category = "Widget", meta = (DefaultToSelf = "Widget"))
 	static ECommonInputType GetOwningPlayerInputType(const UUserWidget* Widget);
 
 	/**
-	 * Check if the owning player's UCommonInputSubsystem's current input type is Gamepad
+	 * Check if the owning player's current input type, as cached by UNekoInputStateSubsystem, is Gamepad
 	 * 
 	 * @note This requires the game to be using CommonInput/CommonUI
+	 * @note Polled like GetOwningPlayerInputType, see BindVisibilityToInputType
 	 * @return Whether the owning player is using the gamepad
 	 */
 	UFUNCTION(BlueprintPure, BlueprintCosmetic, Category = "Widget", meta = (DefaultToSelf = "Widget"))
 	static bool IsOwningPlayerUsingGamepad(const UUserWidget* Widget);
 	
 	/**
-	 * Check if the owning player's UCommonInputSubsystem's current input type is Touch
+	 * Check if the owning player's current input type, as cached by UNekoInputStateSubsystem, is Touch
 	 * 
 	 * @note This requires the game to be using CommonInput/CommonUI
+	 * @note Polled like GetOwningPlayerInputType, see BindVisibilityToInputType
 	 * @return Whether the owning player is using touch
 	 */
 	UFUNCTION(BlueprintPure, BlueprintCosmetic, Category = "Widget", meta = (DefaultToSelf = "Widget"))
 	static bool IsOwningPlayerUsingTouch(const UUserWidget* Widget);
 
+	/**
+	 * Makes the provided widget visible only while the owning player uses one of the provided input types, e.g. to show
+	 * gamepad glyphs. The visibility is only updated when the input type changes, prefer it over binding the visibility
+	 * to IsOwningPlayerUsingGamepad, which is evaluated every frame.
+	 *
+	 * @note This requires the game to be using CommonInput/CommonUI
+	 * @param OwningWidget The user widget whose lifetime the binding follows
+	 * @param Widget The widget whose visibility is switched, usually a child of OwningWidget
+	 * @param InputTypes The input types for which the widget is visible
+	 * @param VisibleVisibility Visibility of the widget while using one of the input types
+	 * @param HiddenVisibility Visibility of the widget while using any other input type
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "Widget", meta = (DefaultToSelf = "OwningWidget", AdvancedDisplay = "VisibleVisibility,HiddenVisibility"))
+	static void BindVisibilityToInputType(UUserWidget* OwningWidget, UWidget* Widget,
+	                                      UPARAM(meta = (Bitmask, BitmaskEnum = "/Script/CommonInput.ECommonInputType")) const int32 InputTypes,
+	                                      const ESlateVisibility VisibleVisibility = ESlateVisibility::SelfHitTestInvisible,
+	                                      const ESlateVisibility HiddenVisibility = ESlateVisibility::Collapsed);
+
+	/**
+	 * Stops switching the visibility of the provided widget on the input type
+	 *
+	 * @see BindVisibilityToInputType
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "Widget", meta = (DefaultToSelf = "OwningWidget"))
+	static void UnbindVisibilityFromInputType(UUserWidget* OwningWidget, UWidget* Widget);
+
 	UFUNCTION(BlueprintPure, BlueprintCosmetic, Category = "Widget")
 	static UNekoRootUILayout* GetRootUILayout_ForPlayer(const APlayerController* PlayerController);
 
@@ -288,17 +734,32 @@ public:
 
 	/**
 	 * Hides an actor for a specific player. Useful for split-screen
+	 * Hiding an actor that is already hidden does nothing.
 	 *
 	 * @param Player The player for which to hide the provided Actor
 	 * @param Actor The Actor to be hidden
+	 * @see UNekoPlayerVisibilitySubsystem to hide actors in bulk
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Player")
 	static void HideActorForPlayer(APlayerController* Player, AActor* Actor);
 
+	/**
+	 * Shows an actor that was hidden for a specific player by HideActorForPlayer
+	 *
+	 * @param Player The player for which to unhide the provided Actor
+	 * @param Actor The Actor to be unhidden
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Player")
+	static void UnhideActorForPlayer(APlayerController* Player, AActor* Actor);
+
 	///////////////////////////////////////////////////////////////////////////
 	/// Custom thunk functions
 
-	/** Get a numbered element in the would be generated array of the provided HashMap */
+	/**
+	 * Get a numbered element in the would be generated array of the provided HashMap
+	 * The element is found directly unless something was removed from the map, in which case finding it walks the map
+	 * up to it. Use Map Next or Keys/Values to go through every element instead.
+	 */
 	UFUNCTION(BlueprintCallable, Category = "Utilities | Map", CustomThunk,
 			  meta = (DisplayName = "Get", CompactNodeTitle = "GET", MapParam = "TargetMap", MapKeyParam = "Key", MapValueParam = "Value", AutoCreateRefTerm = "Key, Value", BlueprintThreadSafe))
 	static void Map_Get(const TMap<int32, int32>& TargetMap, const int32 Index, int32& Key, int32& Value);
@@ -349,4 +810,175 @@ public:
 		CurrValueProp->DestroyValue(ValueStorageSpace);
 		CurrKeyProp->DestroyValue(KeyStorageSpace);
 	}
+
+	/**
+	 * Gets the next element of the provided HashMap, to go through every element in a loop until it returns false.
+	 * Set Cursor to 0 before the first call, it is moved past the returned element by each call.
+	 *
+	 * @return Whether an element was found, false once every element was returned
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities | Map", CustomThunk,
+			  meta = (DisplayName = "Next", MapParam = "TargetMap", MapKeyParam = "Key", MapValueParam = "Value", AutoCreateRefTerm = "Key, Value", BlueprintThreadSafe))
+	static bool Map_Next(const TMap<int32, int32>& TargetMap, UPARAM(ref) int32& Cursor, int32& Key, int32& Value);
+
+	static bool GenericMap_Next(void* TargetMap, const FMapProperty* MapProp, int32& Cursor, void* KeyPtr, void* ValuePtr);
+	DECLARE_FUNCTION(execMap_Next)
+	{
+		// Map
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FMapProperty>(nullptr);
+		void* MapAddr = Stack.MostRecentPropertyAddress;
+		const FMapProperty* MapProperty = CastField<FMapProperty>(Stack.MostRecentProperty);
+		if (!MapProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		// Cursor
+		P_GET_PROPERTY_REF(FIntProperty, Cursor);
+
+		// Key
+		const FProperty* CurrKeyProp = MapProperty->KeyProp;
+		const int32 KeyPropSize = CurrKeyProp->GetElementSize() * CurrKeyProp->ArrayDim;
+		void* KeyStorageSpace = FMemory_Alloca(KeyPropSize);
+		CurrKeyProp->InitializeValue(KeyStorageSpace);
+
+		Stack.MostRecentPropertyAddress = nullptr;
+		Stack.StepCompiledIn<FProperty>(KeyStorageSpace);
+		void* KeyPtr = (Stack.MostRecentPropertyAddress != nullptr && Stack.MostRecentProperty->GetClass() == CurrKeyProp->GetClass()) ? Stack.MostRecentPropertyAddress : KeyStorageSpace;
+
+		// Value
+		const FProperty* CurrValueProp = MapProperty->ValueProp;
+		const int32 ValuePropSize = CurrValueProp->GetElementSize() * CurrValueProp->ArrayDim;
+		void* ValueStorageSpace = FMemory_Alloca(ValuePropSize);
+		CurrValueProp->InitializeValue(ValueStorageSpace);
+
+		Stack.MostRecentPropertyAddress = nullptr;
+		Stack.StepCompiledIn<FProperty>(ValueStorageSpace);
+		void* ValuePtr = (Stack.MostRecentPropertyAddress != nullptr && Stack.MostRecentProperty->GetClass() == CurrValueProp->GetClass()) ? Stack.MostRecentPropertyAddress : ValueStorageSpace;
+
+		P_FINISH;
+
+		P_NATIVE_BEGIN;
+		*static_cast<bool*>(RESULT_PARAM) = GenericMap_Next(MapAddr, MapProperty, Cursor, KeyPtr, ValuePtr);
+		P_NATIVE_END;
+
+		CurrValueProp->DestroyValue(ValueStorageSpace);
+		CurrKeyProp->DestroyValue(KeyStorageSpace);
+	}
+
+	/** Copies every key of the provided HashMap to an array, in a single call */
+	UFUNCTION(BlueprintCallable, Category = "Utilities | Map", CustomThunk,
+			  meta = (DisplayName = "Keys To Array", MapParam = "TargetMap", MapKeyParam = "Keys", BlueprintThreadSafe))
+	static void Map_KeysToArray(const TMap<int32, int32>& TargetMap, TArray<int32>& Keys);
+
+	DECLARE_FUNCTION(execMap_KeysToArray)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FMapProperty>(nullptr);
+		void* MapAddr = Stack.MostRecentPropertyAddress;
+		const FMapProperty* MapProperty = CastField<FMapProperty>(Stack.MostRecentProperty);
+		if (!MapProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+		void* KeysAddr = Stack.MostRecentPropertyAddress;
+		const FArrayProperty* KeysProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+		if (!KeysProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_FINISH;
+
+		P_NATIVE_BEGIN;
+		GenericMap_ToArrays(MapAddr, MapProperty, KeysAddr, KeysProperty, nullptr, nullptr);
+		P_NATIVE_END;
+	}
+
+	/** Copies every value of the provided HashMap to an array, in a single call */
+	UFUNCTION(BlueprintCallable, Category = "Utilities | Map", CustomThunk,
+			  meta = (DisplayName = "Values To Array", MapParam = "TargetMap", MapValueParam = "Values", BlueprintThreadSafe))
+	static void Map_ValuesToArray(const TMap<int32, int32>& TargetMap, TArray<int32>& Values);
+
+	DECLARE_FUNCTION(execMap_ValuesToArray)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FMapProperty>(nullptr);
+		void* MapAddr = Stack.MostRecentPropertyAddress;
+		const FMapProperty* MapProperty = CastField<FMapProperty>(Stack.MostRecentProperty);
+		if (!MapProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+		void* ValuesAddr = Stack.MostRecentPropertyAddress;
+		const FArrayProperty* ValuesProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+		if (!ValuesProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_FINISH;
+
+		P_NATIVE_BEGIN;
+		GenericMap_ToArrays(MapAddr, MapProperty, nullptr, nullptr, ValuesAddr, ValuesProperty);
+		P_NATIVE_END;
+	}
+
+	/** Copies every key and value of the provided HashMap to two arrays, in a single call. Keys[i] maps to Values[i] */
+	UFUNCTION(BlueprintCallable, Category = "Utilities | Map", CustomThunk,
+			  meta = (DisplayName = "Pairs To Arrays", MapParam = "TargetMap", MapKeyParam = "Keys", MapValueParam = "Values", BlueprintThreadSafe))
+	static void Map_PairsToArrays(const TMap<int32, int32>& TargetMap, TArray<int32>& Keys, TArray<int32>& Values);
+
+	/**
+	 * Copies the keys and/or the values of the map to the provided arrays, trivially copyable elements are copied with
+	 * a memcpy instead of going through their property. Null arrays are skipped, and arrays of another type than the
+	 * keys or values are left untouched with a warning.
+	 */
+	static void GenericMap_ToArrays(void* TargetMap, const FMapProperty* MapProp, void* KeysArray, const FArrayProperty* KeysArrayProp,
+	                                void* ValuesArray, const FArrayProperty* ValuesArrayProp);
+	DECLARE_FUNCTION(execMap_PairsToArrays)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FMapProperty>(nullptr);
+		void* MapAddr = Stack.MostRecentPropertyAddress;
+		const FMapProperty* MapProperty = CastField<FMapProperty>(Stack.MostRecentProperty);
+		if (!MapProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+		void* KeysAddr = Stack.MostRecentPropertyAddress;
+		const FArrayProperty* KeysProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+		void* ValuesAddr = Stack.MostRecentPropertyAddress;
+		const FArrayProperty* ValuesProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+		if (!KeysProperty || !ValuesProperty)
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_FINISH;
+
+		P_NATIVE_BEGIN;
+		GenericMap_ToArrays(MapAddr, MapProperty, KeysAddr, KeysProperty, ValuesAddr, ValuesProperty);
+		P_NATIVE_END;
+	}
 };
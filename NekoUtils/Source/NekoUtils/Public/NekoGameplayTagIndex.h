@@ -0,0 +1,125 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#pragma once
+
+#include "Containers/ArrayView.h"
+#include "GameplayTagContainer.h"
+
+
+/**
+ * Snapshot of the gameplay tag tree, laid out in pre-order in contiguous arrays, so that the descendants of any tag are
+ * the [Index + 1, SubtreeEnd) range right after it.
+ *
+ * Children, descendants and ancestry queries are then only index comparisons and array walks, without going through
+ * the shared pointers of FGameplayTagNode or allocating any container.
+ *
+ * It also interns the leaf name of every tag (e.g. "z" for x.y.z), both as a FName and as an ANSI string, so that
+ * systems using leaf names as IDs (e.g. Steam achievements in NekoSteam) never have to parse or convert them again.
+ *
+ * The snapshot is built by the NekoUtils module once the native tags are added, and rebuilt every time the tag tree
+ * changes, which invalidates every index taken from it (see GetVersion). Only usable from the game thread.
+ */
+class NEKOUTILS_API FNekoGameplayTagIndex final
+{
+public:
+	static FNekoGameplayTagIndex& Get();
+
+	~FNekoGameplayTagIndex();
+
+	// The number of tags in the tree, including the implicit parent tags
+	int32 Num() const { return Tags.Num(); }
+
+	// Incremented every time the snapshot is rebuilt
+	uint32 GetVersion() const { return Version; }
+
+	// Gets the index of the provided tag, INDEX_NONE if it is not registered
+	int32 FindIndex(const FGameplayTag& Tag) const
+	{
+		const int32* Index = TagIndices.Find(Tag);
+		return Index ? *Index : INDEX_NONE;
+	}
+
+	const FGameplayTag& GetTag(const int32 Index) const { return Tags[Index]; }
+
+	// Gets the index of the parent of the provided tag, INDEX_NONE for root tags
+	int32 GetParentIndex(const int32 Index) const { return ParentIndices[Index]; }
+
+	// Gets the index right after the last descendant of the provided tag
+	int32 GetSubtreeEnd(const int32 Index) const { return SubtreeEnds[Index]; }
+
+	// Gets the number of children of the children, recursively
+	int32 GetNumDescendants(const int32 Index) const { return SubtreeEnds[Index] - Index - 1; }
+
+	// Gets the number of direct children
+	int32 GetNumChildren(const int32 Index) const;
+
+	// Whether the tag at Index is a child, or a child of a child, of the tag at AncestorIndex. A tag isn't its own descendant
+	bool IsDescendant(const int32 Index, const int32 AncestorIndex) const
+	{
+		return Index > AncestorIndex && Index < SubtreeEnds[AncestorIndex];
+	}
+
+	// Gets the last component of the name of the provided tag
+	FName GetLeafName(const int32 Index) const { return LeafNames[Index]; }
+
+	// Gets the last component of the name of the provided tag, as a null-terminated ANSI string
+	const ANSICHAR* GetLeafAnsiName(const int32 Index) const { return &LeafAnsiNames[LeafAnsiNameOffsets[Index]]; }
+
+	// Gets the last component of the name of the provided tag, NAME_None if it is not registered
+	FName FindLeafName(const FGameplayTag& Tag) const
+	{
+		const int32 Index = FindIndex(Tag);
+		return Index != INDEX_NONE ? LeafNames[Index] : NAME_None;
+	}
+
+	// Gets the ANSI version of a name that is the leaf of at least one tag, nullptr if no tag ends with it
+	const ANSICHAR* FindLeafAnsiName(const FName LeafName) const
+	{
+		const int32* Index = LeafNameIndices.Find(LeafName);
+		return Index ? GetLeafAnsiName(*Index) : nullptr;
+	}
+
+	// Every descendant of the provided tag, in pre-order
+	TConstArrayView<FGameplayTag> GetDescendants(const int32 Index) const
+	{
+		return MakeArrayView(Tags).Slice(Index + 1, GetNumDescendants(Index));
+	}
+
+	// Calls the provided function with the index of every direct child of the provided tag
+	template <typename FunctionType>
+	void ForEachChild(const int32 Index, FunctionType&& Function) const
+	{
+		for (int32 ChildIndex = Index + 1; ChildIndex < SubtreeEnds[Index]; ChildIndex = SubtreeEnds[ChildIndex])
+		{
+			Function(ChildIndex);
+		}
+	}
+
+private:
+	FNekoGameplayTagIndex();
+
+	// Walks the whole tag tree again
+	void Rebuild();
+
+private:
+	// Every tag of the tree, in pre-order
+	TArray<FGameplayTag> Tags;
+
+	TArray<int32> SubtreeEnds;
+	TArray<int32> ParentIndices;
+
+	TMap<FGameplayTag, int32> TagIndices;
+
+	TArray<FName> LeafNames;
+
+	// Every ANSI leaf name, null-terminated and packed one after the other
+	TArray<ANSICHAR> LeafAnsiNames;
+	TArray<int32> LeafAnsiNameOffsets;
+
+	// Maps a leaf name to the index of the first tag ending with it
+	TMap<FName, int32> LeafNameIndices;
+
+	uint32 Version = 0;
+
+	FDelegateHandle TagTreeChangedHandle;
+};
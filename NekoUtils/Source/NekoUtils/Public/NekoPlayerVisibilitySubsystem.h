@@ -0,0 +1,126 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#pragma once
+
+#include "Subsystems/LocalPlayerSubsystem.h"
+
+#include "NekoPlayerVisibilitySubsystem.generated.h"
+
+class AActor;
+class APlayerController;
+class UPrimitiveComponent;
+
+
+UENUM(BlueprintType)
+enum class ENekoActorHidingMode : uint8
+{
+	// Hides actors through APlayerController::HiddenActors, their components are gathered again every frame
+	HiddenActors,
+	// Hides the primitive components of actors through APlayerController::HiddenPrimitiveComponents, so that they
+	// don't have to be gathered every frame. Components added to an actor after it was hidden stay visible
+	HiddenPrimitiveComponents,
+	// Flags the primitive components of actors as hidden from their owner, and makes the view target of the player their
+	// owner, so that nothing is added to the lists walked for every view and the cost stays flat however many actors
+	// are hidden. Only meant for local, cosmetic actors: an actor can only be hidden this way from a single player, its
+	// owner is replaced while it is hidden, and it shows again if the player's view target changes. Components added to
+	// an actor after it was hidden stay visible
+	OwnerNoSee
+};
+
+/**
+ * Hides actors for a single local player, e.g. per-player cosmetics in split-screen.
+ *
+ * Hidden actors are kept in a set, so hiding an actor twice doesn't grow the lists walked by the renderer for every
+ * view, and they can be unhidden. Only the entries added by this subsystem are removed from the lists of the player
+ * controller, so actors also hidden by other code stay hidden. The hidden actors are moved over when the player
+ * controller changes.
+ *
+ * The lists of the player controller are still walked for every view, and once per unhide, so with many hidden actors
+ * prefer ENekoActorHidingMode::OwnerNoSee, whose cost doesn't depend on the number of hidden actors.
+ */
+UCLASS()
+class NEKOUTILS_API UNekoPlayerVisibilitySubsystem final : public ULocalPlayerSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UNekoPlayerVisibilitySubsystem* Get(const APlayerController* Player);
+
+	// Begin USubsystem interface
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	// Begin ULocalPlayerSubsystem interface
+	virtual void PlayerControllerChanged(APlayerController* NewPlayerController) override;
+	// End ULocalPlayerSubsystem interface
+
+	UFUNCTION(BlueprintCallable, Category = "Player | Visibility")
+	void HideActor(AActor* Actor);
+
+	UFUNCTION(BlueprintCallable, Category = "Player | Visibility")
+	void UnhideActor(AActor* Actor);
+
+	UFUNCTION(BlueprintCallable, Category = "Player | Visibility")
+	void HideActors(const TArray<AActor*>& Actors);
+
+	UFUNCTION(BlueprintCallable, Category = "Player | Visibility")
+	void UnhideActors(const TArray<AActor*>& Actors);
+
+	// Hides every actor of the world that has the provided tag
+	UFUNCTION(BlueprintCallable, Category = "Player | Visibility")
+	void HideActorsWithTag(const FName Tag);
+
+	// Unhides every hidden actor that has the provided tag
+	UFUNCTION(BlueprintCallable, Category = "Player | Visibility")
+	void UnhideActorsWithTag(const FName Tag);
+
+	UFUNCTION(BlueprintCallable, Category = "Player | Visibility")
+	void UnhideAllActors();
+
+	UFUNCTION(BlueprintPure, Category = "Player | Visibility")
+	bool IsActorHidden(const AActor* Actor) const;
+
+	UFUNCTION(BlueprintPure, Category = "Player | Visibility")
+	int32 GetNumHiddenActors() const { return HiddenActors.Num(); }
+
+	UFUNCTION(BlueprintPure, Category = "Player | Visibility")
+	ENekoActorHidingMode GetHidingMode() const { return HidingMode; }
+
+	// Changes how the actors are hidden, moving the actors that are already hidden over
+	UFUNCTION(BlueprintCallable, Category = "Player | Visibility")
+	void SetHidingMode(const ENekoActorHidingMode NewHidingMode);
+
+private:
+	// How an actor hidden in ENekoActorHidingMode::OwnerNoSee was changed, so that it can be restored
+	struct FOwnerNoSeeActor
+	{
+		TWeakObjectPtr<AActor> OriginalOwner;
+
+		// The owner set to hide the actor, null if the view target already was in its owner chain
+		TWeakObjectPtr<AActor> AppliedOwner;
+
+		// The components that weren't already hidden from their owner
+		TArray<TWeakObjectPtr<UPrimitiveComponent>> Components;
+	};
+
+	// Adds the actor to the hidden lists of the player controller, or flags its components
+	void ApplyHiddenActor(APlayerController& PlayerController, AActor& Actor);
+
+	// Removes the provided actors from the hidden lists of the player controller in a single pass over each list, or
+	// restores their components
+	void RemoveHiddenActors(APlayerController& PlayerController, const TSet<TWeakObjectPtr<AActor>>& Actors);
+
+	// Forgets the hidden actors that were destroyed
+	void PruneHiddenActors();
+
+private:
+	TSet<TWeakObjectPtr<AActor>> HiddenActors;
+
+	// The actors hidden in ENekoActorHidingMode::OwnerNoSee
+	TMap<TWeakObjectPtr<AActor>, FOwnerNoSeeActor> OwnerNoSeeActors;
+
+	// The player controller whose hidden lists hold the hidden actors
+	TWeakObjectPtr<APlayerController> AppliedPlayerController;
+
+	ENekoActorHidingMode HidingMode = ENekoActorHidingMode::HiddenActors;
+};
@@ -0,0 +1,72 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#pragma once
+
+#include "Components/ActorComponent.h"
+
+#include "NekoSmoothFollowComponent.generated.h"
+
+class USceneComponent;
+
+
+/**
+ * Smoothly moves the root component of its owner towards a target component, using exponential decay on its location
+ * and rotation (see UNekoFunctionLibrary::ExponentialDecay_Vector and UNekoFunctionLibrary::ExponentialDecay_Quat).
+ *
+ * The component doesn't tick on its own: every follower of a world is updated by UNekoSmoothFollowSubsystem in a single
+ * pass per tick group.
+ */
+UCLASS(ClassGroup = (Neko), meta = (BlueprintSpawnableComponent))
+class NEKOUTILS_API UNekoSmoothFollowComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UNekoSmoothFollowComponent();
+
+	// Begin UActorComponent interface
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	// End UActorComponent interface
+
+	UFUNCTION(BlueprintCallable, Category = "Smooth Follow")
+	void SetFollowTarget(USceneComponent* NewFollowTarget);
+
+	UFUNCTION(BlueprintPure, Category = "Smooth Follow")
+	USceneComponent* GetFollowTarget() const { return FollowTarget.Get(); }
+
+	// Moves the owner to the target right away, e.g. after a teleport
+	UFUNCTION(BlueprintCallable, Category = "Smooth Follow")
+	void SnapToTarget();
+
+	// The component moved towards the target, which is the root component of the owner
+	USceneComponent* GetUpdatedComponent() const;
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Smooth Follow")
+	bool bFollowLocation = true;
+
+	// Decay constant. Approximately from 1 to 25, slow to fast.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Smooth Follow", meta = (ClampMin = "0.0", EditCondition = "bFollowLocation"))
+	float LocationDecay = 16.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Smooth Follow")
+	bool bFollowRotation = true;
+
+	// Decay constant. Approximately from 1 to 25, slow to fast.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Smooth Follow", meta = (ClampMin = "0.0", EditCondition = "bFollowRotation"))
+	float RotationDecay = 16.0f;
+
+	// The tick group in which the owner is moved, can't be changed once the component has begun play
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Smooth Follow")
+	TEnumAsByte<ETickingGroup> FollowTickGroup = TG_PostPhysics;
+
+private:
+	UPROPERTY(Transient)
+	TWeakObjectPtr<USceneComponent> FollowTarget;
+
+	// Index in the arrays of UNekoSmoothFollowSubsystem, INDEX_NONE when not registered to it
+	int32 FollowerIndex = INDEX_NONE;
+
+	friend class UNekoSmoothFollowSubsystem;
+};
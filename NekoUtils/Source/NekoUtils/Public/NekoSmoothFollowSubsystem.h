@@ -0,0 +1,96 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#pragma once
+
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "NekoSmoothFollowSubsystem.generated.h"
+
+class UNekoSmoothFollowComponent;
+class UNekoSmoothFollowSubsystem;
+
+
+/**
+ * Tick function updating every UNekoSmoothFollowComponent of one tick group
+ */
+USTRUCT()
+struct FNekoSmoothFollowTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UNekoSmoothFollowSubsystem* Subsystem = nullptr;
+
+	// Begin FTickFunction interface
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+	virtual FName DiagnosticContext(bool bDetailed) override;
+	// End FTickFunction interface
+};
+
+template <>
+struct TStructOpsTypeTraits<FNekoSmoothFollowTickFunction> : public TStructOpsTypeTraitsBase2<FNekoSmoothFollowTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/**
+ * World subsystem updating every UNekoSmoothFollowComponent of its world.
+ *
+ * Followers are grouped by tick group, and each group is updated by a single tick function: the locations and rotations
+ * are first gathered in contiguous arrays, then decayed, and finally written back to the components. The locations of
+ * the whole group are decayed in one vectorized pass by NekoDecay::Apply, the rotations are slerped one by one.
+ */
+UCLASS()
+class NEKOUTILS_API UNekoSmoothFollowSubsystem final : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Begin USubsystem interface
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	void RegisterFollower(UNekoSmoothFollowComponent* Follower);
+	void UnregisterFollower(UNekoSmoothFollowComponent* Follower);
+
+	// Updates every follower of the provided tick group, called by its tick function
+	void TickFollowers(const ETickingGroup TickGroup, const float DeltaTime);
+
+private:
+	struct FFollowerGroup
+	{
+		FNekoSmoothFollowTickFunction TickFunction;
+
+		// Null while a follower unregistered during the tick of the group, until the end of it. Weak, since nothing
+		// reports them to the garbage collector, and the components are owned by their actors anyway
+		TArray<TWeakObjectPtr<UNekoSmoothFollowComponent>> Followers;
+
+		bool bIsTicking = false;
+		bool bHasRemovedFollowers = false;
+
+		// Gathered from the followers every tick, kept to avoid allocating
+		TArray<FVector> Locations;
+		TArray<FVector> TargetLocations;
+		// One factor per channel of the locations, so that they can be decayed as a flat array of doubles
+		TArray<double> LocationFactors;
+		TArray<FQuat> Rotations;
+		TArray<FQuat> TargetRotations;
+		TArray<double> RotationFactors;
+	};
+
+	// Sets the factor of every channel of the location of the follower at the provided index
+	static void SetLocationFactor(FFollowerGroup& Group, const int32 Index, const double Factor);
+
+	// Lets the follower at the provided index know where it was moved to
+	static void UpdateFollowerIndex(FFollowerGroup& Group, const int32 Index);
+
+	// Removes the followers that unregistered during the tick of the group
+	static void RemoveUnregisteredFollowers(FFollowerGroup& Group);
+
+	// Created when the first follower of a tick group registers, so that its tick function never moves in memory
+	TUniquePtr<FFollowerGroup> Groups[TG_MAX];
+};
@@ -0,0 +1,97 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#pragma once
+
+#include "Containers/ArrayView.h"
+#include "Math/Quat.h"
+#include "Math/Vector.h"
+
+#include "NekoSpring.generated.h"
+
+
+/**
+ * State of a float spring, to keep between two updates
+ */
+USTRUCT(BlueprintType)
+struct NEKOUTILS_API FNekoSpringFloat
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spring")
+	double Value = 0.0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spring")
+	double Velocity = 0.0;
+};
+
+/**
+ * State of a vector spring, to keep between two updates
+ */
+USTRUCT(BlueprintType)
+struct NEKOUTILS_API FNekoSpringVector
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spring")
+	FVector Value = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spring")
+	FVector Velocity = FVector::ZeroVector;
+};
+
+/**
+ * State of a rotation spring, to keep between two updates
+ */
+USTRUCT(BlueprintType)
+struct NEKOUTILS_API FNekoSpringQuat
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spring")
+	FQuat Value = FQuat::Identity;
+
+	// Rotation vector per second, in radians
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spring")
+	FVector AngularVelocity = FVector::ZeroVector;
+};
+
+/**
+ * Damped springs, solved analytically so that they don't depend on the framerate at all, and keep their velocity when
+ * their target changes (unlike ExponentialDecay, which restarts from a velocity of zero).
+ *
+ * For a given frequency, damping ratio and delta time, a spring update is a 2x2 matrix applied to the offset from the
+ * target and the velocity. That matrix is computed once in NekoSpring::FCoefficients, so updating many springs sharing the
+ * same parameters is only a few multiply-adds per value, which the batched functions run four doubles at a time.
+ *
+ * See https://www.ryanjuckett.com/damped-springs/
+ */
+namespace NekoSpring
+{
+	struct NEKOUTILS_API FCoefficients
+	{
+		double PositionFromPosition = 1.0;
+		double PositionFromVelocity = 0.0;
+		double VelocityFromPosition = 0.0;
+		double VelocityFromVelocity = 1.0;
+
+		/**
+		 * @param Frequency Number of oscillations per second when undamped
+		 * @param DampingRatio 1 is critically damped (fastest without overshooting), lower values bounce and higher
+		 *                     values are slower
+		 */
+		static FCoefficients Compute(const float Frequency, const float DampingRatio, const float DeltaTime);
+	};
+
+	NEKOUTILS_API void Update(FNekoSpringFloat& Spring, const double Target, const FCoefficients& Coefficients);
+	NEKOUTILS_API void Update(FNekoSpringVector& Spring, const FVector& Target, const FCoefficients& Coefficients);
+
+	// Springs along the shortest path towards the target
+	NEKOUTILS_API void Update(FNekoSpringQuat& Spring, const FQuat& Target, const FCoefficients& Coefficients);
+
+	/**
+	 * Updates every spring towards the target at the same index, all sharing the same coefficients.
+	 * The values and velocities are stored in separate arrays, which must all have the same size.
+	 */
+	NEKOUTILS_API void UpdateBatch(TArrayView<double> Values, TArrayView<double> Velocities, TConstArrayView<double> Targets, const FCoefficients& Coefficients);
+	NEKOUTILS_API void UpdateBatch(TArrayView<FVector> Values, TArrayView<FVector> Velocities, TConstArrayView<FVector> Targets, const FCoefficients& Coefficients);
+}
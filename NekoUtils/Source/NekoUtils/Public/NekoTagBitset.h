@@ -0,0 +1,80 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#pragma once
+
+#include "GameplayTagContainer.h"
+
+#include "NekoTagBitset.generated.h"
+
+
+/**
+ * A compact alternative to FGameplayTagContainer for hot paths, storing one bit per tag of FNekoGameplayTagIndex.
+ *
+ * Like FGameplayTagContainer, it keeps both the tags that were explicitly added and the same tags with all of their
+ * parents, so the matching functions behave the same way. Instead of scanning arrays of tags, they are only a few
+ * AND and compare operations on 128 bits at a time.
+ *
+ * The bits are indices in the gameplay tag index, so bitsets built before the tag tree changes (which only happens in
+ * the editor, or when tags are added at runtime) must be built again. Until then, a warning is logged once and they don't
+ * match anything, and adding a tag to one drops its previous tags. Only usable from the game thread.
+ *
+ * For the same reason, the bits are not serialized: a bitset saved in an asset, a save game or a replicated property is
+ * always empty once loaded. Store the FGameplayTagContainer instead, and build the bitset from it at runtime.
+ */
+USTRUCT(BlueprintType)
+struct NEKOUTILS_API FNekoTagBitset
+{
+	GENERATED_BODY()
+
+	FNekoTagBitset() = default;
+	explicit FNekoTagBitset(const FGameplayTagContainer& Container);
+
+	void AddTag(const FGameplayTag& Tag);
+	void Reset();
+
+	bool IsEmpty() const { return ExplicitWords.IsEmpty(); }
+
+	// Whether this contains the provided tag or one of its children, same as FGameplayTagContainer::HasTag
+	bool HasTag(const FGameplayTag& Tag) const;
+
+	// Whether this contains exactly the provided tag, same as FGameplayTagContainer::HasTagExact
+	bool HasTagExact(const FGameplayTag& Tag) const;
+
+	// Whether this contains any tag of Other or any of their children, same as FGameplayTagContainer::HasAny
+	bool HasAny(const FNekoTagBitset& Other) const;
+
+	// Whether this contains every tag of Other or any of their children, same as FGameplayTagContainer::HasAll
+	bool HasAll(const FNekoTagBitset& Other) const;
+
+	// Whether this contains exactly any tag of Other, same as FGameplayTagContainer::HasAnyExact
+	bool HasAnyExact(const FNekoTagBitset& Other) const;
+
+	// Whether this contains exactly every tag of Other, same as FGameplayTagContainer::HasAllExact
+	bool HasAllExact(const FNekoTagBitset& Other) const;
+
+	// Whether both bitsets contain exactly the same tags
+	bool operator==(const FNekoTagBitset& Other) const;
+
+	// Whether the bitset was built with the current version of the gameplay tag index
+	bool IsUpToDate() const;
+
+	FGameplayTagContainer ToContainer() const;
+
+private:
+	// Lets the automation tests make bitsets stale without rebuilding the gameplay tag index
+	friend struct FNekoGameplayTagTestAccess;
+
+	using FWords = TArray<uint64, TInlineAllocator<4>>;
+
+	// Whether the bits of both bitsets refer to the same version of the gameplay tag index, logs a warning if not
+	bool IsCompatibleWith(const FNekoTagBitset& Other) const;
+
+	// Bits of the tags that were explicitly added. Not UPROPERTYs on purpose, see above
+	FWords ExplicitWords;
+
+	// Bits of the explicit tags and all of their parents
+	FWords ExpandedWords;
+
+	// Version of the gameplay tag index the bits refer to
+	uint32 Version = 0;
+};
@@ -0,0 +1,94 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#pragma once
+
+#include "GameplayTagContainer.h"
+#include "UObject/Object.h"
+
+#include "NekoTagSampler.generated.h"
+
+
+UENUM(BlueprintType)
+enum class ENekoTagSamplerMode : uint8
+{
+	// Every draw is independent, using the weights of the tags
+	Weighted,
+	// Every tag is drawn once, in a random order, before any of them can be drawn again. Weights are ignored
+	ShuffleBag
+};
+
+/**
+ * Draws random tags from a set prepared once, instead of picking from a container every time.
+ *
+ * Weighted draws use an alias table (Vose's method), so every draw is constant time however many tags there are. All the
+ * draws go through the sampler's own random stream, so they can be reproduced from the same seed, e.g. for replays.
+ */
+UCLASS(BlueprintType)
+class NEKOUTILS_API UNekoTagSampler final : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Creates a sampler drawing from the provided tags
+	 *
+	 * @param Weights The relative weight of each tag, in the order of the container. Tags without any weight have a
+	 *                weight of 1, so leave it empty to draw every tag with the same probability
+	 * @param Seed The seed of the random stream of the sampler
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Gameplay Tags | Sampler", meta = (AutoCreateRefTerm = "Weights"))
+	static UNekoTagSampler* CreateTagSampler(const FGameplayTagContainer& GameplayTagContainer, const TArray<float>& Weights,
+	                                         const ENekoTagSamplerMode Mode, const int32 Seed);
+
+	/**
+	 * Draws a random tag, EmptyTag if the sampler has no tags
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Gameplay Tags | Sampler")
+	FGameplayTag DrawTag();
+
+	/**
+	 * Draws the provided number of random tags at once
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Gameplay Tags | Sampler")
+	TArray<FGameplayTag> DrawTags(const int32 Count);
+
+	/**
+	 * Restarts the random stream from the provided seed, and refills the shuffle bag
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Gameplay Tags | Sampler")
+	void SetSeed(const int32 Seed);
+
+	UFUNCTION(BlueprintPure, Category = "Gameplay Tags | Sampler")
+	int32 GetNumTags() const { return Tags.Num(); }
+
+	// Prepares the sampler, replacing the previous tags
+	void Initialize(const FGameplayTagContainer& GameplayTagContainer, TConstArrayView<float> Weights, const ENekoTagSamplerMode Mode);
+
+private:
+	// Draws the index of a tag
+	int32 DrawIndex();
+
+	// Builds the alias table from the provided weights
+	void BuildAliasTable(TConstArrayView<float> Weights);
+
+	// Refills and shuffles the bag, making sure that the same tag isn't drawn twice in a row between two bags
+	void RefillBag();
+
+private:
+	UPROPERTY()
+	TArray<FGameplayTag> Tags;
+
+	UPROPERTY()
+	ENekoTagSamplerMode Mode = ENekoTagSamplerMode::Weighted;
+
+	UPROPERTY()
+	FRandomStream RandomStream;
+
+	// Probability of keeping each column of the alias table, instead of taking its alias
+	TArray<float> Probabilities;
+	TArray<int32> Aliases;
+
+	// Indices of the tags in the order they get drawn, and index of the next one
+	TArray<int32> Bag;
+	int32 BagCursor = 0;
+};
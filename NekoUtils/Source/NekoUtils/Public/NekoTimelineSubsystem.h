@@ -0,0 +1,518 @@
+// MIT License - Copyright (c) Juniper Bouchard
+
+#pragma once
+
+#include "Containers/SparseArray.h"
+#include "Engine/LatentActionManager.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+
+#include "NekoTimelineSubsystem.generated.h"
+
+class AActor;
+class UCurveBase;
+class UCurveFloat;
+class UCurveLinearColor;
+class UCurveVector;
+struct FNekoBakedCurve;
+
+
+UENUM()
+enum class EPseudoTimelineOutputPins : uint8
+{
+	Update,
+	Finished
+};
+
+UENUM(BlueprintType)
+enum class ENekoPseudoTimelinePlayMode : uint8
+{
+	// Plays the curve once, then fires Finished
+	Once,
+	// Plays the curve again from the start at the end of every cycle
+	Loop,
+	// Plays the curve in the other direction at the end of every cycle
+	PingPong
+};
+
+/**
+ * Optional settings of a pseudo-timeline node.
+ */
+USTRUCT(BlueprintType)
+struct NEKOUTILS_API FNekoPseudoTimelineOptions
+{
+	GENERATED_BODY()
+
+	/**
+	 * Samples the curve from a lookup table shared by every pseudo-timeline using it, instead of evaluating the curve
+	 * every frame. Cheaper, but less precise on curves with very sharp changes.
+	 *
+	 * @see FNekoBakedCurve
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pseudo Timeline")
+	bool bBakeCurve = false;
+
+	/**
+	 * Maximum number of Update executions per second, 0 to update every frame.
+	 * The last Update, with a progress of 1.0, is always executed before Finished.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pseudo Timeline", meta = (ClampMin = "0.0", Units = "Hertz"))
+	float MaxUpdateRate = 0.0f;
+
+	/**
+	 * Skips Update when Alpha changed by less than this amount since the last Update, 0 to never skip it.
+	 * The last Update, with a progress of 1.0, is always executed before Finished.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pseudo Timeline", meta = (ClampMin = "0.0"))
+	float MinAlphaDelta = 0.0f;
+
+	/**
+	 * How the pseudo-timeline continues once it reaches the end of the curve. Cycles are chained within the same tick,
+	 * so no time is lost between them, and Finished is only fired at the end of the last one.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pseudo Timeline")
+	ENekoPseudoTimelinePlayMode PlayMode = ENekoPseudoTimelinePlayMode::Once;
+
+	/**
+	 * Number of cycles to play before finishing, 0 to play forever. When ping-ponging, each direction is one cycle.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pseudo Timeline", meta = (ClampMin = "0", EditCondition = "PlayMode != ENekoPseudoTimelinePlayMode::Once"))
+	int32 LoopCount = 0;
+
+	// Plays the first cycle from a progress of 1.0 to 0.0
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pseudo Timeline")
+	bool bReverse = false;
+
+	/**
+	 * Fraction of the first cycle that is skipped, e.g. 0.25 starts from a progress of 0.25, or 0.75 when reversed
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pseudo Timeline", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float StartPosition = 0.0f;
+};
+
+UENUM(BlueprintType)
+enum class ENekoTimelineTargetType : uint8
+{
+	None,
+	// A float, double, vector or linear color UPROPERTY
+	Property,
+	MaterialScalarParameter,
+	MaterialVectorParameter,
+	Widget
+};
+
+UENUM(BlueprintType)
+enum class ENekoWidgetRenderField : uint8
+{
+	RenderOpacity,
+	RenderTranslation,
+	RenderScale,
+	RenderShear,
+	RenderAngle
+};
+
+/**
+ * Something that a pseudo-timeline can drive natively, without going through the Blueprint VM every frame.
+ * Every frame, Lerp(A, B, Alpha) is written to the target.
+ *
+ * Use the "Make Timeline Target" functions of UNekoFunctionLibrary to create one.
+ */
+USTRUCT(BlueprintType)
+struct NEKOUTILS_API FNekoTimelineTarget
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	ENekoTimelineTargetType Type = ENekoTimelineTargetType::None;
+
+	// The object owning the property, the material instance or the widget to drive
+	UPROPERTY()
+	TWeakObjectPtr<UObject> Object;
+
+	// Path to the property (e.g. "LightComponent.Intensity"), or the name of the material parameter
+	UPROPERTY()
+	FName Name;
+
+	UPROPERTY()
+	ENekoWidgetRenderField WidgetField = ENekoWidgetRenderField::RenderOpacity;
+
+	// Single values are stored in X, 2D values in X and Y, and colors in X, Y, Z, W
+	UPROPERTY()
+	FVector4 A = FVector4(0.0, 0.0, 0.0, 0.0);
+
+	UPROPERTY()
+	FVector4 B = FVector4(0.0, 0.0, 0.0, 0.0);
+};
+
+/**
+ * Typed value written by a pseudo-timeline instead of a float alpha, either interpolated between two endpoints using the
+ * alpha, or sampled from a vector or linear color curve. Every channel is evaluated in one pass.
+ *
+ * Used by the typed variants of UNekoFunctionLibrary::PseudoTimeline
+ */
+struct NEKOUTILS_API FNekoTimelineTypedOutput
+{
+	enum class EValueType : uint8
+	{
+		Vector,
+		Rotator,
+		LinearColor,
+		Transform
+	};
+
+	static FNekoTimelineTypedOutput MakeVector(FVector& OutValue, const FVector& A, const FVector& B);
+	static FNekoTimelineTypedOutput MakeVector(FVector& OutValue, const UCurveVector* Curve);
+	static FNekoTimelineTypedOutput MakeRotator(FRotator& OutValue, const FRotator& A, const FRotator& B);
+	static FNekoTimelineTypedOutput MakeLinearColor(FLinearColor& OutValue, const FLinearColor& A, const FLinearColor& B);
+	static FNekoTimelineTypedOutput MakeLinearColor(FLinearColor& OutValue, const UCurveLinearColor* Curve);
+	static FNekoTimelineTypedOutput MakeTransform(FTransform& OutValue, const FTransform& A, const FTransform& B);
+
+	EValueType Type = EValueType::Vector;
+
+	// The value to write, it is a _reference_ taken from the blueprint node
+	void* Value = nullptr;
+
+	// When set, the value is sampled from this vector or linear color curve at the current progress, instead of A and B.
+	// Kept alive by the subsystem while the pseudo-timeline runs
+	const UCurveBase* Curve = nullptr;
+
+	// Lookup table of Curve, set by the subsystem if the pseudo-timeline bakes its curves
+	const FNekoBakedCurve* BakedCurve = nullptr;
+
+	// Endpoints of vectors, colors and translations
+	FVector4 A = FVector4(0.0, 0.0, 0.0, 0.0);
+	FVector4 B = FVector4(0.0, 0.0, 0.0, 0.0);
+
+	// Endpoints of rotations, slerped
+	FQuat RotationA = FQuat::Identity;
+	FQuat RotationB = FQuat::Identity;
+
+	// Endpoints of scales
+	FVector ScaleA = FVector::OneVector;
+	FVector ScaleB = FVector::OneVector;
+
+	// Writes the value at the provided progress and alpha
+	void Write(const float Progress, const float Alpha) const;
+};
+
+/**
+ * Counters of the pseudo-timeline storage of a world
+ */
+USTRUCT(BlueprintType)
+struct NEKOUTILS_API FNekoTimelinePoolStats
+{
+	GENERATED_BODY()
+
+	// Number of pseudo-timelines currently running
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Pseudo Timeline")
+	int32 Live = 0;
+
+	// Highest number of pseudo-timelines that ran at the same time
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Pseudo Timeline")
+	int32 Peak = 0;
+
+	// Number of pseudo-timelines that can run without allocating any memory
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Pseudo Timeline")
+	int32 Capacity = 0;
+
+	// Number of times the storage had to grow because it was full
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Pseudo Timeline")
+	int32 PoolMisses = 0;
+};
+
+/**
+ * World subsystem running every pseudo-timeline of its world, making it similar to timelines in that way, but can be
+ * used anywhere that can use latent nodes.
+ *
+ * Instead of creating one latent action per node, the state of every running pseudo-timeline is stored in contiguous
+ * arrays that are all advanced in a single loop per frame. The Blueprint VM is only entered to fire the Update and
+ * Finished pins of the nodes. Pseudo-timelines driving a FNekoTimelineTarget don't even do that for Update.
+ *
+ * The arrays act as a pool: finished pseudo-timelines free their slot without releasing any memory, and the storage is
+ * reserved up front (see InitialCapacity), so starting and finishing pseudo-timelines never touches the general
+ * allocator once warmed up.
+ *
+ * Like latent actions, each pseudo-timeline follows the clock of the object that started it: widgets keep running while
+ * the game is paused and ignore time dilation, actors and their components are scaled by the actor's CustomTimeDilation
+ * and stop while the world is paused, and any other object follows the world's time.
+ *
+ * Used by UNekoFunctionLibrary::PseudoTimeline, UNekoFunctionLibrary::RetriggerablePseudoTimeline and
+ * UNekoFunctionLibrary::PseudoTimelineToTarget
+ */
+UCLASS(Config = Game)
+class NEKOUTILS_API UNekoTimelineSubsystem final : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Begin USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	// End USubsystem interface
+
+	// Begin UObject interface
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+	// End UObject interface
+
+	// Begin FTickableGameObject interface
+	virtual void Tick(const float DeltaTime) override;
+	virtual bool IsTickable() const override { return !ElapsedTimes.IsEmpty(); }
+	virtual bool IsTickableWhenPaused() const override { return true; }
+	virtual TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(UNekoTimelineSubsystem, STATGROUP_Tickables); }
+	// End FTickableGameObject interface
+
+	/**
+	 * Starts a pseudo-timeline for the provided latent node.
+	 *
+	 * The output parameters are _references_ taken from the blueprint node, they will be updated every frame until the
+	 * pseudo-timeline finishes.
+	 *
+	 * @param bRetrigger Whether to restart the pseudo-timeline if the node is already running one
+	 * @return False if the node was already running a pseudo-timeline and bRetrigger was not set
+	 */
+	bool StartTimeline(const FLatentActionInfo& LatentInfo, const float Time, const UCurveFloat* Curve,
+	                   const FNekoPseudoTimelineOptions& Options, EPseudoTimelineOutputPins& OutputPins,
+	                   float& OutProgress, float& OutAlpha, const bool bRetrigger);
+
+	/**
+	 * Starts a pseudo-timeline for the provided latent node, which writes a typed value instead of a float alpha.
+	 *
+	 * @param Curve The float curve giving the alpha between the endpoints of the output (optional, unused by outputs
+	 *              sampling their own curve)
+	 * @param bRetrigger Whether to restart the pseudo-timeline if the node is already running one
+	 * @return False if the node was already running a pseudo-timeline and bRetrigger was not set
+	 */
+	bool StartTypedTimeline(const FLatentActionInfo& LatentInfo, const float Time, const UCurveFloat* Curve,
+	                        const FNekoPseudoTimelineOptions& Options, const FNekoTimelineTypedOutput& Output,
+	                        EPseudoTimelineOutputPins& OutputPins, float& OutProgress, const bool bRetrigger);
+
+	/**
+	 * Starts a pseudo-timeline for the provided latent node, which writes its value to the provided target every
+	 * frame, and only calls back into the blueprint graph when it is finished.
+	 *
+	 * @param bRetrigger Whether to restart the pseudo-timeline if the node is already running one
+	 * @return False if the target could not be resolved, or if the node was already running a pseudo-timeline and
+	 *         bRetrigger was not set
+	 */
+	bool StartTargetTimeline(const FLatentActionInfo& LatentInfo, const float Time, const UCurveFloat* Curve,
+	                         const FNekoPseudoTimelineOptions& Options, const FNekoTimelineTarget& Target,
+	                         const bool bRetrigger);
+
+	// Whether the provided latent node is currently running a pseudo-timeline
+	bool IsTimelineRunning(const UObject* CallbackTarget, const int32 UUID) const;
+
+	// The number of pseudo-timelines currently running in this world
+	int32 GetNumTimelines() const { return ElapsedTimes.Num(); }
+
+	/**
+	 * Gets the counters of the pseudo-timeline storage, useful to tune InitialCapacity
+	 */
+	UFUNCTION(BlueprintPure, Category = "Utilities | Pseudo Timeline")
+	FNekoTimelinePoolStats GetPoolStats() const;
+
+	/**
+	 * Makes sure that the provided number of pseudo-timelines can run without allocating any memory, e.g. during a
+	 * loading screen before a burst of animations
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Utilities | Pseudo Timeline")
+	void ReserveTimelines(const int32 Capacity);
+
+private:
+	using FTimelineKey = TPair<FObjectKey, int32>;
+
+	enum class ETimelineState : uint8
+	{
+		Running,
+		// Reached the end of its last cycle, the last Update gets fired this tick
+		Completing,
+		// The last Update was fired with a progress of 1.0, Finished gets fired on the next tick
+		Exiting,
+		// Waiting to be removed at the end of the tick
+		Removed
+	};
+
+	// The clock advancing a pseudo-timeline, picked from its callback target when it starts
+	enum class ETimeDomain : uint8
+	{
+		// Dilated world time, stopped while the world is paused
+		World,
+		// World time further dilated by the CustomTimeDilation of the owning actor
+		Actor,
+		// Undilated application time, running even while the world is paused
+		Widget
+	};
+
+	enum class EPropertyValueType : uint8
+	{
+		Float,
+		Double,
+		Vector,
+		LinearColor
+	};
+
+	// A FNekoTimelineTarget, resolved once when the pseudo-timeline starts
+	struct FTimelineBinding
+	{
+		ENekoTimelineTargetType Type = ENekoTimelineTargetType::None;
+		EPropertyValueType PropertyType = EPropertyValueType::Float;
+		ENekoWidgetRenderField WidgetField = ENekoWidgetRenderField::RenderOpacity;
+
+		// The object whose memory holds the value
+		TWeakObjectPtr<UObject> Object;
+
+		// Address of the property value inside of Object
+		void* PropertyValue = nullptr;
+
+		// Set<Property> function of Object taking the value as its only parameter, called instead of writing to memory
+		UFunction* Setter = nullptr;
+		FProperty* SetterParameter = nullptr;
+
+		// Whether Object is a component whose render state has to be recreated after writing to its memory
+		bool bMarkRenderStateDirty = false;
+
+		FName ParameterName;
+		FVector4 A;
+		FVector4 B;
+
+		// Writes Lerp(A, B, Alpha) to the target
+		void Apply(const float Alpha) const;
+
+		// Writes the provided value to a property of the given type
+		static void WriteValue(const EPropertyValueType ValueType, void* Destination, const FVector4& Value);
+	};
+
+	// How a pseudo-timeline plays its cycles, kept to restart it the same way when retriggered
+	struct FTimelinePlayback
+	{
+		ENekoPseudoTimelinePlayMode PlayMode = ENekoPseudoTimelinePlayMode::Once;
+		int32 LoopCount = 0;
+		float StartPosition = 0.0f;
+		bool bReverse = false;
+	};
+
+	// Resolves the target's property path or parameter, returns false if it can't be driven
+	static bool ResolveBinding(const FNekoTimelineTarget& Target, FTimelineBinding& OutBinding);
+
+	// Finds the Set<Property> function of the property's owner, so that it is notified of the change like it would be
+	// from Blueprint, e.g. ULightComponent::SetIntensity for "Intensity"
+	static void ResolveSetter(const FProperty& Property, FTimelineBinding& OutBinding);
+
+	// Resets the elapsed time. Used for retriggering the same pseudo-timeline
+	void RetriggerTimeline(const int32 Index);
+
+	// Puts the timeline at the provided index back at the start of its first cycle
+	void ResetPlayback(const int32 Index);
+
+	// Moves the timeline at the provided index to its next cycle once its elapsed time went past its total time, or
+	// completes it if it was the last one
+	void WrapTimeline(const int32 Index);
+
+	// Samples the curve of the timeline at the provided index at its current progress
+	float SampleAlpha(const int32 Index) const;
+
+	// Picks the clock of a pseudo-timeline started by the provided callback target
+	static ETimeDomain GetTimeDomain(const UObject* CallbackTarget, const AActor*& OutActor);
+
+	// Adds a new timeline at the end of the arrays, without any output slot or binding
+	int32 AddTimeline(const FTimelineKey& Key, const FLatentActionInfo& LatentInfo, const float Time,
+	                  const UCurveFloat* Curve, const FNekoPseudoTimelineOptions& Options);
+
+	// Whether the Update of the timeline at the provided index should be skipped because of its update rate or alpha delta
+	bool ShouldSkipUpdate(const int32 Index) const;
+
+	// Calls back into the blueprint graph that started the timeline at the provided index
+	void FireOutputPin(const int32 Index, const EPseudoTimelineOutputPins Pin);
+
+	// Removes the timelines that finished during the tick, keeping the arrays contiguous
+	void RemoveFinishedTimelines();
+
+	// Drops the lookup tables of the curves that were destroyed anyway, e.g. deleted in the editor, as the cache frees them
+	void HandlePostGarbageCollect();
+
+private:
+	///////////////////////////////////////////////////////////////////////////
+	/// Hot data, advanced every frame
+
+	// The current elapsed time
+	TArray<float> ElapsedTimes;
+
+	// The time for which the pseudo-timeline will execute
+	TArray<float> TotalTimes;
+
+	// The current progress along the curve, from 0 to 1
+	TArray<float> Progresses;
+
+	// The currently sampled value on the curve
+	TArray<float> Alphas;
+
+	// The curve that will be sampled during the execution of the pseudo-timeline (optional), kept alive by
+	// AddReferencedObjects along with the curves of the typed outputs
+	TArray<const UCurveFloat*> Curves;
+
+	// The lookup table of the curve, when the pseudo-timeline samples a baked curve. Only valid as long as the curve is
+	// alive, since FNekoBakedCurveCache frees it once the curve is garbage collected
+	TArray<const FNekoBakedCurve*> BakedCurves;
+
+	TArray<ETimelineState> States;
+
+	TArray<ETimeDomain> TimeDomains;
+
+	// The actor whose CustomTimeDilation scales the pseudo-timeline, only set in the Actor time domain
+	TArray<TWeakObjectPtr<const AActor>> DilationActors;
+
+	// Number of cycles left after the current one, INDEX_NONE when looping forever
+	TArray<int32> RemainingCycles;
+
+	// Whether the current cycle goes from a progress of 1.0 to 0.0
+	TArray<bool> PlaysBackwards;
+
+	// Time since the last Update, and minimum time between two of them
+	TArray<float> TimesSinceUpdate;
+	TArray<float> UpdateIntervals;
+
+	// Alpha of the last Update, NaN until the first one, and minimum change of alpha between two of them
+	TArray<float> UpdatedAlphas;
+	TArray<float> MinAlphaDeltas;
+
+	///////////////////////////////////////////////////////////////////////////
+	/// Output slots, only touched right before going back to the Blueprint VM
+
+	TArray<EPseudoTimelineOutputPins*> OutputPinSlots;
+	TArray<float*> ProgressSlots;
+	TArray<float*> AlphaSlots;
+
+	// Index in Bindings of the target driven by the pseudo-timeline, INDEX_NONE when it fires the Update pin instead
+	TArray<int32> BindingIndices;
+
+	TSparseArray<FTimelineBinding> Bindings;
+
+	// Index in TypedOutputs of the typed value written by the pseudo-timeline, INDEX_NONE when it only writes its alpha
+	TArray<int32> TypedOutputIndices;
+
+	TSparseArray<FNekoTimelineTypedOutput> TypedOutputs;
+
+	///////////////////////////////////////////////////////////////////////////
+	/// Cold data, identifying the blueprint node
+
+	TArray<TWeakObjectPtr<UObject>> CallbackTargets;
+	TArray<UFunction*> ExecutionFunctions;
+	TArray<int32> Linkages;
+	TArray<FTimelineKey> TimelineKeys;
+	TArray<FTimelinePlayback> Playbacks;
+
+	// Maps a latent node (callback target and UUID) to the index of its pseudo-timeline
+	TMap<FTimelineKey, int32> TimelineIndices;
+
+	FDelegateHandle PostGarbageCollectHandle;
+
+	///////////////////////////////////////////////////////////////////////////
+	/// Pool
+
+	// Number of pseudo-timelines reserved when the world starts
+	UPROPERTY(Config)
+	int32 InitialCapacity = 256;
+
+	int32 PeakTimelines = 0;
+
+	int32 PoolMisses = 0;
+};
@@ -27,7 +27,30 @@ public:
 	virtual TOptional<FUIInputConfig> GetDesiredInputConfig() const override;
 	//~End of UCommonActivatableWidget interface
 
+	/** Maximum number of deactivated instances of this class that UNekoRootUILayout keeps for reuse, 0 to not pool it. */
+	int32 GetPoolCapacity() const { return PoolCapacity; }
+
+	/**
+	 * Called by UNekoRootUILayout when this widget is returned to its pool, to put it back in the state of a freshly
+	 * created widget before it is pushed again.
+	 */
+	void ResetForPool();
+
 protected:
+	/** Override to reset the state of this widget when it is returned to its pool. */
+	virtual void NativeResetForPool() {}
+
+	/** Called when this widget is returned to its pool, reset anything set up while it was pushed. */
+	UFUNCTION(BlueprintImplementableEvent, BlueprintCosmetic, Category = "Pool", meta = (DisplayName = "Reset For Pool"))
+	void BP_ResetForPool();
+
+	/**
+	 * Maximum number of deactivated instances of this class that the root layout keeps for reuse, instead of leaving
+	 * them to the garbage collector, 0 to not pool it. Pooled widgets must reset their state in Reset For Pool.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Pool", meta = (ClampMin = "0"))
+	int32 PoolCapacity = 0;
+
 	/** The desired input mode to use while this UI is activated, for example do you want key presses to still reach the game/player controller? */
 	UPROPERTY(EditDefaultsOnly, Category = "Input")
 	ENekoWidgetInputMode InputConfig = ENekoWidgetInputMode::Default;
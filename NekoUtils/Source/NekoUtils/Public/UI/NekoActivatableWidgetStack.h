@@ -0,0 +1,123 @@
+// All Rights Reserved (c) Juniper Bouchard
+
+#pragma once
+
+#include "Widgets/CommonActivatableWidgetContainer.h"
+#include "NekoActivatableWidgetStack.generated.h"
+
+
+/**
+ * Counters of the virtualization of a layer, useful to tune its MaxLiveDepth
+ */
+USTRUCT(BlueprintType)
+struct NEKOUTILS_API FNekoLayerVirtualizationReport
+{
+	GENERATED_BODY()
+
+	// Number of widgets on the layer
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Widget | Layer")
+	int32 NumWidgets = 0;
+
+	// Number of widgets on the layer whose Slate widgets are currently released
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Widget | Layer")
+	int32 NumVirtualizedWidgets = 0;
+
+	// Number of Slate widgets currently released by the virtualized widgets, a proxy for the memory saved
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Widget | Layer")
+	int32 NumReleasedSlateWidgets = 0;
+
+	// Number of times a widget had its Slate widgets released and freed
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Widget | Layer")
+	int32 NumReleases = 0;
+
+	// Number of times a widget had its Slate widgets rebuilt when getting back near the top of the layer
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Widget | Layer")
+	int32 NumRebuilds = 0;
+
+	// Number of times a widget popped from the layer was pushed again and had to rebuild its Slate widgets, because
+	// virtualizing another widget dropped the Slate widgets cached by the widget pool of the layer
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Widget | Layer")
+	int32 NumPoolRebuilds = 0;
+
+	// Average time spent rebuilding the Slate widgets of a widget
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Widget | Layer", meta = (Units = "Milliseconds"))
+	float AverageRebuildTime = 0.0f;
+
+	// Longest time spent rebuilding the Slate widgets of a widget
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Widget | Layer", meta = (Units = "Milliseconds"))
+	float MaxRebuildTime = 0.0f;
+};
+
+/**
+ * A stack of activatable widgets that can release the Slate widgets of the widgets buried deep below its top, and
+ * rebuild them once they get back near the top. Useful for deeply nested menus on memory constrained platforms.
+ *
+ * Virtualized widgets lose the state that only lives in Slate (e.g. scroll offsets), and are constructed again when
+ * rebuilt. A widget is only virtualized if its Slate widgets actually get freed, i.e. if nothing but the stack and its
+ * widget pool held them. The widget pool can only drop the Slate widgets it caches all at once, so each virtualization
+ * also makes the popped widgets waiting in the pool rebuild their Slate widgets when pushed again. Remove them through
+ * UNekoRootUILayout::FindAndRemoveWidgetFromLayer or call RestoreWidget first, since the stack can only release widgets
+ * whose Slate widget exists.
+ */
+UCLASS()
+class NEKOUTILS_API UNekoActivatableWidgetStack : public UCommonActivatableWidgetStack
+{
+	GENERATED_BODY()
+
+public:
+	UNekoActivatableWidgetStack(const FObjectInitializer& ObjectInitializer);
+
+	//~UVisual interface
+	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
+	//~End of UVisual interface
+
+	// Rebuilds the Slate widget of the provided widget if it was released
+	void RestoreWidget(UCommonActivatableWidget& Widget);
+
+	// Whether the Slate widget of the provided widget is currently released
+	bool IsWidgetVirtualized(const UCommonActivatableWidget* Widget) const;
+
+	UFUNCTION(BlueprintPure, BlueprintCosmetic, Category = "Widget | Layer")
+	FNekoLayerVirtualizationReport GetVirtualizationReport() const;
+
+protected:
+	//~UCommonActivatableWidgetContainerBase interface
+	virtual void OnWidgetAddedToList(UCommonActivatableWidget& AddedWidget) override;
+	//~End of UCommonActivatableWidgetContainerBase interface
+
+	/** Whether to release the Slate widgets of the widgets buried more than MaxLiveDepth below the top of the stack. */
+	UPROPERTY(EditAnywhere, Category = "Virtualization")
+	bool bVirtualizeBuriedWidgets = false;
+
+	/** Number of widgets below the top of the stack that keep their Slate widgets. */
+	UPROPERTY(EditAnywhere, Category = "Virtualization", meta = (ClampMin = "1", EditCondition = "bVirtualizeBuriedWidgets"))
+	int32 MaxLiveDepth = 2;
+
+private:
+	void HandleDisplayedWidgetChanged(UCommonActivatableWidget* DisplayedWidget);
+
+	// Releases or rebuilds the Slate widgets of every widget depending on its depth in the stack
+	void UpdateVirtualization();
+
+	void VirtualizeWidgetAt(const int32 Index);
+	void RestoreWidgetAt(const int32 Index);
+
+	// Remembers that the popped widgets of the widget pool lost their cached Slate widgets
+	void ForgetPoolSlateWidgets();
+
+private:
+	// The widgets whose Slate widgets are released, and the number of Slate widgets that were freed
+	TMap<TWeakObjectPtr<UCommonActivatableWidget>, int32> VirtualizedWidgets;
+
+	// The widgets created by the widget pool that may have a cached Slate widget
+	TSet<TWeakObjectPtr<UCommonActivatableWidget>> PoolWidgets;
+
+	// The popped widgets whose cached Slate widget was dropped by a virtualization
+	TSet<TWeakObjectPtr<UCommonActivatableWidget>> SlateDroppedPoolWidgets;
+
+	int32 NumReleases = 0;
+	int32 NumRebuilds = 0;
+	int32 NumPoolRebuilds = 0;
+	double TotalRebuildTime = 0.0;
+	double MaxRebuildTime = 0.0;
+};
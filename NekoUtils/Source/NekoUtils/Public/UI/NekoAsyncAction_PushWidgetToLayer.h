@@ -0,0 +1,75 @@
+// All Rights Reserved (c) Juniper Bouchard
+
+#pragma once
+
+#include "Engine/CancellableAsyncAction.h"
+#include "GameplayTagContainer.h"
+#include "NekoAsyncAction_PushWidgetToLayer.generated.h"
+
+class APlayerController;
+class UCommonActivatableWidget;
+class UNekoRootUILayout;
+struct FStreamableHandle;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FNekoPushWidgetToLayerAsyncDelegate, UCommonActivatableWidget*, UserWidget);
+
+
+/**
+ * Streams a widget class in without blocking, then pushes it onto a layer of the player's root layout.
+ *
+ * @see UNekoRootUILayout::PushWidgetToLayerStackAsync
+ */
+UCLASS(BlueprintType)
+class NEKOUTILS_API UNekoAsyncAction_PushWidgetToLayer : public UCancellableAsyncAction
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Streams the widget class in without blocking, then pushes it onto the layer.
+	 *
+	 * @param bSuspendInputUntilComplete Whether to ignore the player's input until the widget is pushed or canceled
+	 * @param bShowPlaceholder Whether to show the placeholder widget of the root layout on the layer while loading
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "Widget | Layer", meta = (BlueprintInternalUseOnly = "true", DisplayName = "Push Widget To Layer For Player (Async)"))
+	static UNekoAsyncAction_PushWidgetToLayer* PushWidgetToLayerForPlayerAsync(APlayerController* OwningPlayer,
+		UPARAM(meta = (AllowAbstract = false)) TSoftClassPtr<UCommonActivatableWidget> WidgetClass,
+		UPARAM(meta = (Categories = "UI.Layer")) FGameplayTag LayerName, bool bSuspendInputUntilComplete = true,
+		bool bShowPlaceholder = false);
+
+	//~UBlueprintAsyncActionBase interface
+	virtual void Activate() override;
+	//~End of UBlueprintAsyncActionBase interface
+
+	//~UCancellableAsyncAction interface
+	virtual void Cancel() override;
+	//~End of UCancellableAsyncAction interface
+
+public:
+	// Called with the widget before it is pushed, to initialize it
+	UPROPERTY(BlueprintAssignable)
+	FNekoPushWidgetToLayerAsyncDelegate BeforePush;
+
+	UPROPERTY(BlueprintAssignable)
+	FNekoPushWidgetToLayerAsyncDelegate AfterPush;
+
+	// Called if the widget class failed to load, or the push was canceled before it finished loading
+	UPROPERTY(BlueprintAssignable)
+	FNekoPushWidgetToLayerAsyncDelegate Canceled;
+
+private:
+	TWeakObjectPtr<APlayerController> OwningPlayer;
+
+	TSoftClassPtr<UCommonActivatableWidget> WidgetClass;
+
+	FGameplayTag LayerName;
+
+	bool bSuspendInputUntilComplete = true;
+
+	bool bShowPlaceholder = false;
+
+	// The layout the widget is pushed onto, which cancels the push
+	TWeakObjectPtr<UNekoRootUILayout> PushingLayout;
+
+	TSharedPtr<FStreamableHandle> StreamingHandle;
+};
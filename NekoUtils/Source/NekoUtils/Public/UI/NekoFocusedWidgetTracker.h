@@ -0,0 +1,50 @@
+// All Rights Reserved (c) Juniper Bouchard
+
+#pragma once
+
+#include "Subsystems/LocalPlayerSubsystem.h"
+#include "NekoFocusedWidgetTracker.generated.h"
+
+class SWidget;
+class UWidget;
+struct FFocusEvent;
+class FWeakWidgetPath;
+class FWidgetPath;
+
+
+/**
+ * Keeps track of the UMG widget focused by its local player.
+ *
+ * Listens to Slate's focus changes, and maps the newly focused Slate widget back to the UWidget that created it, so
+ * that getting the focused widget is only a pointer read instead of a search through every widget.
+ *
+ * In development builds, Neko.UI.ValidateFocusedWidget can be enabled to compare it against a search through every
+ * widget, which logs a warning when they don't match.
+ */
+UCLASS()
+class NEKOUTILS_API UNekoFocusedWidgetTracker : public ULocalPlayerSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	// Gets the widget currently focused by the local player, or null if the focused widget isn't a UMG widget
+	UWidget* GetFocusedWidget() const;
+
+private:
+	void HandleFocusChanging(const FFocusEvent& FocusEvent, const FWeakWidgetPath& OldFocusedWidgetPath,
+	                         const TSharedPtr<SWidget>& OldFocusedWidget, const FWidgetPath& NewFocusedWidgetPath,
+	                         const TSharedPtr<SWidget>& NewFocusedWidget);
+
+	// Finds the UWidget that created the deepest widget of the provided path
+	static UWidget* FindWidgetForPath(const FWidgetPath& WidgetPath);
+
+private:
+	TWeakObjectPtr<UWidget> FocusedWidget;
+
+	FDelegateHandle FocusChangingHandle;
+};
@@ -0,0 +1,54 @@
+// All Rights Reserved (c) Juniper Bouchard
+
+#pragma once
+
+#include "CommonInputTypeEnum.h"
+#include "Subsystems/LocalPlayerSubsystem.h"
+#include "NekoInputStateSubsystem.generated.h"
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnNekoInputTypeChangedNative, ECommonInputType);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnNekoInputTypeChanged, ECommonInputType, InputType);
+
+
+/**
+ * Caches the input type of its local player, so that widgets can read it without going through UCommonInputSubsystem,
+ * and get notified only when it changes instead of polling it.
+ *
+ * @see UNekoInputTypeVisibilityExtension to switch the visibility of widgets on the input type
+ */
+UCLASS()
+class NEKOUTILS_API UNekoInputStateSubsystem : public ULocalPlayerSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UNekoInputStateSubsystem* Get(const ULocalPlayer* LocalPlayer);
+
+	//~USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	// The current input type of the local player, Count if it doesn't use CommonInput
+	UFUNCTION(BlueprintPure, BlueprintCosmetic, Category = "Input")
+	ECommonInputType GetCurrentInputType() const { return CurrentInputType; }
+
+	UFUNCTION(BlueprintPure, BlueprintCosmetic, Category = "Input")
+	bool IsUsingGamepad() const { return CurrentInputType == ECommonInputType::Gamepad; }
+
+	UFUNCTION(BlueprintPure, BlueprintCosmetic, Category = "Input")
+	bool IsUsingTouch() const { return CurrentInputType == ECommonInputType::Touch; }
+
+	// Broadcast only when the input type of the local player changes
+	FOnNekoInputTypeChangedNative OnInputTypeChangedNative;
+
+	// Broadcast only when the input type of the local player changes
+	UPROPERTY(BlueprintAssignable, Category = "Input")
+	FOnNekoInputTypeChanged OnInputTypeChanged;
+
+private:
+	void HandleInputMethodChanged(ECommonInputType NewInputType);
+
+private:
+	ECommonInputType CurrentInputType = ECommonInputType::Count;
+};
@@ -0,0 +1,67 @@
+// All Rights Reserved (c) Juniper Bouchard
+
+#pragma once
+
+#include "CommonInputTypeEnum.h"
+#include "Components/SlateWrapperTypes.h"
+#include "Extensions/UserWidgetExtension.h"
+#include "NekoInputTypeVisibilityExtension.generated.h"
+
+class UNekoInputStateSubsystem;
+class UWidget;
+
+
+/**
+ * Switches the visibility of widgets of a user widget when the input type of its owning player changes, e.g. to show
+ * gamepad glyphs only while using a gamepad.
+ *
+ * The visibilities are only written when UNekoInputStateSubsystem notifies a change, so the widgets don't have to
+ * poll the input type with a binding every frame.
+ *
+ * @see UNekoFunctionLibrary::BindVisibilityToInputType
+ */
+UCLASS()
+class NEKOUTILS_API UNekoInputTypeVisibilityExtension : public UUserWidgetExtension
+{
+	GENERATED_BODY()
+
+public:
+	//~UUserWidgetExtension interface
+	virtual void Construct() override;
+	virtual void Destruct() override;
+	//~End of UUserWidgetExtension interface
+
+	/**
+	 * Makes the provided widget visible only while the input type is one of the provided ones, replacing its previous
+	 * binding if any. The visibility is applied immediately.
+	 *
+	 * @param InputTypes Bitmask of the input types, 1 << ECommonInputType
+	 */
+	void AddBinding(UWidget* Widget, const int32 InputTypes, const ESlateVisibility VisibleVisibility, const ESlateVisibility HiddenVisibility);
+
+	// Stops switching the visibility of the provided widget
+	void RemoveBinding(const UWidget* Widget);
+
+private:
+	struct FBinding
+	{
+		TWeakObjectPtr<UWidget> Widget;
+		int32 InputTypes = 0;
+		ESlateVisibility VisibleVisibility = ESlateVisibility::SelfHitTestInvisible;
+		ESlateVisibility HiddenVisibility = ESlateVisibility::Collapsed;
+	};
+
+	// Starts listening to the input state of the owning player, if not done yet
+	void BindInputState();
+
+	void HandleInputTypeChanged(ECommonInputType NewInputType);
+
+	static void ApplyBinding(const FBinding& Binding, const ECommonInputType InputType);
+
+private:
+	TArray<FBinding> Bindings;
+
+	TWeakObjectPtr<UNekoInputStateSubsystem> InputState;
+
+	FDelegateHandle InputTypeChangedHandle;
+};
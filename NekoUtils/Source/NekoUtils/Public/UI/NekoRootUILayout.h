@@ -5,9 +5,13 @@
 #include "CommonUserWidget.h"
 #include "NativeGameplayTags.h"
 #include "CommonActivatableWidget.h"
+#include "Containers/Ticker.h"
+#include "NekoActivatableWidgetStack.h"
 #include "Widgets/CommonActivatableWidgetContainer.h"
 #include "NekoRootUILayout.generated.h"
 
+struct FStreamableHandle;
+
 
 namespace NekoUILayers
 {
@@ -17,10 +21,65 @@ namespace NekoUILayers
 	NEKOUTILS_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(UI_Layer_Modal);
 }
 
+UENUM(BlueprintType)
+enum class ENekoAsyncWidgetLayerState : uint8
+{
+	// The widget was created, and is about to be pushed
+	Initialize,
+	// The widget was pushed onto its layer
+	AfterPush,
+	// The widget class failed to load, or the push was canceled before it finished loading
+	Canceled
+};
+
+/**
+ * Counters of the widget pool of a widget class
+ */
+USTRUCT(BlueprintType)
+struct NEKOUTILS_API FNekoWidgetPoolStats
+{
+	GENERATED_BODY()
+
+	// Number of deactivated widgets currently waiting in the pool
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Widget | Pool")
+	int32 Pooled = 0;
+
+	// Maximum number of widgets kept in the pool
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Widget | Pool")
+	int32 Capacity = 0;
+
+	// Number of pushes that reused a pooled widget
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Widget | Pool")
+	int32 Hits = 0;
+
+	// Number of pushes that had to create a widget because the pool was empty
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Widget | Pool")
+	int32 Misses = 0;
+};
+
+// Deactivated widgets of one class, kept by UNekoRootUILayout for reuse
+USTRUCT()
+struct FNekoWidgetPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UCommonActivatableWidget>> Widgets;
+
+	// The Slate widget of each pooled widget, kept alive so that it isn't rebuilt when pushed again
+	TArray<TSharedPtr<SWidget>> SlateWidgets;
+
+	int32 Hits = 0;
+
+	int32 Misses = 0;
+};
+
 /**
  * The primary game UI layout of a game.
  *
- * @todo Add async versions of push to layer
+ * Widget classes deriving from UNekoActivatableWidget with a PoolCapacity are pooled: once popped from their layer, up
+ * to PoolCapacity of their instances are reset and kept, and pushing the class again reuses one of them instead of
+ * creating a new widget.
  */
 UCLASS(Abstract, meta = (DisableNativeTick))
 class NEKOUTILS_API UNekoRootUILayout : public UCommonUserWidget
@@ -45,7 +104,21 @@ public:
 
 		if (UCommonActivatableWidgetContainerBase* Layer = GetLayerWidget(LayerName))
 		{
-			return Layer->AddWidget<ActivatableWidgetT>(ActivatableWidgetClass, InstanceInitFunc);
+			const double PushStartTime = FPlatformTime::Seconds();
+
+			// Pooled widgets are added as instances, so that the layer's own pool never hands them out
+			if (UCommonActivatableWidget* PooledWidget = AcquirePooledWidget(ActivatableWidgetClass))
+			{
+				ActivatableWidgetT& Widget = *CastChecked<ActivatableWidgetT>(PooledWidget);
+				InstanceInitFunc(Widget);
+				Layer->AddWidgetInstance(Widget);
+				TrackWidgetLayer(&Widget, Layer, PushStartTime);
+				return &Widget;
+			}
+
+			ActivatableWidgetT* Widget = Layer->AddWidget<ActivatableWidgetT>(ActivatableWidgetClass, InstanceInitFunc);
+			TrackWidgetLayer(Widget, Layer, PushStartTime);
+			return Widget;
 		}
 
 		return nullptr;
@@ -54,6 +127,33 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category="Widget | Layer")
 	UCommonActivatableWidget* PushWidgetToLayerStack(UPARAM(meta=(Categories="UI.Layer")) FGameplayTag LayerName, TSoftClassPtr<UCommonActivatableWidget> WidgetClass);
 
+	/**
+	 * Streams the widget class in without blocking, then pushes it onto the layer.
+	 *
+	 * The push is canceled when CancelPendingPushes is called for its layer, when the layout is destroyed, or when the
+	 * player of the layout changes.
+	 *
+	 * @param bSuspendInputUntilComplete Whether to ignore the player's input until the widget is pushed or canceled
+	 * @param bShowPlaceholder Whether to show PlaceholderWidgetClass on the layer until the widget is pushed or canceled
+	 * @param StateFunc Called with the widget before and after it is pushed, or with null if the push is canceled
+	 * @return The handle of the load, which can be passed to CancelPendingPush until StateFunc is called. Null if the
+	 *         load couldn't be requested, in which case StateFunc was already called
+	 */
+	TSharedPtr<FStreamableHandle> PushWidgetToLayerStackAsync(FGameplayTag LayerName, TSoftClassPtr<UCommonActivatableWidget> WidgetClass,
+	                                                          const bool bSuspendInputUntilComplete, const bool bShowPlaceholder,
+	                                                          TFunction<void(ENekoAsyncWidgetLayerState, UCommonActivatableWidget*)> StateFunc);
+
+	/**
+	 * Cancels the asynchronous pushes that are still loading their widget class.
+	 *
+	 * @param LayerName The layer whose pushes are canceled, every layer if not set
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category="Widget | Layer")
+	void CancelPendingPushes(UPARAM(meta=(Categories="UI.Layer")) FGameplayTag LayerName);
+
+	// Cancels the asynchronous push that returned the provided handle, if it hasn't pushed its widget yet
+	void CancelPendingPush(const TSharedPtr<FStreamableHandle>& Handle);
+
 	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category="Widget | Layer")
 	void PushWidgetInstanceToLayerStack(UPARAM(meta=(Categories="UI.Layer")) FGameplayTag LayerName, UCommonActivatableWidget* Widget);
 	
@@ -63,7 +163,121 @@ public:
 	// Get the layer widget for the given layer tag.
 	UCommonActivatableWidgetContainerBase* GetLayerWidget(FGameplayTag LayerName) const;
 
+	/**
+	 * Gets the virtualization counters of the provided layer, empty if the layer isn't a UNekoActivatableWidgetStack
+	 */
+	UFUNCTION(BlueprintPure, BlueprintCosmetic, Category="Widget | Layer")
+	FNekoLayerVirtualizationReport GetLayerVirtualizationReport(UPARAM(meta=(Categories="UI.Layer")) FGameplayTag LayerName) const;
+
+	/**
+	 * Creates widgets of a pooled class up front, e.g. during a loading screen, so that pushing them later is cheap.
+	 * Does nothing for classes that aren't pooled.
+	 *
+	 * @param Count Number of widgets that should be waiting in the pool, limited by the class' pool capacity
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category="Widget | Pool")
+	void PrewarmWidgetPool(TSubclassOf<UCommonActivatableWidget> WidgetClass, int32 Count);
+
+	// Releases every pooled widget to the garbage collector. The pool counters keep running, see ResetWidgetPoolStats
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category="Widget | Pool")
+	void EmptyWidgetPools();
+
+	// Resets the hit and miss counters of every pool, e.g. to measure the hit rate of a single level
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category="Widget | Pool")
+	void ResetWidgetPoolStats();
+
+	// Gets the counters of the pool of the provided widget class, useful to tune its pool capacity
+	UFUNCTION(BlueprintPure, BlueprintCosmetic, Category="Widget | Pool")
+	FNekoWidgetPoolStats GetWidgetPoolStats(TSubclassOf<UCommonActivatableWidget> WidgetClass) const;
+
+	//~UObject interface
+	virtual void BeginDestroy() override;
+	//~End of UObject interface
+
+protected:
+	//~UUserWidget interface
+	virtual void NativeDestruct() override;
+	//~End of UUserWidget interface
+
+	/** The widget shown on a layer while an asynchronous push loads its widget class, when requested. */
+	UPROPERTY(EditAnywhere, Category = "Layer")
+	TSubclassOf<UCommonActivatableWidget> PlaceholderWidgetClass;
+
+private:
+	// An asynchronous push that hasn't pushed its widget yet
+	struct FPendingPush
+	{
+		int32 Id = 0;
+		FGameplayTag LayerName;
+		TSharedPtr<FStreamableHandle> Handle;
+		FName SuspendInputToken;
+		TWeakObjectPtr<UCommonActivatableWidget> Placeholder;
+		TFunction<void(ENekoAsyncWidgetLayerState, UCommonActivatableWidget*)> StateFunc;
+	};
+
+	// Removes the widget from the provided layer, rebuilding it first if the layer virtualized it
+	static void RemoveWidgetFromLayer(UCommonActivatableWidgetContainerBase& Layer, UCommonActivatableWidget& Widget);
+
+	// Index in NativeLayers of the provided layer, INDEX_NONE if it isn't one of the NekoUILayers tags
+	static int32 GetNativeLayerIndex(const FGameplayTag& LayerName);
+
+	// Remembers the layer that the widget was pushed onto, so that it can be removed without searching every layer, and
+	// records the push in the UI telemetry if requested
+	void TrackWidgetLayer(UCommonActivatableWidget* Widget, UCommonActivatableWidgetContainerBase* Layer, const double PushStartTime,
+	                      const bool bRecordPush = true);
+
+	// Pushes PlaceholderWidgetClass onto the layer, without recording it in the UI telemetry
+	UCommonActivatableWidget* PushPlaceholderToLayerStack(FGameplayTag LayerName);
+
+	// Maximum number of widgets of the provided class kept in its pool, 0 if it isn't pooled
+	static int32 GetPoolCapacity(const UClass* WidgetClass);
+
+	// Takes a widget out of the pool of the provided class, or creates one if the pool is empty. Returns null if the
+	// class isn't pooled
+	UCommonActivatableWidget* AcquirePooledWidget(UClass* WidgetClass);
+
+	// Creates a widget that returns to its pool once popped
+	UCommonActivatableWidget* CreatePooledWidget(UClass* WidgetClass);
+
+	void HandlePooledWidgetDeactivated(TWeakObjectPtr<UCommonActivatableWidget> Widget);
+
+	// Returns the deactivated widgets that were removed from their layer to their pool
+	void ReturnPendingWidgetsToPool();
+
+	// Ignores the input of the owning player until ResumeInput is called with the returned token
+	FName SuspendInput() const;
+	void ResumeInput(const FName SuspendInputToken) const;
+
+	// Forgets the pending push, resumes the input and removes the placeholder it suspended or showed. Returns false if
+	// the push already finished or was canceled
+	bool FinishPendingPush(const int32 PushId, FPendingPush& OutPendingPush);
+
+	// Finishes the pending push, cancels its load and tells its state function
+	void CancelPendingPush(const int32 PushId);
+
 private:
 	UPROPERTY(Transient, meta = (Categories = "UI.Layer"))
 	TMap<FGameplayTag, TObjectPtr<UCommonActivatableWidgetContainerBase>> Layers;
+
+	// The layers registered with one of the NekoUILayers tags, resolved without hashing the tag
+	UPROPERTY(Transient)
+	TObjectPtr<UCommonActivatableWidgetContainerBase> NativeLayers[4];
+
+	// The layer each pushed widget was pushed onto
+	TMap<TWeakObjectPtr<UCommonActivatableWidget>, TWeakObjectPtr<UCommonActivatableWidgetContainerBase>> WidgetLayers;
+
+	// Number of tracked widgets above which the widgets that were garbage collected are forgotten
+	int32 WidgetLayersPruneThreshold = 64;
+
+	TArray<FPendingPush> PendingPushes;
+
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UClass>, FNekoWidgetPool> WidgetPools;
+
+	// Pooled widgets deactivated this frame, returned to their pool on the next frame if they were removed from their layer
+	TArray<TWeakObjectPtr<UCommonActivatableWidget>> PendingPoolReturns;
+
+	FTSTicker::FDelegateHandle PoolReturnTickerHandle;
+
+	int32 NextPushId = 0;
 };
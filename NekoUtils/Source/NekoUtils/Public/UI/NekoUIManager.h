@@ -5,15 +5,29 @@
 #include "Subsystems/LocalPlayerSubsystem.h"
 #include "NekoUIManager.generated.h"
 
+class UCommonActivatableWidget;
 class UNekoRootUILayout;
+struct FStreamableHandle;
 
 
+/**
+ * Creates and owns the root layout of its local player.
+ *
+ * The layout class starts streaming in as soon as the local player is created, so that the layout can be created without
+ * blocking once the player controller is available. The widget classes listed in PreloadedWidgetClasses are streamed in
+ * at the same time, with a lower priority and on their own, so that they never delay the layout.
+ */
 UCLASS(Config = Game)
 class NEKOUTILS_API UNekoUIManager : public ULocalPlayerSubsystem
 {
 	GENERATED_BODY()
 
 public:
+	//~USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
 	//~ULocalPlayerSubsystem interface
 	virtual void PlayerControllerChanged(APlayerController* NewPlayerController) override;
 	//~End of ULocalPlayerSubsystem interface
@@ -22,11 +36,41 @@ public:
 
 protected:
 	void CreateLayoutWidget();
-	
+
+	// Starts streaming the layout class in, if not done yet
+	void RequestLayoutClassLoad();
+
+	// Starts streaming the preloaded widget classes in, if not done yet
+	void RequestPreloadedClassesLoad();
+
+	void HandleLayoutClassLoaded();
+	void HandlePreloadedClassesLoaded();
+
 protected:
 	UPROPERTY(Transient)
 	TObjectPtr<UNekoRootUILayout> CurrentRootUILayout = nullptr;
 
 	UPROPERTY(Config)
 	TSoftClassPtr<UNekoRootUILayout> DefaultRootUILayoutClass;
+
+	// Widget classes streamed in after the layout class and kept loaded, e.g. the pause menu
+	UPROPERTY(Config)
+	TArray<TSoftClassPtr<UCommonActivatableWidget>> PreloadedWidgetClasses;
+
+private:
+	// Keeps the layout class loaded, reset if it failed to load so that it can be requested again
+	TSharedPtr<FStreamableHandle> LayoutClassHandle;
+
+	// Keeps the preloaded widget classes loaded
+	TSharedPtr<FStreamableHandle> PreloadedClassesHandle;
+
+	// Time at which the local player was created, to measure how long the first layout took to show up
+	double InitializeTime = 0.0;
+
+	// Times at which the layout class and the preloaded widget classes started streaming in
+	double LayoutLoadStartTime = 0.0;
+	double PreloadStartTime = 0.0;
+
+	// Whether the layout should be created as soon as its class is loaded
+	bool bCreateLayoutWhenLoaded = false;
 };
@@ -0,0 +1,160 @@
+// All Rights Reserved (c) Juniper Bouchard
+
+#pragma once
+
+#include "Containers/Ticker.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "NekoUITelemetrySubsystem.generated.h"
+
+class UCommonActivatableWidget;
+struct FStreamableHandle;
+
+
+/**
+ * What was recorded about the pushes of one widget class
+ */
+USTRUCT(BlueprintType)
+struct NEKOUTILS_API FNekoUIClassTelemetry
+{
+	GENERATED_BODY()
+
+	// Path of the widget class
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Widget | Telemetry")
+	FString ClassPath;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Widget | Telemetry")
+	int32 PushCount = 0;
+
+	// Total time spent creating and adding the widgets to their layer, in seconds
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Widget | Telemetry")
+	double TotalConstructTime = 0.0;
+
+	// Total time between the pushes and the activation of the widgets, in seconds
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Widget | Telemetry")
+	double TotalActivateTime = 0.0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Widget | Telemetry")
+	int32 ActivationCount = 0;
+
+	// Number of times each widget class was the next one pushed after this one, by class path
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Widget | Telemetry")
+	TMap<FString, int32> NextClasses;
+};
+
+/**
+ * The UI telemetry saved between sessions
+ */
+USTRUCT(BlueprintType)
+struct NEKOUTILS_API FNekoUITelemetryProfile
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Widget | Telemetry")
+	TArray<FNekoUIClassTelemetry> Classes;
+};
+
+/**
+ * Records which widget classes get pushed onto the layers of UNekoRootUILayout, how long they take to construct and
+ * activate, and which class usually follows which, into a small JSON profile in the saved directory.
+ *
+ * On the next launch, the most pushed classes are streamed in during idle frames, and after each push the classes that
+ * usually follow it are too, so that opening them doesn't have to wait for a load.
+ *
+ * Disabled by default, set bEnableTelemetry in the [/Script/NekoUtils.NekoUITelemetrySubsystem] section of the game
+ * config to opt in.
+ */
+UCLASS(Config = Game)
+class NEKOUTILS_API UNekoUITelemetrySubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UNekoUITelemetrySubsystem* Get(const UObject* WorldContextObject);
+
+	//~USubsystem interface
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~End of USubsystem interface
+
+	/**
+	 * Records that the provided widget was pushed onto a layer, and starts preloading the classes that usually follow it
+	 *
+	 * @param PushStartTime FPlatformTime::Seconds() from before the widget was created
+	 */
+	void RecordPush(UCommonActivatableWidget* Widget, const double PushStartTime);
+
+	UFUNCTION(BlueprintPure, BlueprintCosmetic, Category = "Widget | Telemetry")
+	FNekoUITelemetryProfile GetProfile() const { return Profile; }
+
+	// Writes the profile to disk, it is also written when the game instance shuts down
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "Widget | Telemetry")
+	void SaveProfile() const;
+
+	// Forgets everything that was recorded
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "Widget | Telemetry")
+	void ResetProfile();
+
+private:
+	FString GetProfilePath() const;
+
+	void LoadProfile();
+
+	FNekoUIClassTelemetry& FindOrAddClassTelemetry(const FString& ClassPath);
+
+	void HandleWidgetActivated(TWeakObjectPtr<UCommonActivatableWidget> Widget);
+
+	// Forgets the destroyed widgets, including the ones that were never activated
+	void RemoveDestroyedWidgets();
+
+	// Queues the provided class for preloading, ahead of the others if bUrgent
+	void QueuePreload(const FString& ClassPath, const bool bUrgent);
+
+	// Starts the next queued preload when the frame was idle
+	bool TickPreloads(float DeltaTime);
+
+private:
+	// Whether to record telemetry and preload widget classes, off unless the project opts in since it writes to the saved
+	// directory and keeps the preloaded classes in memory
+	UPROPERTY(Config)
+	bool bEnableTelemetry = false;
+
+	// Name of the profile file, in the NekoUtils folder of the saved directory
+	UPROPERTY(Config)
+	FString ProfileFileName = TEXT("UITelemetry.json");
+
+	// Number of the most pushed classes preloaded on launch
+	UPROPERTY(Config)
+	int32 MaxPreloadedClasses = 10;
+
+	// Number of the classes that usually follow a pushed class preloaded after it is pushed
+	UPROPERTY(Config)
+	int32 MaxPredictedClasses = 3;
+
+	// Frames longer than this are not idle, and don't start any preload
+	UPROPERTY(Config)
+	float MaxIdleDeltaTime = 1.0f / 30.0f;
+
+	FNekoUITelemetryProfile Profile;
+
+	// Index in Profile.Classes of each class path
+	TMap<FString, int32> ClassIndices;
+
+	FString LastPushedClassPath;
+
+	// Push time of the widgets that weren't activated yet
+	TMap<TWeakObjectPtr<UCommonActivatableWidget>, double> PendingActivations;
+
+	// Widgets whose activation is already listened to
+	TSet<TWeakObjectPtr<UCommonActivatableWidget>> BoundWidgets;
+
+	TArray<FSoftObjectPath> PreloadQueue;
+
+	// Classes that were preloaded or queued for it, never queued again
+	TSet<FSoftObjectPath> RequestedPreloads;
+
+	// Keeps the preloaded classes loaded
+	TArray<TSharedPtr<FStreamableHandle>> PreloadHandles;
+
+	FTSTicker::FDelegateHandle PreloadTickerHandle;
+};